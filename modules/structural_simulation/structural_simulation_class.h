@@ -88,7 +88,7 @@ class SolidBodyForSimulation
 {
   private:
     SolidBodyFromMesh solid_body_from_mesh_;
-    InnerRelation inner_body_relation_;
+    ReferenceInnerRelation inner_body_relation_;
 
     SimpleDynamics<NormalDirectionFromBodyShape> initial_normal_direction_;
     InteractionWithUpdate<KernelCorrectionMatrixInner> correct_configuration_;
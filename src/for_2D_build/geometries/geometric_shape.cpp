@@ -21,6 +21,16 @@ bool GeometricShapeBox::checkContain(const Vec2d &probe_point, bool BOUNDARY_INC
     return ABS(probe_point[0]) < halfsize_[0] && ABS(probe_point[1]) < halfsize_[1];
 }
 //=================================================================================================//
+void GeometricShapeBox::checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                          bool BOUNDARY_INCLUDED)
+{
+    is_contained.resize(probe_points.size());
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        is_contained[i] = (probe_points[i].cwiseAbs().array() < halfsize_.array()).all();
+    }
+}
+//=================================================================================================//
 Vec2d GeometricShapeBox::findClosestPoint(const Vec2d &probe_point)
 {
     return multi_polygon_.findClosestPoint(probe_point);
@@ -40,6 +50,17 @@ bool GeometricShapeBall::checkContain(const Vec2d &probe_point, bool BOUNDARY_IN
     return (probe_point - center_).norm() < radius_;
 }
 //=================================================================================================//
+void GeometricShapeBall::checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                           bool BOUNDARY_INCLUDED)
+{
+    Real radius_square = radius_ * radius_;
+    is_contained.resize(probe_points.size());
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        is_contained[i] = (probe_points[i] - center_).squaredNorm() < radius_square;
+    }
+}
+//=================================================================================================//
 Vec2d GeometricShapeBall::findClosestPoint(const Vec2d &probe_point)
 {
     Vec2d displacement = probe_point - center_;
@@ -42,6 +42,8 @@ class GeometricShapeBox : public Shape
     virtual ~GeometricShapeBox(){};
 
     virtual bool checkContain(const Vec2d &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true) override;
     virtual Vec2d findClosestPoint(const Vec2d &probe_point) override;
 
   protected:
@@ -62,6 +64,8 @@ class GeometricShapeBall : public Shape
     virtual ~GeometricShapeBall(){};
 
     virtual bool checkContain(const Vec2d &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true) override;
     virtual Vec2d findClosestPoint(const Vec2d &probe_point) override;
 
   protected:
@@ -48,6 +48,7 @@ void LevelSet::finishDataPackages()
                       {
                           tagACellIsInnerPackage(Arrayi(i, j));
                       });
+    sortInnerDataPackages();
 
     mesh_parallel_for(MeshRange(Arrayi::Zero(), all_cells_),
                       [&](size_t i, size_t j)
@@ -82,25 +83,25 @@ void LevelSet::diffuseLevelSetSign()
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             data_pkg->for_each_addrs(
                 [&](int i, int j)
                 {
                     // near interface cells are not considered
-                    if (abs(*near_interface_id_addrs[i][j]) > 1)
+                    if (abs(near_interface_id_addrs(i, j)) > 1)
                     {
                         mesh_find_if2d<-1, 2>(
                             [&](int l, int m) -> bool
                             {
-                                int near_interface_id = *near_interface_id_addrs[i + l][j + m];
+                                int near_interface_id = near_interface_id_addrs(i + l, j + m);
                                 bool is_found = abs(near_interface_id) == 1;
                                 if (is_found)
                                 {
-                                    Real phi_0 = *phi_addrs[i][j];
-                                    *near_interface_id_addrs[i][j] = near_interface_id;
-                                    *phi_addrs[i][j] = near_interface_id == 1 ? fabs(phi_0) : -fabs(phi_0);
+                                    Real phi_0 = phi_addrs(i, j);
+                                    near_interface_id_addrs(i, j) = near_interface_id;
+                                    phi_addrs(i, j) = near_interface_id == 1 ? fabs(phi_0) : -fabs(phi_0);
                                 }
                                 return is_found;
                             });
@@ -115,20 +116,20 @@ void LevelSet::reinitializeLevelSet()
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             data_pkg->for_each_addrs(
                 [&](int i, int j)
                 {
                     // only reinitialize non cut cells
-                    if (*near_interface_id_addrs[i][j] != 0)
+                    if (near_interface_id_addrs(i, j) != 0)
                     {
-                        Real phi_0 = *phi_addrs[i][j];
+                        Real phi_0 = phi_addrs(i, j);
                         Real sign = phi_0 / sqrt(phi_0 * phi_0 + data_spacing_ * data_spacing_);
-                        Real dv_x = upwindDifference(sign, *phi_addrs[i + 1][j] - phi_0, phi_0 - *phi_addrs[i - 1][j]);
-                        Real dv_y = upwindDifference(sign, *phi_addrs[i][j + 1] - phi_0, phi_0 - *phi_addrs[i][j - 1]);
-                        *phi_addrs[i][j] -= 0.5 * sign * (Vec2d(dv_x, dv_y).norm() - data_spacing_);
+                        Real dv_x = upwindDifference(sign, phi_addrs(i + 1, j) - phi_0, phi_0 - phi_addrs(i - 1, j));
+                        Real dv_y = upwindDifference(sign, phi_addrs(i, j + 1) - phi_0, phi_0 - phi_addrs(i, j - 1));
+                        phi_addrs(i, j) -= 0.5 * sign * (Vec2d(dv_x, dv_y).norm() - data_spacing_);
                     }
                 });
         });
@@ -142,8 +143,8 @@ void LevelSet::markNearInterface(Real small_shift_factor)
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             // corner averages, note that the first row and first column are not used
             LevelSetDataPackage::PackageTemporaryData<Real> corner_averages;
@@ -157,7 +158,7 @@ void LevelSet::markNearInterface(Real small_shift_factor)
                 [&](int i, int j)
                 {
                     // first assume far cells
-                    Real phi_0 = *phi_addrs[i][j];
+                    Real phi_0 = phi_addrs(i, j);
                     int near_interface_id = phi_0 > 0.0 ? 2 : -2;
                     if (fabs(phi_0) < small_shift)
                     {
@@ -183,7 +184,7 @@ void LevelSet::markNearInterface(Real small_shift_factor)
                             });
                     }
                     // assign this to package
-                    *near_interface_id_addrs[i][j] = near_interface_id;
+                    near_interface_id_addrs(i, j) = near_interface_id;
                 });
         });
 }
@@ -192,11 +193,20 @@ void LevelSet::initializeBasicDataForAPackage(LevelSetDataPackage *data_pkg, Sha
 {
     auto &phi = data_pkg->getPackageData(phi_);
     auto &near_interface_id = data_pkg->getPackageData(near_interface_id_);
+    StdVec<Vecd> positions;
     data_pkg->for_each_data(
         [&](int i, int j)
         {
-            Vec2d position = data_pkg->DataPositionFromIndex(Vec2d(i, j));
-            phi[i][j] = shape.findSignedDistance(position);
+            positions.push_back(data_pkg->DataPositionFromIndex(Vec2d(i, j)));
+        });
+    StdVec<Real> signed_distances;
+    shape.findSignedDistanceBatch(positions, signed_distances);
+
+    size_t n = 0;
+    data_pkg->for_each_data(
+        [&](int i, int j)
+        {
+            phi[i][j] = signed_distances[n++];
             near_interface_id[i][j] = phi[i][j] < 0.0 ? -2 : 2;
         });
 }
@@ -205,13 +215,13 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
 {
     int l = (int)core_data_pkg->CellIndexOnMesh()[0];
     int m = (int)core_data_pkg->CellIndexOnMesh()[1];
-    auto &phi_addrs = core_data_pkg->getPackageDataAddress(phi_);
-    auto &near_interface_id_addrs = core_data_pkg->getPackageDataAddress(near_interface_id_);
+    auto phi_addrs = core_data_pkg->getPackageDataAccessor(phi_);
+    auto near_interface_id_addrs = core_data_pkg->getPackageDataAccessor(near_interface_id_);
 
     core_data_pkg->for_each_addrs(
         [&](int i, int j)
         {
-            int near_interface_id = *near_interface_id_addrs[i][j];
+            int near_interface_id = near_interface_id_addrs(i, j);
             if (near_interface_id == 0)
             {
                 bool positive_band = false;
@@ -219,7 +229,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                 mesh_for_each2d<-1, 2>(
                     [&](int r, int s)
                     {
-                        int neighbor_near_interface_id = *near_interface_id_addrs[i + r][j + s];
+                        int neighbor_near_interface_id = near_interface_id_addrs(i + r, j + s);
                         if (neighbor_near_interface_id >= 1)
                             positive_band = true;
                         if (neighbor_near_interface_id <= -1)
@@ -245,11 +255,11 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                                 min_distance_p = SMIN(min_distance_p, (Vecd((Real)x, (Real)y) * data_spacing_ + phi_p_ * norm_to_face).norm());
                             }
                         });
-                    *phi_addrs[i][j] = -min_distance_p;
+                    phi_addrs(i, j) = -min_distance_p;
                     // this immediate switch of near interface id
                     // does not intervening with the identification of unresolved interface
                     // based on the assumption that positive false_and negative bands are not close to each other
-                    *near_interface_id_addrs[i][j] = -1;
+                    near_interface_id_addrs(i, j) = -1;
                 }
                 if (negative_band == false)
                 {
@@ -271,11 +281,11 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                                 min_distance_n = SMIN(min_distance_n, (Vecd((Real)x, (Real)y) * data_spacing_ - phi_n_ * norm_to_face).norm());
                             }
                         });
-                    *phi_addrs[i][j] = min_distance_n;
+                    phi_addrs(i, j) = min_distance_n;
                     // this immediate switch of near interface id
                     // does not intervening with the identification of unresolved interface
                     // based on the assumption that positive false_and negative bands are not close to each other
-                    *near_interface_id_addrs[i][j] = 1;
+                    near_interface_id_addrs(i, j) = 1;
                 }
             }
         });
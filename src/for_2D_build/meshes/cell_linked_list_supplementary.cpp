@@ -1,6 +1,7 @@
 #include "cell_linked_list.h"
 
 #include "base_particles.hpp"
+#include "cell_linked_list.hpp"
 #include "mesh_iterators.hpp"
 
 namespace SPH
@@ -69,6 +70,16 @@ void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
         });
 }
 //=================================================================================================//
+size_t CellLinkedList::ParticlesInCell(const Array2i &cell_index)
+{
+    if (sorted_cell_lists_built_)
+    {
+        size_t cell_key = transferMeshIndexTo1D(all_cells_, cell_index);
+        return cell_offsets_[cell_key + 1] - cell_offsets_[cell_key];
+    }
+    return cell_index_lists_[cell_index[0]][cell_index[1]].size();
+}
+//=================================================================================================//
 void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &particle_position)
 {
     Array2i cellpos = CellIndexFromPosition(particle_position);
@@ -85,6 +96,12 @@ void CellLinkedList ::InsertListDataEntry(
 //=================================================================================================//
 ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 {
+    if (sorted_cell_lists_built_)
+    {
+        return findNearestSortedListDataEntry(position, [&](size_t cell_key)
+                                              { return cell_offsets_[cell_key]; });
+    }
+
     Real min_distance_sqr = MaxReal;
     ListData nearest_entry(MaxSize_t, MaxReal * Vecd::Ones(), MaxReal);
 
@@ -111,6 +128,7 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 void CellLinkedList::
     tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 {
+    cell_index_lists_required_ = true;
     mesh_parallel_for(
         MeshRange(Array2i::Zero(), all_cells_),
         [&](int i, int j)
@@ -134,15 +152,17 @@ void CellLinkedList::
 void CellLinkedList::
     tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis)
 {
+    cell_index_lists_required_ = true;
     int second_axis = NextAxis(axis);
     Array2i body_lower_bound_cell_ = CellIndexFromPosition(bounding_bounds.first_);
     Array2i body_upper_bound_cell_ = CellIndexFromPosition(bounding_bounds.second_);
 
+    // two layers of cells inside the bounds to cover the periodic images with neighbor skin
     // lower bound cells
     for (int j = SMAX(body_lower_bound_cell_[second_axis] - 1, 0);
          j < SMIN(body_upper_bound_cell_[second_axis] + 2, all_cells_[second_axis]); ++j)
         for (int i = SMAX(body_lower_bound_cell_[axis] - 1, 0);
-             i < SMIN(body_lower_bound_cell_[axis] + 2, all_cells_[axis]); ++i)
+             i < SMIN(body_lower_bound_cell_[axis] + 3, all_cells_[axis]); ++i)
         {
             Array2i cell = Array2i::Zero();
             cell[axis] = i;
@@ -154,7 +174,7 @@ void CellLinkedList::
     // upper bound cells
     for (int j = SMAX(body_lower_bound_cell_[second_axis] - 1, 0);
          j < SMIN(body_upper_bound_cell_[second_axis] + 2, all_cells_[second_axis]); ++j)
-        for (int i = SMAX(body_upper_bound_cell_[axis] - 1, 0);
+        for (int i = SMAX(body_upper_bound_cell_[axis] - 2, 0);
              i < SMIN(body_upper_bound_cell_[axis] + 2, all_cells_[axis]); ++i)
         {
             Array2i cell = Array2i::Zero();
@@ -204,7 +224,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << cell_index_lists_[i][j].size() << " ";
+            output_file << ParticlesInCell(Array2i(i, j)) << " ";
         }
         output_file << " \n";
     }
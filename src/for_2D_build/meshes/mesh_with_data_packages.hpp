@@ -40,17 +40,17 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
 template <int PKG_SIZE, int ADDRS_BUFFER>
 template <class DataType>
 DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
-    probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position)
+    probeDataPackage(const PackageDataAccessor<DataType> &pkg_data_addrs, const Vecd &position)
 {
     Arrayi grid_idx = CellIndexFromPosition(position);
     Vecd grid_pos = GridPositionFromIndex(grid_idx);
     Vecd alpha = (position - grid_pos) / grid_spacing_;
     Vecd beta = Vecd::Ones() - alpha;
 
-    DataType bilinear = *pkg_data_addrs[grid_idx[0]][grid_idx[1]] * beta[0] * beta[1] +
-                        *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1]] * alpha[0] * beta[1] +
-                        *pkg_data_addrs[grid_idx[0]][grid_idx[1] + 1] * beta[0] * alpha[1] +
-                        *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1] + 1] * alpha[0] * alpha[1];
+    DataType bilinear = pkg_data_addrs(grid_idx[0], grid_idx[1]) * beta[0] * beta[1] +
+                        pkg_data_addrs(grid_idx[0] + 1, grid_idx[1]) * alpha[0] * beta[1] +
+                        pkg_data_addrs(grid_idx[0], grid_idx[1] + 1) * beta[0] * alpha[1] +
+                        pkg_data_addrs(grid_idx[0] + 1, grid_idx[1] + 1) * alpha[0] * alpha[1];
 
     return bilinear;
 }
@@ -61,15 +61,15 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
     computeGradient(const MeshVariable<InDataType> &in_variable,
                     const MeshVariable<OutDataType> &out_variable)
 {
-    auto &in_variable_addrs = getPackageDataAddress(in_variable);
-    auto &out_variable_addrs = getPackageDataAddress(out_variable);
+    auto in_variable_addrs = getPackageDataAccessor(in_variable);
+    auto out_variable_addrs = getPackageDataAccessor(out_variable);
 
     for_each_addrs(
         [&](int i, int j)
         {
-            Real dphidx = (*in_variable_addrs[i + 1][j] - *in_variable_addrs[i - 1][j]);
-            Real dphidy = (*in_variable_addrs[i][j + 1] - *in_variable_addrs[i][j - 1]);
-            *out_variable_addrs[i][j] = 0.5 * Vecd(dphidx, dphidy) / grid_spacing_;
+            Real dphidx = (in_variable_addrs(i + 1, j) - in_variable_addrs(i - 1, j));
+            Real dphidy = (in_variable_addrs(i, j + 1) - in_variable_addrs(i, j - 1));
+            out_variable_addrs(i, j) = 0.5 * Vecd(dphidx, dphidy) / grid_spacing_;
         });
 }
 //=================================================================================================//
@@ -89,28 +89,27 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
-template <typename DataType>
-void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::AssignSingularPackageDataAddress<DataType>::
-operator()(DataContainerAssemble<PackageData> &all_pkg_data,
-           DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs)
+void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::assignSingularNeighborPackages()
 {
-    constexpr int type_index = DataTypeIndex<DataType>::value;
-    for (size_t l = 0; l != std::get<type_index>(all_pkg_data).size(); ++l)
-    {
-        PackageData<DataType> &pkg_data = std::get<type_index>(all_pkg_data)[l];
-        PackageDataAddress<DataType> &pkg_data_addrs = std::get<type_index>(all_pkg_data_addrs)[l];
-        for (int i = 0; i != pkg_addrs_size; ++i)
-            for (int j = 0; j != pkg_addrs_size; ++j)
-            {
-                pkg_data_addrs[i][j] = &pkg_data[0][0];
-            }
-    }
+    data_index_scale_ = 0;
+    for (int l = 0; l != 3; ++l)
+        for (int m = 0; m != 3; ++m)
+        {
+            neighbor_pkgs_[l][m] = this;
+        }
+}
+//=================================================================================================//
+template <int PKG_SIZE, int ADDRS_BUFFER>
+void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
+    assignNeighborPackage(const Arrayi &neighbor_shift, GridDataPackage *neighbor_pkg)
+{
+    neighbor_pkgs_[neighbor_shift[0] + 1][neighbor_shift[1] + 1] = neighbor_pkg;
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
 template <typename DataType>
 DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
-    CornerAverage(PackageDataAddress<DataType> &pkg_data_addrs, Arrayi addrs_index, Arrayi corner_direction)
+    CornerAverage(const PackageDataAccessor<DataType> &pkg_data_addrs, Arrayi addrs_index, Arrayi corner_direction)
 {
     DataType average = ZeroData<DataType>::value;
     for (int i = 0; i != 2; ++i)
@@ -118,28 +117,11 @@ DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
         {
             int x_index = addrs_index[0] + i * corner_direction[0];
             int y_index = addrs_index[1] + j * corner_direction[1];
-            average += *pkg_data_addrs[x_index][y_index];
+            average += pkg_data_addrs(x_index, y_index);
         }
     return average * 0.25;
 }
 //=================================================================================================//
-template <int PKG_SIZE, int ADDRS_BUFFER>
-template <typename DataType>
-void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::AssignPackageDataAddress<DataType>::
-operator()(DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs,
-           const Arrayi &addrs_index,
-           DataContainerAssemble<PackageData> &all_pkg_data,
-           const Arrayi &data_index)
-{
-    constexpr int type_index = DataTypeIndex<DataType>::value;
-    for (size_t l = 0; l != std::get<type_index>(all_pkg_data).size(); ++l)
-    {
-        PackageData<DataType> &pkg_data = std::get<type_index>(all_pkg_data)[l];
-        PackageDataAddress<DataType> &pkg_data_addrs = std::get<type_index>(all_pkg_data_addrs)[l];
-        pkg_data_addrs[addrs_index[0]][addrs_index[1]] = &pkg_data[data_index[0]][data_index[1]];
-    }
-}
-//=================================================================================================//
 template <class GridDataPackageType>
 template <typename DataType>
 DataType MeshWithGridDataPackages<GridDataPackageType>::
@@ -168,15 +150,10 @@ void MeshWithGridDataPackages<GridDataPackageType>::
     GridDataPackageType *data_pkg = data_pkg_addrs_[i][j];
     if (data_pkg->isInnerPackage())
     {
-        for (int l = 0; l != pkg_addrs_size; ++l)
-            for (int m = 0; m != pkg_addrs_size; ++m)
+        for (int l = -1; l != 2; ++l)
+            for (int m = -1; m != 2; ++m)
             {
-                std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
-                std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
-                data_pkg->assignPackageDataAddress(
-                    Arrayi(l, m),
-                    data_pkg_addrs_[i + x_pair.first][j + y_pair.first],
-                    Arrayi(x_pair.second, y_pair.second));
+                data_pkg->assignNeighborPackage(Arrayi(l, m), data_pkg_addrs_[i + l][j + m]);
             }
     }
 }
@@ -214,10 +191,10 @@ DataType MeshWithGridDataPackages<GridDataPackageType>::
 {
     Arrayi grid_index = CellIndexFromPosition(position);
     GridDataPackageType *data_pkg = data_pkg_addrs_[grid_index[0]][grid_index[1]];
-    auto &pkg_data_addrs = data_pkg->getPackageDataAddress(mesh_variable);
     return data_pkg->isInnerPackage() ? data_pkg->GridDataPackageType::
-                                            template probeDataPackage<DataType>(pkg_data_addrs, position)
-                                      : *pkg_data_addrs[0][0];
+                                            template probeDataPackage<DataType>(
+                                                data_pkg->getPackageDataAccessor(mesh_variable), position)
+                                      : data_pkg->getPackageData(mesh_variable)[0][0];
 }
 //=================================================================================================//
 } // namespace SPH
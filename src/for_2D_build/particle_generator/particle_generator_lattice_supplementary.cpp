@@ -9,44 +9,77 @@
 namespace SPH
 {
 //=================================================================================================//
-void ParticleGeneratorLattice::initializeGeometricVariables()
+void BaseParticleGeneratorLattice::findContainedLatticePositions(StdLargeVec<Vecd> &contained_positions)
 {
     BaseMesh mesh(domain_bounds_, lattice_spacing_, 0);
-    Real particle_volume = lattice_spacing_ * lattice_spacing_;
     Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
+    size_t number_of_tiles = number_of_lattices[0];
+    StdVec<StdVec<Vecd>> tile_positions(number_of_tiles);
+    parallel_for(
+        IndexRange(0, number_of_tiles),
+        [&](const IndexRange &r)
         {
-            Vecd particle_position = mesh.CellPositionFromIndex(Arrayi(i, j));
-            if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
+            StdVec<Vecd> lattice_positions;
+            StdVec<int> is_contained;
+            for (size_t n = r.begin(); n != r.end(); ++n)
             {
-                if (body_shape_.checkContain(particle_position))
+                int i = n;
+                lattice_positions.clear();
+                for (int j = 0; j < number_of_lattices[1]; ++j)
+                {
+                    lattice_positions.push_back(mesh.CellPositionFromIndex(Arrayi(i, j)));
+                }
+                body_shape_.checkContainBatch(lattice_positions, is_contained);
+                for (size_t l = 0; l != lattice_positions.size(); ++l)
                 {
-                    initializePositionAndVolumetricMeasure(particle_position, particle_volume);
+                    if (is_contained[l])
+                        tile_positions[n].push_back(lattice_positions[l]);
                 }
             }
-        }
+        },
+        ap);
+
+    StdVec<size_t> tile_offsets(number_of_tiles + 1, 0);
+    for (size_t n = 0; n != number_of_tiles; ++n)
+    {
+        tile_offsets[n + 1] = tile_offsets[n] + tile_positions[n].size();
+    }
+    contained_positions.resize(tile_offsets.back());
+    parallel_for(
+        IndexRange(0, number_of_tiles),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                std::copy(tile_positions[n].begin(), tile_positions[n].end(),
+                          contained_positions.begin() + tile_offsets[n]);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void ParticleGeneratorLattice::initializeGeometricVariables()
+{
+    StdLargeVec<Vecd> contained_positions;
+    findContainedLatticePositions(contained_positions);
+    Real particle_volume = lattice_spacing_ * lattice_spacing_;
+    pos_.reserve(pos_.size() + contained_positions.size());
+    unsorted_id_.reserve(unsorted_id_.size() + contained_positions.size());
+    Vol_.reserve(Vol_.size() + contained_positions.size());
+    for (const Vecd &particle_position : contained_positions)
+    {
+        initializePositionAndVolumetricMeasure(particle_position, particle_volume);
+    }
 }
 //=================================================================================================//
 void ThickSurfaceParticleGeneratorLattice::initializeGeometricVariables()
 {
     // Calculate the total volume and
     // count the number of cells inside the body volume, where we might put particles.
-    std::unique_ptr<BaseMesh> mesh(new BaseMesh(domain_bounds_, lattice_spacing_, 0));
-    Arrayi number_of_lattices = mesh->AllCellsFromAllGridPoints(mesh->AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
-        {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (body_shape_.checkContain(particle_position))
-                {
-                    all_cells_++;
-                    total_volume_ += lattice_spacing_ * lattice_spacing_;
-                }
-            }
-        }
+    StdLargeVec<Vecd> contained_positions;
+    findContainedLatticePositions(contained_positions);
+    all_cells_ += contained_positions.size();
+    total_volume_ += contained_positions.size() * lattice_spacing_ * lattice_spacing_;
     Real number_of_particles = total_volume_ / avg_particle_volume_ + 0.5;
     planned_number_of_particles_ = int(number_of_particles);
 
@@ -60,24 +93,16 @@ void ThickSurfaceParticleGeneratorLattice::initializeGeometricVariables()
     std::uniform_real_distribution<Real> unif(0, 1);
 
     // Add a particle in each interval, randomly. We will skip the last intervals if we already reach the number of particles
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
+    for (const Vecd &particle_position : contained_positions)
+    {
+        Real random_real = unif(rng);
+        // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles
+        if (random_real <= interval && base_particles_.total_real_particles_ < planned_number_of_particles_)
         {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (body_shape_.checkContain(particle_position))
-                {
-                    Real random_real = unif(rng);
-                    // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles
-                    if (random_real <= interval && base_particles_.total_real_particles_ < planned_number_of_particles_)
-                    {
-                        initializePositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / global_avg_thickness_);
-                        initializeSurfaceProperties(body_shape_.findNormalDirection(particle_position), global_avg_thickness_);
-                    }
-                }
-            }
+            initializePositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / global_avg_thickness_);
+            initializeSurfaceProperties(body_shape_.findNormalDirection(particle_position), global_avg_thickness_);
         }
+    }
 }
 //=================================================================================================//
 } // namespace SPH
@@ -69,6 +69,17 @@ bool GeometricShapeBall::checkContain(const Vec3d &probe_point, bool BOUNDARY_IN
     return (probe_point - center_).norm() < sphere_.getRadius();
 }
 //=================================================================================================//
+void GeometricShapeBall::checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                           bool BOUNDARY_INCLUDED)
+{
+    Real radius_square = sphere_.getRadius() * sphere_.getRadius();
+    is_contained.resize(probe_points.size());
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        is_contained[i] = (probe_points[i] - center_).squaredNorm() < radius_square;
+    }
+}
+//=================================================================================================//
 Vec3d GeometricShapeBall::findClosestPoint(const Vec3d &probe_point)
 {
     Vec3d displacement = probe_point - center_;
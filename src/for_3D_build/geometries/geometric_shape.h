@@ -80,6 +80,8 @@ class GeometricShapeBall : public GeometricShape
     virtual ~GeometricShapeBall(){};
 
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
 
   protected:
@@ -24,6 +24,37 @@ bool ImageShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
     }
 }
 //=================================================================================================//
+void ImageShape::checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED)
+{
+    is_contained.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                is_contained[i] = checkContain(probe_points[i], BOUNDARY_INCLUDED);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void ImageShape::findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances)
+{
+    signed_distances.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                signed_distances[i] = findSignedDistance(probe_points[i]);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 Vecd ImageShape::findClosestPoint(const Vecd &probe_point)
 {
     return image_->findClosestPoint(probe_point);
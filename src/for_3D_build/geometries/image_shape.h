@@ -50,7 +50,10 @@ class ImageShape : public Shape
           max_distance_(-INFINITY), min_distance_(INFINITY){};
 
     virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual void findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances) override;
 
   protected:
     Vecd translation_;
@@ -48,6 +48,7 @@ void LevelSet::finishDataPackages()
                       {
                           tagACellIsInnerPackage(Arrayi(i, j, k));
                       });
+    sortInnerDataPackages();
 
     mesh_parallel_for(MeshRange(Arrayi::Zero(), all_cells_),
                       [&](size_t i, size_t j, size_t k)
@@ -82,25 +83,25 @@ void LevelSet::diffuseLevelSetSign()
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             data_pkg->for_each_addrs(
                 [&](int i, int j, int k)
                 {
                     // near interface cells are not considered
-                    if (abs(*near_interface_id_addrs[i][j][k]) > 1)
+                    if (abs(near_interface_id_addrs(i, j, k)) > 1)
                     {
                         mesh_find_if3d<-1, 2>(
                             [&](int l, int m, int n) -> bool
                             {
-                                int near_interface_id = *near_interface_id_addrs[i + l][j + m][k + n];
+                                int near_interface_id = near_interface_id_addrs(i + l, j + m, k + n);
                                 bool is_found = abs(near_interface_id) == 1;
                                 if (is_found)
                                 {
-                                    Real phi_0 = *phi_addrs[i][j][k];
-                                    *near_interface_id_addrs[i][j][k] = near_interface_id;
-                                    *phi_addrs[i][j][k] = near_interface_id == 1 ? fabs(phi_0) : -fabs(phi_0);
+                                    Real phi_0 = phi_addrs(i, j, k);
+                                    near_interface_id_addrs(i, j, k) = near_interface_id;
+                                    phi_addrs(i, j, k) = near_interface_id == 1 ? fabs(phi_0) : -fabs(phi_0);
                                 }
                                 return is_found;
                             });
@@ -115,21 +116,21 @@ void LevelSet::reinitializeLevelSet()
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs_ = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs_ = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             data_pkg->for_each_addrs(
                 [&](int i, int j, int k)
                 {
                     // only reinitialize non cut cells
-                    if (*near_interface_id_addrs_[i][j][k] != 0)
+                    if (near_interface_id_addrs_(i, j, k) != 0)
                     {
-                        Real phi_0 = *phi_addrs[i][j][k];
+                        Real phi_0 = phi_addrs(i, j, k);
                         Real sign = phi_0 / sqrt(phi_0 * phi_0 + data_spacing_ * data_spacing_);
-                        Real dv_x = upwindDifference(sign, *phi_addrs[i + 1][j][k] - phi_0, phi_0 - *phi_addrs[i - 1][j][k]);
-                        Real dv_y = upwindDifference(sign, *phi_addrs[i][j + 1][k] - phi_0, phi_0 - *phi_addrs[i][j - 1][k]);
-                        Real dv_z = upwindDifference(sign, *phi_addrs[i][j][k + 1] - phi_0, phi_0 - *phi_addrs[i][j][k - 1]);
-                        *phi_addrs[i][j][k] -= 0.3 * sign * (Vec3d(dv_x, dv_y, dv_z).norm() - data_spacing_);
+                        Real dv_x = upwindDifference(sign, phi_addrs(i + 1, j, k) - phi_0, phi_0 - phi_addrs(i - 1, j, k));
+                        Real dv_y = upwindDifference(sign, phi_addrs(i, j + 1, k) - phi_0, phi_0 - phi_addrs(i, j - 1, k));
+                        Real dv_z = upwindDifference(sign, phi_addrs(i, j, k + 1) - phi_0, phi_0 - phi_addrs(i, j, k - 1));
+                        phi_addrs(i, j, k) -= 0.3 * sign * (Vec3d(dv_x, dv_y, dv_z).norm() - data_spacing_);
                     }
                 });
         });
@@ -143,8 +144,8 @@ void LevelSet::markNearInterface(Real small_shift_factor)
         inner_data_pkgs_,
         [&](LevelSetDataPackage *data_pkg)
         {
-            auto &phi_addrs = data_pkg->getPackageDataAddress(phi_);
-            auto &near_interface_id_addrs = data_pkg->getPackageDataAddress(near_interface_id_);
+            auto phi_addrs = data_pkg->getPackageDataAccessor(phi_);
+            auto near_interface_id_addrs = data_pkg->getPackageDataAccessor(near_interface_id_);
 
             // corner averages, note that the first row and first column are not used
             LevelSetDataPackage::PackageTemporaryData<Real> corner_averages;
@@ -158,7 +159,7 @@ void LevelSet::markNearInterface(Real small_shift_factor)
                 [&](int i, int j, int k)
                 {
                     // first assume far cells
-                    Real phi_0 = *phi_addrs[i][j][k];
+                    Real phi_0 = phi_addrs(i, j, k);
                     int near_interface_id = phi_0 > 0.0 ? 2 : -2;
                     if (fabs(phi_0) < small_shift)
                     {
@@ -184,7 +185,7 @@ void LevelSet::markNearInterface(Real small_shift_factor)
                             });
                     }
                     // assign this is to package
-                    *near_interface_id_addrs[i][j][k] = near_interface_id;
+                    near_interface_id_addrs(i, j, k) = near_interface_id;
                 });
         });
 }
@@ -193,11 +194,20 @@ void LevelSet::initializeBasicDataForAPackage(LevelSetDataPackage *data_pkg, Sha
 {
     auto &phi = data_pkg->getPackageData(phi_);
     auto &near_interface_id = data_pkg->getPackageData(near_interface_id_);
+    StdVec<Vecd> positions;
     data_pkg->for_each_data(
         [&](int i, int j, int k)
         {
-            Vec3d position = data_pkg->DataPositionFromIndex(Vec3d(i, j, k));
-            phi[i][j][k] = shape.findSignedDistance(position);
+            positions.push_back(data_pkg->DataPositionFromIndex(Vec3d(i, j, k)));
+        });
+    StdVec<Real> signed_distances;
+    shape.findSignedDistanceBatch(positions, signed_distances);
+
+    size_t n = 0;
+    data_pkg->for_each_data(
+        [&](int i, int j, int k)
+        {
+            phi[i][j][k] = signed_distances[n++];
             near_interface_id[i][j][k] = phi[i][j][k] < 0.0 ? -2 : 2;
         });
 }
@@ -207,13 +217,13 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
     int l = (int)core_data_pkg->CellIndexOnMesh()[0];
     int m = (int)core_data_pkg->CellIndexOnMesh()[1];
     int n = (int)core_data_pkg->CellIndexOnMesh()[2];
-    auto &phi_addrs = core_data_pkg->getPackageDataAddress(phi_);
-    auto &near_interface_id_addrs = core_data_pkg->getPackageDataAddress(near_interface_id_);
+    auto phi_addrs = core_data_pkg->getPackageDataAccessor(phi_);
+    auto near_interface_id_addrs = core_data_pkg->getPackageDataAccessor(near_interface_id_);
 
     core_data_pkg->for_each_addrs(
         [&](int i, int j, int k)
         {
-            int near_interface_id = *near_interface_id_addrs[i][j][k];
+            int near_interface_id = near_interface_id_addrs(i, j, k);
             if (near_interface_id == 0)
             {
                 bool positive_band = false;
@@ -221,7 +231,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                 mesh_for_each3d<-1, 2>(
                     [&](int r, int s, int t)
                     {
-                        int neighbor_near_interface_id = *near_interface_id_addrs[i + r][j + s][k + t];
+                        int neighbor_near_interface_id = near_interface_id_addrs(i + r, j + s, k + t);
                         if (neighbor_near_interface_id >= 1)
                             positive_band = true;
                         if (neighbor_near_interface_id <= -1)
@@ -248,11 +258,11 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                                 min_distance_p = SMIN(min_distance_p, (Vecd((Real)x, (Real)y, Real(z)) * data_spacing_ + phi_p_ * norm_to_face).norm());
                             }
                         });
-                    *phi_addrs[i][j][k] = -min_distance_p;
+                    phi_addrs(i, j, k) = -min_distance_p;
                     // this immediate switch of near interface id
                     // does not intervening with the identification of unresolved interface
                     // based on the assumption that positive false_and negative bands are not close to each other
-                    *near_interface_id_addrs[i][j][k] = -1;
+                    near_interface_id_addrs(i, j, k) = -1;
                 }
                 if (negative_band == false)
                 {
@@ -275,11 +285,11 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                                 min_distance_n = SMIN(min_distance_n, (Vecd((Real)x, (Real)y, Real(z)) * data_spacing_ - phi_n_ * norm_to_face).norm());
                             }
                         });
-                    *phi_addrs[i][j][k] = min_distance_n;
+                    phi_addrs(i, j, k) = min_distance_n;
                     // this immediate switch of near interface id
                     // does not intervening with the identification of unresolved interface
                     // based on the assumption that positive false_and negative bands are not close to each other
-                    *near_interface_id_addrs[i][j][k] = 1;
+                    near_interface_id_addrs(i, j, k) = 1;
                 }
             }
         });
@@ -0,0 +1,417 @@
+#include "triangle_mesh_distance.h"
+
+#include <algorithm>
+
+namespace SPH
+{
+//=================================================================================================//
+TriangleMeshDistance::
+    TriangleMeshDistance(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &faces)
+    : vertices_(vertices), faces_(faces), is_closed_(false)
+{
+    if (faces_.empty())
+    {
+        std::cout << "\n Error: the triangle mesh has no face!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    // not aligned with axes and lattices to avoid rays running along edges or faces
+    ray_directions_[0] = Vec3d(1.0, 0.3711, 0.2137).normalized();
+    ray_directions_[1] = Vec3d(-0.2843, 1.0, 0.4519).normalized();
+    ray_directions_[2] = Vec3d(0.3217, -0.5693, 1.0).normalized();
+    is_closed_ = checkClosed();
+
+    StdVec<Vec3d> centroids(faces_.size());
+    for (size_t i = 0; i != faces_.size(); ++i)
+    {
+        centroids[i] = (vertices_[faces_[i][0]] + vertices_[faces_[i][1]] + vertices_[faces_[i][2]]) / 3.0;
+    }
+    nodes_.reserve(2 * faces_.size() / max_leaf_size_ + 1);
+    buildNode(0, faces_.size(), centroids);
+
+    // the faces are sorted along the tree, so that they are referred to by their indices afterwards
+    if (!is_closed_)
+    {
+        vertex_faces_.resize(vertices_.size());
+        for (size_t i = 0; i != faces_.size(); ++i)
+            for (int l = 0; l != 3; ++l)
+                vertex_faces_[faces_[i][l]].push_back(i);
+    }
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkClosed() const
+{
+    StdVec<std::pair<int, int>> edges;
+    edges.reserve(3 * faces_.size());
+    for (const std::array<int, 3> &face : faces_)
+        for (int l = 0; l != 3; ++l)
+        {
+            int first = face[l];
+            int second = face[(l + 1) % 3];
+            edges.push_back(std::make_pair(SMIN(first, second), SMAX(first, second)));
+        }
+    std::sort(edges.begin(), edges.end());
+
+    for (size_t i = 0; i < edges.size(); i += 2)
+    {
+        bool is_shared_by_two = i + 1 < edges.size() && edges[i + 1] == edges[i] &&
+                                (i + 2 == edges.size() || edges[i + 2] != edges[i]);
+        if (!is_shared_by_two)
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
+int TriangleMeshDistance::buildNode(size_t first, size_t last, StdVec<Vec3d> &centroids)
+{
+    int node_index = nodes_.size();
+    nodes_.push_back(BVHNode());
+    Vec3d lower = MaxReal * Vec3d::Ones();
+    Vec3d upper = -MaxReal * Vec3d::Ones();
+    Vec3d centroid_lower = lower;
+    Vec3d centroid_upper = upper;
+    for (size_t i = first; i != last; ++i)
+    {
+        for (int l = 0; l != 3; ++l)
+        {
+            lower = lower.cwiseMin(vertices_[faces_[i][l]]);
+            upper = upper.cwiseMax(vertices_[faces_[i][l]]);
+        }
+        centroid_lower = centroid_lower.cwiseMin(centroids[i]);
+        centroid_upper = centroid_upper.cwiseMax(centroids[i]);
+    }
+
+    int left = -1, right = -1;
+    if (last - first > max_leaf_size_)
+    {
+        // median split along the longest extent of the centroids
+        int axis = 0;
+        (centroid_upper - centroid_lower).maxCoeff(&axis);
+        size_t middle = first + (last - first) / 2;
+        StdVec<size_t> order(last - first);
+        for (size_t i = 0; i != order.size(); ++i)
+            order[i] = first + i;
+        std::nth_element(order.begin(), order.begin() + (middle - first), order.end(),
+                         [&](size_t a, size_t b)
+                         { return centroids[a][axis] < centroids[b][axis]; });
+        StdVec<std::array<int, 3>> sorted_faces(order.size());
+        StdVec<Vec3d> sorted_centroids(order.size());
+        for (size_t i = 0; i != order.size(); ++i)
+        {
+            sorted_faces[i] = faces_[order[i]];
+            sorted_centroids[i] = centroids[order[i]];
+        }
+        std::copy(sorted_faces.begin(), sorted_faces.end(), faces_.begin() + first);
+        std::copy(sorted_centroids.begin(), sorted_centroids.end(), centroids.begin() + first);
+
+        left = buildNode(first, middle, centroids);
+        right = buildNode(middle, last, centroids);
+    }
+
+    BVHNode &node = nodes_[node_index];
+    node.lower_ = lower;
+    node.upper_ = upper;
+    node.first_ = first;
+    node.last_ = last;
+    node.left_ = left;
+    node.right_ = right;
+    return node_index;
+}
+//=================================================================================================//
+Real TriangleMeshDistance::squaredDistanceToBox(const Vec3d &probe_point, const BVHNode &node) const
+{
+    Vec3d outside = (node.lower_ - probe_point).cwiseMax(probe_point - node.upper_).cwiseMax(Vec3d::Zero());
+    return outside.squaredNorm();
+}
+//=================================================================================================//
+Vec3d TriangleMeshDistance::closestPointOnTriangle(const Vec3d &p, size_t face_index) const
+{
+    // Ericson, Real-Time Collision Detection, Section 5.1.5.
+    const Vec3d &a = vertices_[faces_[face_index][0]];
+    const Vec3d &b = vertices_[faces_[face_index][1]];
+    const Vec3d &c = vertices_[faces_[face_index][2]];
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+    Vec3d ap = p - a;
+    Real d1 = ab.dot(ap);
+    Real d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+        return a;
+
+    Vec3d bp = p - b;
+    Real d3 = ab.dot(bp);
+    Real d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+        return b;
+
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+        return a + d1 / (d1 - d3) * ab;
+
+    Vec3d cp = p - c;
+    Real d5 = ab.dot(cp);
+    Real d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+        return c;
+
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+        return a + d2 / (d2 - d6) * ac;
+
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+    Real denominator = 1.0 / (va + vb + vc);
+    return a + ab * vb * denominator + ac * vc * denominator;
+}
+//=================================================================================================//
+size_t TriangleMeshDistance::
+    findClosestFace(const Vec3d &probe_point, Vec3d &closest_point, Real squared_distance_bound) const
+{
+    Real min_squared_distance = squared_distance_bound;
+    size_t closest_face = faces_.size();
+
+    int stack[64];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const BVHNode &node = nodes_[stack[--stack_size]];
+        if (squaredDistanceToBox(probe_point, node) >= min_squared_distance)
+            continue;
+
+        if (node.left_ < 0)
+        {
+            for (size_t i = node.first_; i != node.last_; ++i)
+            {
+                Vec3d point = closestPointOnTriangle(probe_point, i);
+                Real squared_distance = (point - probe_point).squaredNorm();
+                if (squared_distance < min_squared_distance)
+                {
+                    min_squared_distance = squared_distance;
+                    closest_point = point;
+                    closest_face = i;
+                }
+            }
+        }
+        else
+        {
+            // the nearer child is pushed last to be visited first
+            Real left_distance = squaredDistanceToBox(probe_point, nodes_[node.left_]);
+            Real right_distance = squaredDistanceToBox(probe_point, nodes_[node.right_]);
+            bool left_first = left_distance < right_distance;
+            stack[stack_size++] = left_first ? node.right_ : node.left_;
+            stack[stack_size++] = left_first ? node.left_ : node.right_;
+        }
+    }
+
+    return closest_face;
+}
+//=================================================================================================//
+Vec3d TriangleMeshDistance::findClosestPoint(const Vec3d &probe_point, Real squared_distance_bound) const
+{
+    Vec3d closest_point = probe_point;
+    // the given bound was not an upper bound, search again without it
+    if (findClosestFace(probe_point, closest_point, squared_distance_bound) == faces_.size())
+        findClosestFace(probe_point, closest_point, MaxReal);
+    return closest_point;
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkRayHitBox(const Vec3d &origin, const Vec3d &inv_direction, const BVHNode &node) const
+{
+    Vec3d t_lower = (node.lower_ - origin).cwiseProduct(inv_direction);
+    Vec3d t_upper = (node.upper_ - origin).cwiseProduct(inv_direction);
+    Real t_enter = t_lower.cwiseMin(t_upper).maxCoeff();
+    Real t_exit = t_lower.cwiseMax(t_upper).minCoeff();
+    return t_exit >= SMAX(t_enter, Real(0));
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkRayHitTriangle(const Vec3d &origin, const Vec3d &direction, size_t face_index) const
+{
+    // Moller and Trumbore, Fast, minimum storage ray-triangle intersection.
+    const std::array<int, 3> &face = faces_[face_index];
+    const Vec3d &a = vertices_[face[0]];
+    Vec3d edge1 = vertices_[face[1]] - a;
+    Vec3d edge2 = vertices_[face[2]] - a;
+    Vec3d p = direction.cross(edge2);
+    Real determinant = edge1.dot(p);
+    if (ABS(determinant) < TinyReal)
+        return false; // ray parallel to the triangle
+
+    Real inv_determinant = 1.0 / determinant;
+    Vec3d s = origin - a;
+    Real u = s.dot(p) * inv_determinant;
+    if (u < 0.0 || u > 1.0)
+        return false;
+    Vec3d q = s.cross(edge1);
+    Real v = direction.dot(q) * inv_determinant;
+    Real w = 1.0 - u - v;
+    if (v < 0.0 || w < 0.0)
+        return false;
+    // half-open edges, otherwise a hit on a shared edge is counted twice
+    if (u == 0.0 && !checkEdgeOwned(direction, face[0], face[2], face[1]))
+        return false;
+    if (v == 0.0 && !checkEdgeOwned(direction, face[0], face[1], face[2]))
+        return false;
+    if (w == 0.0 && !checkEdgeOwned(direction, face[1], face[2], face[0]))
+        return false;
+    return edge2.dot(q) * inv_determinant > 0.0;
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkEdgeOwned(const Vec3d &direction, int first, int second, int opposite) const
+{
+    // The edge is oriented by the vertex indices so that the faces sharing it agree on the orientation.
+    // Only the face on the positive side of the plane spanned by the ray and the edge owns the edge,
+    // and a ray only touching the surface at the edge is counted by both faces or by none.
+    const Vec3d &start = vertices_[SMIN(first, second)];
+    const Vec3d &end = vertices_[SMAX(first, second)];
+    return direction.cross(end - start).dot(vertices_[opposite] - start) > 0.0;
+}
+//=================================================================================================//
+size_t TriangleMeshDistance::countRayCrossings(const Vec3d &origin, const Vec3d &direction) const
+{
+    Vec3d inv_direction = direction.cwiseInverse();
+    size_t crossings = 0;
+
+    int stack[64];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const BVHNode &node = nodes_[stack[--stack_size]];
+        if (!checkRayHitBox(origin, inv_direction, node))
+            continue;
+
+        if (node.left_ < 0)
+        {
+            for (size_t i = node.first_; i != node.last_; ++i)
+            {
+                if (checkRayHitTriangle(origin, direction, i))
+                    crossings++;
+            }
+        }
+        else
+        {
+            stack[stack_size++] = node.left_;
+            stack[stack_size++] = node.right_;
+        }
+    }
+    return crossings;
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkContainByRayParity(const Vec3d &probe_point) const
+{
+    int inside_votes = 0;
+    for (const Vec3d &direction : ray_directions_)
+    {
+        if (countRayCrossings(probe_point, direction) % 2 == 1)
+            inside_votes++;
+    }
+    return inside_votes >= 2;
+}
+//=================================================================================================//
+Vec3d TriangleMeshDistance::findPseudoNormal(const Vec3d &closest_point, size_t face_index) const
+{
+    // Baerentzen and Aanaes, Signed distance computation using the angle weighted pseudonormal.
+    const std::array<int, 3> &face = faces_[face_index];
+    Real edge_scale = 0.0;
+    for (int l = 0; l != 3; ++l)
+        edge_scale = SMAX(edge_scale, (vertices_[face[(l + 1) % 3]] - vertices_[face[l]]).norm());
+    Real tolerance = SqrtEps * edge_scale;
+
+    Vec3d pseudo_normal = Vec3d::Zero();
+    StdVec<size_t> visited_faces;
+    for (int l = 0; l != 3; ++l)
+        for (size_t i : vertex_faces_[face[l]])
+        {
+            if (std::find(visited_faces.begin(), visited_faces.end(), i) != visited_faces.end())
+                continue;
+            visited_faces.push_back(i);
+            // only the faces sharing the closest point, i.e. sharing its edge or vertex
+            if ((closestPointOnTriangle(closest_point, i) - closest_point).norm() > tolerance)
+                continue;
+
+            const std::array<int, 3> &other = faces_[i];
+            Vec3d normal = (vertices_[other[1]] - vertices_[other[0]])
+                               .cross(vertices_[other[2]] - vertices_[other[0]])
+                               .normalized();
+            // weighted by the incident angle at a vertex, and equally for the faces sharing an edge
+            Real weight = 1.0;
+            for (int k = 0; k != 3; ++k)
+            {
+                if ((vertices_[other[k]] - closest_point).norm() <= tolerance)
+                {
+                    Vec3d to_next = (vertices_[other[(k + 1) % 3]] - vertices_[other[k]]).normalized();
+                    Vec3d to_previous = (vertices_[other[(k + 2) % 3]] - vertices_[other[k]]).normalized();
+                    weight = acos(SMAX(Real(-1), SMIN(Real(1), to_next.dot(to_previous))));
+                }
+            }
+            pseudo_normal += weight * normal;
+        }
+    return pseudo_normal / (pseudo_normal.norm() + TinyReal);
+}
+//=================================================================================================//
+bool TriangleMeshDistance::
+    checkContainByFaceNormal(const Vec3d &probe_point, const Vec3d &closest_point, size_t face_index) const
+{
+    const Vec3d &a = vertices_[faces_[face_index][0]];
+    Vec3d face_normal = (vertices_[faces_[face_index][1]] - a).cross(vertices_[faces_[face_index][2]] - a).normalized();
+    Vec3d from_face_to_pnt = probe_point - closest_point;
+    Real distance_to_pnt = from_face_to_pnt.norm();
+    Vec3d direction_to_pnt = from_face_to_pnt / (distance_to_pnt + TinyReal);
+    Real cosine_angle = face_normal.dot(direction_to_pnt);
+
+    // The probe point is in the plane of the face, so that the closest point is on an edge or a vertex.
+    // The faces sharing it decide, instead of jittering the probe point, so that the result is deterministic.
+    if (ABS(cosine_angle) < Eps)
+        cosine_angle = findPseudoNormal(closest_point, face_index).dot(direction_to_pnt);
+    // still undecided for a probe point on the surface or in the plane beyond a boundary edge
+    return cosine_angle < -Eps;
+}
+//=================================================================================================//
+bool TriangleMeshDistance::checkContain(const Vec3d &probe_point) const
+{
+    if (is_closed_)
+        return checkContainByRayParity(probe_point);
+
+    Vec3d closest_point = probe_point;
+    size_t face_index = findClosestFace(probe_point, closest_point, MaxReal);
+    return checkContainByFaceNormal(probe_point, closest_point, face_index);
+}
+//=================================================================================================//
+Real TriangleMeshDistance::findSignedDistance(const Vec3d &probe_point, Real squared_distance_bound) const
+{
+    Vec3d closest_point = probe_point;
+    size_t face_index = findClosestFace(probe_point, closest_point, squared_distance_bound);
+    // the given bound was not an upper bound, search again without it
+    if (face_index == faces_.size())
+        face_index = findClosestFace(probe_point, closest_point, MaxReal);
+
+    Real distance = (closest_point - probe_point).norm();
+    bool is_contained = is_closed_ ? checkContainByRayParity(probe_point)
+                                   : checkContainByFaceNormal(probe_point, closest_point, face_index);
+    return is_contained ? -distance : distance;
+}
+//=================================================================================================//
+void TriangleMeshDistance::
+    findSignedDistances(const StdVec<Vec3d> &probe_points, StdVec<Real> &signed_distances) const
+{
+    signed_distances.resize(probe_points.size());
+    Real previous_distance = MaxReal;
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        const Vec3d &probe_point = probe_points[i];
+        Real squared_distance_bound = MaxReal;
+        if (i != 0)
+        {
+            // the distance is Lipschitz continuous with respect to the probe position
+            Real distance_bound = previous_distance + (probe_point - probe_points[i - 1]).norm();
+            squared_distance_bound = distance_bound * distance_bound * (1.0 + SqrtEps) + TinyReal;
+        }
+        signed_distances[i] = findSignedDistance(probe_point, squared_distance_bound);
+        previous_distance = ABS(signed_distances[i]);
+    }
+}
+//=================================================================================================//
+} // namespace SPH
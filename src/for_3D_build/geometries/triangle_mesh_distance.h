@@ -0,0 +1,103 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_distance.h
+ * @brief 	Signed distance queries on a triangle mesh with a bounding volume hierarchy.
+ * @details The queries do not modify the data structure so that they can be called concurrently,
+ * 			e.g. from the parallel construction of a level set.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef TRIANGLE_MESH_DISTANCE_H
+#define TRIANGLE_MESH_DISTANCE_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <array>
+
+namespace SPH
+{
+/**
+ * @class TriangleMeshDistance
+ * @brief Closest point, containment and signed distance of a triangle mesh.
+ * @details A bounding volume hierarchy of axis-aligned boxes is built over the triangles.
+ * The closest point is found by a traversal pruned with the distance to the boxes.
+ * For a closed mesh, the containment is decided by the parity of the ray crossings with the mesh,
+ * and the majority of three ray directions is taken to be robust for rays grazing edges or vertices.
+ * Therefore, the result does not depend on the orientation of the face normals.
+ * For an open mesh, the parity is meaningless and the containment is decided
+ * by the outward normal of the face closest to the probe point.
+ * If the probe point is in the plane of that face, the angle-weighted pseudo-normal
+ * of the faces sharing the closest edge or vertex is used instead.
+ */
+class TriangleMeshDistance
+{
+  public:
+    TriangleMeshDistance(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &faces);
+    virtual ~TriangleMeshDistance(){};
+
+    /** The search is limited within the given squared distance, which should be an upper bound. */
+    Vec3d findClosestPoint(const Vec3d &probe_point, Real squared_distance_bound = MaxReal) const;
+    bool checkContain(const Vec3d &probe_point) const;
+    Real findSignedDistance(const Vec3d &probe_point, Real squared_distance_bound = MaxReal) const;
+    /** Signed distances of a batch of points, in which the result of a point bounds the search for the next one. */
+    void findSignedDistances(const StdVec<Vec3d> &probe_points, StdVec<Real> &signed_distances) const;
+    BoundingBox getBounds() const { return BoundingBox(nodes_[0].lower_, nodes_[0].upper_); };
+    /** Whether each edge is shared by exactly two faces. */
+    bool isClosed() const { return is_closed_; };
+
+  protected:
+    struct BVHNode
+    {
+        Vec3d lower_, upper_;
+        size_t first_, last_;   /**< range of the triangles for a leaf node */
+        int left_, right_;      /**< child nodes, -1 for a leaf node */
+    };
+    static constexpr size_t max_leaf_size_ = 4;
+
+    StdVec<Vec3d> vertices_;
+    StdVec<std::array<int, 3>> faces_; /**< sorted along the tree during construction */
+    StdVec<BVHNode> nodes_;
+    std::array<Vec3d, 3> ray_directions_;
+    bool is_closed_;
+    StdVec<StdVec<size_t>> vertex_faces_; /**< faces sharing each vertex, only for an open mesh */
+
+    bool checkClosed() const;
+    int buildNode(size_t first, size_t last, StdVec<Vec3d> &centroids);
+    Real squaredDistanceToBox(const Vec3d &probe_point, const BVHNode &node) const;
+    Vec3d closestPointOnTriangle(const Vec3d &probe_point, size_t face_index) const;
+    /** Returns the index of the closest face, or the number of faces if none is found within the bound. */
+    size_t findClosestFace(const Vec3d &probe_point, Vec3d &closest_point, Real squared_distance_bound) const;
+    bool checkRayHitBox(const Vec3d &origin, const Vec3d &inv_direction, const BVHNode &node) const;
+    /** The ray hitting an edge or vertex exactly is counted for only one of the faces sharing it. */
+    bool checkRayHitTriangle(const Vec3d &origin, const Vec3d &direction, size_t face_index) const;
+    bool checkEdgeOwned(const Vec3d &direction, int first, int second, int opposite) const;
+    size_t countRayCrossings(const Vec3d &origin, const Vec3d &direction) const;
+    bool checkContainByRayParity(const Vec3d &probe_point) const;
+    /** The normal of the faces sharing the closest point, weighted by their angles at a shared vertex. */
+    Vec3d findPseudoNormal(const Vec3d &closest_point, size_t face_index) const;
+    bool checkContainByFaceNormal(const Vec3d &probe_point, const Vec3d &closest_point, size_t face_index) const;
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_DISTANCE_H
@@ -15,6 +15,15 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::generateTriangleMesh(co
     }
     std::cout << "num of faces:" << triangle_mesh->getNumFaces() << std::endl;
 
+    StdVec<Vec3d> vertices(triangle_mesh->getNumVertices());
+    for (size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = SimTKToEigen(triangle_mesh->getVertexPosition(i));
+    StdVec<std::array<int, 3>> faces(triangle_mesh->getNumFaces());
+    for (size_t i = 0; i != faces.size(); ++i)
+        for (int l = 0; l != 3; ++l)
+            faces[i][l] = triangle_mesh->getFaceVertex(i, l);
+    mesh_distance_ = mesh_distance_ptr_keeper_.createPtr<TriangleMeshDistance>(vertices, faces);
+
     return triangle_mesh;
 }
 //=================================================================================================//
@@ -31,52 +40,17 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::getTriangleMesh()
 //=================================================================================================//
 bool TriangleMeshShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
 {
-    SimTKVec2 uv_coordinate;
-    bool inside = false; // note that direct prediction is not reliable sometime.
-    int face_id;
-
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(EigenToSimTK(probe_point), inside, face_id, uv_coordinate);
-    Vec3d from_face_to_pnt = probe_point - SimTKToEigen(closest_pnt);
-    Real distance_to_pnt = from_face_to_pnt.norm();
-    Vec3d direction_to_pnt = from_face_to_pnt / (distance_to_pnt + TinyReal);
-    Vec3d face_normal = SimTKToEigen(triangle_mesh_->getFaceNormal(face_id));
-    Real cosine_angle = face_normal.dot(direction_to_pnt);
-
-    int ite = 0;
-    while (fabs(cosine_angle) < Eps)
-    {
-        Vec3d jittered = probe_point; // jittering
-        for (int l = 0; l != probe_point.size(); ++l)
-            jittered[l] = probe_point[l] + rand_uniform(-0.5, 0.5) * (SqrtEps + distance_to_pnt * 0.1);
-        Vec3d from_face_to_jittered = jittered - SimTKToEigen(closest_pnt);
-        Vec3d direction_to_jittered = from_face_to_jittered / (from_face_to_jittered.norm() + TinyReal);
-        cosine_angle = face_normal.dot(direction_to_jittered);
-
-        ite++;
-        if (ite > 100)
-        {
-            std::cout << "\n Error: TriangleMeshShape::checkContain not able to achieve!  " << std::endl;
-            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-            exit(1);
-        }
-    }
-
-    return cosine_angle < 0.0 ? true : false;
+    return mesh_distance_->checkContain(probe_point);
 }
 //=================================================================================================//
 Vecd TriangleMeshShape::findClosestPoint(const Vecd &probe_point)
 {
-    bool inside = false;
-    int face_id;
-    SimTKVec2 norm;
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(SimTKVec3(probe_point[0], probe_point[1], probe_point[2]), inside, face_id, norm);
-    if (face_id < 0 && face_id > triangle_mesh_->getNumFaces())
-    {
-        std::cout << "\n Error the nearest point is not valid" << std::endl;
-        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-        throw;
-    }
-    return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
+    return mesh_distance_->findClosestPoint(probe_point);
+}
+//=================================================================================================//
+void TriangleMeshShape::findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances)
+{
+    mesh_distance_->findSignedDistances(probe_points, signed_distances);
 }
 //=================================================================================================//
 BoundingBox TriangleMeshShape::findBounds()
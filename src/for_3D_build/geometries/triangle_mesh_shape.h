@@ -32,6 +32,7 @@
 
 #include "all_simbody.h"
 #include "base_geometry.h"
+#include "triangle_mesh_distance.h"
 
 #include <filesystem>
 #include <fstream>
@@ -49,24 +50,25 @@ class TriangleMeshShape : public Shape
 {
   private:
     UniquePtrKeeper<SimTK::ContactGeometry::TriangleMesh> triangle_mesh_ptr_keeper_;
+    UniquePtrKeeper<TriangleMeshDistance> mesh_distance_ptr_keeper_;
 
   public:
     explicit TriangleMeshShape(const std::string &shape_name, const SimTK::PolygonalMesh *mesh = nullptr)
-        : Shape(shape_name), triangle_mesh_(nullptr)
+        : Shape(shape_name), triangle_mesh_(nullptr), mesh_distance_(nullptr)
     {
         if (mesh)
             triangle_mesh_ = generateTriangleMesh(*mesh);
     };
-    /** Only reliable when the probe point is close to the shape surface.
-     * Need to be combined with level set shape and sign correction to avoid artifacts
-     * when probe distance is far from the surface. */
+    /** The containment is decided by ray crossings for a closed triangle mesh and by face normals otherwise. */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    virtual void findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances) override;
 
     SimTK::ContactGeometry::TriangleMesh *getTriangleMesh();
 
   protected:
     SimTK::ContactGeometry::TriangleMesh *triangle_mesh_;
+    TriangleMeshDistance *mesh_distance_; /**< thread-safe queries independent of Simbody */
 
     /** generate triangle mesh from polygon mesh */
     SimTK::ContactGeometry::TriangleMesh *generateTriangleMesh(const SimTK::PolygonalMesh &poly_mesh);
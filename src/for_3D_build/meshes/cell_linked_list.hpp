@@ -23,6 +23,14 @@ void CellLinkedList::searchNeighborsByParticles(
     DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
     GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation)
 {
+    if (sorted_cell_lists_built_)
+    {
+        searchNeighborsInSortedCells(dynamics_range, particle_configuration, get_search_depth, get_neighbor_relation,
+                                     [&](size_t cell_key)
+                                     { return ParticleOffset(cell_key); });
+        return;
+    }
+
     StdLargeVec<Vecd> &pos = dynamics_range.getBaseParticles().pos_;
     particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
                  [&](size_t index_i)
@@ -45,4 +53,73 @@ void CellLinkedList::searchNeighborsByParticles(
                  });
 }
 //=================================================================================================//
+template <typename GetParticleOffset, typename FunctionOnParticleRange>
+void CellLinkedList::forEachParticleRange(const Array3i &lower, const Array3i &upper,
+                                          const GetParticleOffset &get_particle_offset,
+                                          const FunctionOnParticleRange &function)
+{
+    // the cells in a row are contiguous in their keys and so are their sorted particles
+    for (int l = lower[0]; l < upper[0]; ++l)
+        for (int m = lower[1]; m < upper[1]; ++m)
+        {
+            size_t begin_key = transferMeshIndexTo1D(all_cells_, Array3i(l, m, lower[2]));
+            function(get_particle_offset(begin_key), get_particle_offset(begin_key + upper[2] - lower[2]));
+        }
+}
+//=================================================================================================//
+template <typename GetParticleOffset>
+ListData CellLinkedList::findNearestSortedListDataEntry(const Vecd &position, const GetParticleOffset &get_particle_offset)
+{
+    Real min_distance_sqr = MaxReal;
+    ListData nearest_entry(MaxSize_t, MaxReal * Vecd::Ones(), MaxReal);
+
+    Array3i cell = CellIndexFromPosition(position);
+    forEachParticleRange(
+        Array3i::Zero().max(cell - Array3i::Ones()), all_cells_.min(cell + 2 * Array3i::Ones()), get_particle_offset,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t s = begin; s != end; ++s)
+            {
+                Real distance_sqr = (position - sorted_particle_position_[s]).squaredNorm();
+                if (distance_sqr < min_distance_sqr)
+                {
+                    min_distance_sqr = distance_sqr;
+                    nearest_entry = ListData(sorted_particle_index_[s], sorted_particle_position_[s],
+                                             sorted_particle_volume_[s]);
+                }
+            }
+        });
+    return nearest_entry;
+}
+//=================================================================================================//
+template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation, typename GetParticleOffset>
+void CellLinkedList::searchNeighborsInSortedCells(
+    DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+    GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation,
+    const GetParticleOffset &get_particle_offset)
+{
+    StdLargeVec<Vecd> &pos = dynamics_range.getBaseParticles().pos_;
+    particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
+                 [&](size_t index_i)
+                 {
+                     int search_depth = get_search_depth(index_i);
+                     Array3i target_cell_index = CellIndexFromPosition(pos[index_i]);
+
+                     Neighborhood &neighborhood = particle_configuration[index_i];
+                     forEachParticleRange(
+                         Array3i::Zero().max(target_cell_index - search_depth * Array3i::Ones()),
+                         all_cells_.min(target_cell_index + (search_depth + 1) * Array3i::Ones()),
+                         get_particle_offset,
+                         [&](size_t begin, size_t end)
+                         {
+                             for (size_t s = begin; s != end; ++s)
+                             {
+                                 ListData list_data(sorted_particle_index_[s], sorted_particle_position_[s],
+                                                    sorted_particle_volume_[s]);
+                                 get_neighbor_relation(neighborhood, pos[index_i], index_i, list_data);
+                             }
+                         });
+                 });
+}
+//=================================================================================================//
 } // namespace SPH
@@ -6,6 +6,7 @@
 #include "cell_linked_list.h"
 
 #include "base_particles.hpp"
+#include "cell_linked_list.hpp"
 #include "mesh_iterators.hpp"
 
 namespace SPH
@@ -66,6 +67,16 @@ void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
         });
 }
 //=================================================================================================//
+size_t CellLinkedList::ParticlesInCell(const Array3i &cell_index)
+{
+    if (sorted_cell_lists_built_)
+    {
+        size_t cell_key = transferMeshIndexTo1D(all_cells_, cell_index);
+        return cell_offsets_[cell_key + 1] - cell_offsets_[cell_key];
+    }
+    return cell_index_lists_[cell_index[0]][cell_index[1]][cell_index[2]].size();
+}
+//=================================================================================================//
 void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &particle_position)
 {
     Array3i cell_pos = CellIndexFromPosition(particle_position);
@@ -82,6 +93,12 @@ void CellLinkedList ::InsertListDataEntry(size_t particle_index,
 //=================================================================================================//
 ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 {
+    if (sorted_cell_lists_built_)
+    {
+        return findNearestSortedListDataEntry(position, [&](size_t cell_key)
+                                              { return cell_offsets_[cell_key]; });
+    }
+
     Real min_distance_sqr = MaxReal;
     ListData nearest_entry = std::make_tuple(MaxSize_t, MaxReal * Vecd::Ones(), MaxReal);
 
@@ -108,6 +125,7 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 void CellLinkedList::
     tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 {
+    cell_index_lists_required_ = true;
     mesh_parallel_for(
         MeshRange(Array3i::Zero(), all_cells_),
         [&](int i, int j, int k)
@@ -131,11 +149,13 @@ void CellLinkedList::
 void CellLinkedList::
     tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis)
 {
+    cell_index_lists_required_ = true;
     int second_axis = NextAxis(axis);
     int third_axis = NextNextAxis(axis);
     Array3i body_lower_bound_cell_ = CellIndexFromPosition(bounding_bounds.first_);
     Array3i body_upper_bound_cell_ = CellIndexFromPosition(bounding_bounds.second_);
 
+    // two layers of cells inside the bounds to cover the periodic images with neighbor skin
     // lower bound cells
     for (int k = SMAX(body_lower_bound_cell_[third_axis] - 1, 0);
          k < SMIN(body_upper_bound_cell_[third_axis] + 2, all_cells_[third_axis]); ++k)
@@ -144,7 +164,7 @@ void CellLinkedList::
              j < SMIN(body_upper_bound_cell_[second_axis] + 2, all_cells_[second_axis]); ++j)
         {
             for (int i = SMAX(body_lower_bound_cell_[axis] - 1, 0);
-                 i < SMIN(body_lower_bound_cell_[axis] + 2, all_cells_[axis]); ++i)
+                 i < SMIN(body_lower_bound_cell_[axis] + 3, all_cells_[axis]); ++i)
             {
                 Array3i cell = Array3i::Zero();
                 cell[axis] = i;
@@ -163,7 +183,7 @@ void CellLinkedList::
         for (int j = SMAX(body_lower_bound_cell_[second_axis] - 1, 0);
              j < SMIN(body_upper_bound_cell_[second_axis] + 2, all_cells_[second_axis]); ++j)
         {
-            for (int i = SMAX(body_upper_bound_cell_[axis] - 1, 0);
+            for (int i = SMAX(body_upper_bound_cell_[axis] - 2, 0);
                  i < SMIN(body_upper_bound_cell_[axis] + 2, all_cells_[axis]); ++i)
             {
                 Array3i cell = Array3i::Zero();
@@ -231,7 +251,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
         {
             for (int i = 0; i != number_of_operation[0]; ++i)
             {
-                output_file << cell_index_lists_[i][j][k].size() << " ";
+                output_file << ParticlesInCell(Array3i(i, j, k)) << " ";
             }
             output_file << " \n";
         }
@@ -41,21 +41,21 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
 template <int PKG_SIZE, int ADDRS_BUFFER>
 template <class DataType>
 DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
-    probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position)
+    probeDataPackage(const PackageDataAccessor<DataType> &pkg_data_addrs, const Vecd &position)
 {
     Arrayi grid_idx = CellIndexFromPosition(position);
     Vecd grid_pos = GridPositionFromIndex(grid_idx);
     Vecd alpha = (position - grid_pos) / grid_spacing_;
     Vecd beta = Vecd::Ones() - alpha;
 
-    DataType bilinear_1 = *pkg_data_addrs[grid_idx[0]][grid_idx[1]][grid_idx[2]] * beta[0] * beta[1] +
-                          *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1]][grid_idx[2]] * alpha[0] * beta[1] +
-                          *pkg_data_addrs[grid_idx[0]][grid_idx[1] + 1][grid_idx[2]] * beta[0] * alpha[1] +
-                          *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1] + 1][grid_idx[2]] * alpha[0] * alpha[1];
-    DataType bilinear_2 = *pkg_data_addrs[grid_idx[0]][grid_idx[1]][grid_idx[2] + 1] * beta[0] * beta[1] +
-                          *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1]][grid_idx[2] + 1] * alpha[0] * beta[1] +
-                          *pkg_data_addrs[grid_idx[0]][grid_idx[1] + 1][grid_idx[2] + 1] * beta[0] * alpha[1] +
-                          *pkg_data_addrs[grid_idx[0] + 1][grid_idx[1] + 1][grid_idx[2] + 1] * alpha[0] * alpha[1];
+    DataType bilinear_1 = pkg_data_addrs(grid_idx[0], grid_idx[1], grid_idx[2]) * beta[0] * beta[1] +
+                          pkg_data_addrs(grid_idx[0] + 1, grid_idx[1], grid_idx[2]) * alpha[0] * beta[1] +
+                          pkg_data_addrs(grid_idx[0], grid_idx[1] + 1, grid_idx[2]) * beta[0] * alpha[1] +
+                          pkg_data_addrs(grid_idx[0] + 1, grid_idx[1] + 1, grid_idx[2]) * alpha[0] * alpha[1];
+    DataType bilinear_2 = pkg_data_addrs(grid_idx[0], grid_idx[1], grid_idx[2] + 1) * beta[0] * beta[1] +
+                          pkg_data_addrs(grid_idx[0] + 1, grid_idx[1], grid_idx[2] + 1) * alpha[0] * beta[1] +
+                          pkg_data_addrs(grid_idx[0], grid_idx[1] + 1, grid_idx[2] + 1) * beta[0] * alpha[1] +
+                          pkg_data_addrs(grid_idx[0] + 1, grid_idx[1] + 1, grid_idx[2] + 1) * alpha[0] * alpha[1];
     return bilinear_1 * beta[2] + bilinear_2 * alpha[2];
 }
 //=================================================================================================//
@@ -65,16 +65,16 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
     computeGradient(const MeshVariable<InDataType> &in_variable,
                     const MeshVariable<OutDataType> &out_variable)
 {
-    auto &in_variable_addrs = getPackageDataAddress(in_variable);
-    auto &out_variable_addrs = getPackageDataAddress(out_variable);
+    auto in_variable_addrs = getPackageDataAccessor(in_variable);
+    auto out_variable_addrs = getPackageDataAccessor(out_variable);
 
     for_each_addrs(
         [&](int i, int j, int k)
         {
-            Real dphidx = (*in_variable_addrs[i + 1][j][k] - *in_variable_addrs[i - 1][j][k]);
-            Real dphidy = (*in_variable_addrs[i][j + 1][k] - *in_variable_addrs[i][j - 1][k]);
-            Real dphidz = (*in_variable_addrs[i][j][k + 1] - *in_variable_addrs[i][j][k - 1]);
-            *out_variable_addrs[i][j][k] = 0.5 * Vecd(dphidx, dphidy, dphidz) / grid_spacing_;
+            Real dphidx = (in_variable_addrs(i + 1, j, k) - in_variable_addrs(i - 1, j, k));
+            Real dphidy = (in_variable_addrs(i, j + 1, k) - in_variable_addrs(i, j - 1, k));
+            Real dphidz = (in_variable_addrs(i, j, k + 1) - in_variable_addrs(i, j, k - 1));
+            out_variable_addrs(i, j, k) = 0.5 * Vecd(dphidx, dphidy, dphidz) / grid_spacing_;
         });
 }
 //=================================================================================================//
@@ -95,47 +95,28 @@ void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
-template <typename DataType>
-void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::AssignSingularPackageDataAddress<DataType>::
-operator()(DataContainerAssemble<PackageData> &all_pkg_data,
-           DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs)
+void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::assignSingularNeighborPackages()
 {
-    constexpr int type_index = DataTypeIndex<DataType>::value;
-    for (size_t l = 0; l != std::get<type_index>(all_pkg_data).size(); ++l)
-    {
-        PackageData<DataType> &pkg_data = std::get<type_index>(all_pkg_data)[l];
-        PackageDataAddress<DataType> &pkg_data_addrs = std::get<type_index>(all_pkg_data_addrs)[l];
-        for (int i = 0; i != pkg_addrs_size; ++i)
-            for (int j = 0; j != pkg_addrs_size; ++j)
-                for (int k = 0; k != pkg_addrs_size; ++k)
-                {
-                    pkg_data_addrs[i][j][k] = &pkg_data[0][0][0];
-                }
-    }
+    data_index_scale_ = 0;
+    for (int l = 0; l != 3; ++l)
+        for (int m = 0; m != 3; ++m)
+            for (int n = 0; n != 3; ++n)
+            {
+                neighbor_pkgs_[l][m][n] = this;
+            }
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
-template <typename DataType>
-void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::AssignPackageDataAddress<DataType>::
-operator()(DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs,
-           const Arrayi &addrs_index,
-           DataContainerAssemble<PackageData> &all_pkg_data,
-           const Arrayi &data_index)
-{
-    constexpr int type_index = DataTypeIndex<DataType>::value;
-    for (size_t l = 0; l != std::get<type_index>(all_pkg_data).size(); ++l)
-    {
-        PackageData<DataType> &pkg_data = std::get<type_index>(all_pkg_data)[l];
-        PackageDataAddress<DataType> &pkg_data_addrs = std::get<type_index>(all_pkg_data_addrs)[l];
-        pkg_data_addrs[addrs_index[0]][addrs_index[1]][addrs_index[2]] =
-            &pkg_data[data_index[0]][data_index[1]][data_index[2]];
-    }
+void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
+    assignNeighborPackage(const Arrayi &neighbor_shift, GridDataPackage *neighbor_pkg)
+{
+    neighbor_pkgs_[neighbor_shift[0] + 1][neighbor_shift[1] + 1][neighbor_shift[2] + 1] = neighbor_pkg;
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
 template <typename DataType>
 DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
-    CornerAverage(PackageDataAddress<DataType> &pkg_data_addrs, Arrayi addrs_index, Arrayi corner_direction)
+    CornerAverage(const PackageDataAccessor<DataType> &pkg_data_addrs, Arrayi addrs_index, Arrayi corner_direction)
 {
     DataType average = ZeroData<DataType>::value;
     for (int i = 0; i != 2; ++i)
@@ -145,7 +126,7 @@ DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
                 int x_index = addrs_index[0] + i * corner_direction[0];
                 int y_index = addrs_index[1] + j * corner_direction[1];
                 int z_index = addrs_index[2] + k * corner_direction[2];
-                average += *pkg_data_addrs[x_index][y_index][z_index];
+                average += pkg_data_addrs(x_index, y_index, z_index);
             }
     return average * 0.125;
 }
@@ -180,18 +161,11 @@ void MeshWithGridDataPackages<GridDataPackageType>::
     GridDataPackageType *data_pkg = data_pkg_addrs_[i][j][k];
     if (data_pkg->isInnerPackage())
     {
-        for (int l = 0; l != pkg_addrs_size; ++l)
-            for (int m = 0; m != pkg_addrs_size; ++m)
-                for (int n = 0; n != pkg_addrs_size; ++n)
+        for (int l = -1; l != 2; ++l)
+            for (int m = -1; m != 2; ++m)
+                for (int n = -1; n != 2; ++n)
                 {
-                    std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
-                    std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
-                    std::pair<int, int> z_pair = CellShiftAndDataIndex(n);
-
-                    data_pkg->assignPackageDataAddress(
-                        Arrayi(l, m, n),
-                        data_pkg_addrs_[i + x_pair.first][j + y_pair.first][k + z_pair.first],
-                        Arrayi(x_pair.second, y_pair.second, z_pair.second));
+                    data_pkg->assignNeighborPackage(Arrayi(l, m, n), data_pkg_addrs_[i + l][j + m][k + n]);
                 }
     }
 }
@@ -229,10 +203,10 @@ DataType MeshWithGridDataPackages<GridDataPackageType>::
 {
     Arrayi index = CellIndexFromPosition(position);
     GridDataPackageType *data_pkg = data_pkg_addrs_[index[0]][index[1]][index[2]];
-    auto &pkg_data_addrs = data_pkg->getPackageDataAddress(mesh_variable);
     return data_pkg->isInnerPackage() ? data_pkg->GridDataPackageType::
-                                            template probeDataPackage<DataType>(pkg_data_addrs, position)
-                                      : *pkg_data_addrs[0][0][0];
+                                            template probeDataPackage<DataType>(
+                                                data_pkg->getPackageDataAccessor(mesh_variable), position)
+                                      : data_pkg->getPackageData(mesh_variable)[0][0][0];
 }
 //=================================================================================================//
 } // namespace SPH
@@ -17,7 +17,8 @@ SPHAdaptation::SPHAdaptation(Real resolution_ref, Real h_spacing_ratio, Real sys
       h_ref_(h_spacing_ratio_ * spacing_ref_), kernel_ptr_(makeUnique<KernelWendlandC2>(h_ref_)),
       sigma0_ref_(computeLatticeNumberDensity(Vecd())),
       spacing_min_(this->MostRefinedSpacingRegular(spacing_ref_, local_refinement_level_)),
-      Vol_min_(pow(spacing_min_, Dimensions)), h_ratio_max_(spacing_ref_ / spacing_min_){};
+      Vol_min_(pow(spacing_min_, Dimensions)), h_ratio_max_(spacing_ref_ / spacing_min_),
+      use_sparse_cell_linked_list_(false){};
 //=================================================================================================//
 SPHAdaptation::SPHAdaptation(SPHBody &sph_body, Real h_spacing_ratio, Real system_refinement_ratio)
     : SPHAdaptation(sph_body.getSPHSystem().resolution_ref_, h_spacing_ratio, system_refinement_ratio){};
@@ -88,6 +89,8 @@ void SPHAdaptation::resetAdaptationRatios(Real h_spacing_ratio, Real new_system_
 UniquePtr<BaseCellLinkedList> SPHAdaptation::
     createCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body)
 {
+    if (use_sparse_cell_linked_list_)
+        return makeUnique<SparseCellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(), real_body, *this);
     return makeUnique<CellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(), real_body, *this);
 }
 //=================================================================================================//
@@ -116,6 +119,13 @@ ParticleWithLocalRefinement::
     coarsest_spacing_bound_ = spacing_ref_ - Eps;
 }
 //=================================================================================================//
+void ParticleWithLocalRefinement::setUseSparseCellLinkedList()
+{
+    std::cout << "\n Error: the multi-level cell linked list for local refinement is not sparse!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
 size_t ParticleWithLocalRefinement::getCellLinkedListTotalLevel()
 {
     return size_t(local_refinement_level_);
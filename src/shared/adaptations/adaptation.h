@@ -55,16 +55,17 @@ class BodyRegionByCell;
 class SPHAdaptation
 {
   protected:
-    Real h_spacing_ratio_;         /**< ratio of reference kernel smoothing length to particle spacing */
-    Real system_refinement_ratio_; /**< ratio of system resolution to body resolution, set to 1.0 by default */
-    int local_refinement_level_;   /**< refinement level respect to reference particle spacing */
-    Real spacing_ref_;             /**< reference particle spacing used to determine local particle spacing */
-    Real h_ref_;                   /**< reference smoothing length */
-    UniquePtr<Kernel> kernel_ptr_; /**< unique pointer of kernel function owned this class */
-    Real sigma0_ref_;              /**< Reference number density dependent on h_spacing_ratio_ and kernel function */
-    Real spacing_min_;             /**< minimum particle spacing determined by local refinement level */
-    Real Vol_min_;                 /**< minimum particle volume measure determined by local refinement level */
-    Real h_ratio_max_;             /**< the ratio between the reference smoothing length to the minimum smoothing length */
+    Real h_spacing_ratio_;             /**< ratio of reference kernel smoothing length to particle spacing */
+    Real system_refinement_ratio_;     /**< ratio of system resolution to body resolution, set to 1.0 by default */
+    int local_refinement_level_;       /**< refinement level respect to reference particle spacing */
+    Real spacing_ref_;                 /**< reference particle spacing used to determine local particle spacing */
+    Real h_ref_;                       /**< reference smoothing length */
+    UniquePtr<Kernel> kernel_ptr_;     /**< unique pointer of kernel function owned this class */
+    Real sigma0_ref_;                  /**< Reference number density dependent on h_spacing_ratio_ and kernel function */
+    Real spacing_min_;                 /**< minimum particle spacing determined by local refinement level */
+    Real Vol_min_;                     /**< minimum particle volume measure determined by local refinement level */
+    Real h_ratio_max_;                 /**< the ratio between the reference smoothing length to the minimum smoothing length */
+    bool use_sparse_cell_linked_list_; /**< only store occupied cells for large and mostly empty domains */
 
   public:
     explicit SPHAdaptation(Real resolution_ref, Real h_spacing_ratio = 1.3, Real system_refinement_ratio = 1.0);
@@ -82,6 +83,10 @@ class SPHAdaptation
     virtual Real SmoothingLengthRatio(size_t particle_index_i) { return 1.0; };
     void resetAdaptationRatios(Real h_spacing_ratio, Real new_system_refinement_ratio = 1.0);
     virtual void registerAdaptationVariables(BaseParticles &base_particles){};
+    /** to be called before the cell linked list is created, i.e. before building body relations.
+     *  Body parts by cell, periodic conditions and splitting dynamics, which require the dense cell lists,
+     *  stop with an error at their construction for a body using the sparse cell linked list. */
+    virtual void setUseSparseCellLinkedList() { use_sparse_cell_linked_list_ = true; };
 
     virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body);
     virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio);
@@ -125,6 +130,7 @@ class ParticleWithLocalRefinement : public SPHAdaptation
 
     virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body) override;
     virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio) override;
+    virtual void setUseSparseCellLinkedList() override;
 
   protected:
     Real finest_spacing_bound_;   /**< the adaptation bound for finest particles */
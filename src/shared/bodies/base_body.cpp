@@ -115,12 +115,32 @@ BaseCellLinkedList &RealBody::getCellLinkedList()
     {
         cell_linked_list_ptr_ = sph_adaptation_->createCellLinkedList(getSPHSystemBounds(), *this);
         cell_linked_list_created_ = true;
+        checkSplitCellLists();
     }
     return *cell_linked_list_ptr_.get();
 }
 //=================================================================================================//
+void RealBody::setUseSplitCellLists()
+{
+    use_split_cell_lists_ = true;
+    if (cell_linked_list_created_)
+        checkSplitCellLists();
+}
+//=================================================================================================//
+void RealBody::checkSplitCellLists()
+{
+    if (use_split_cell_lists_ && cell_linked_list_ptr_->isSparse())
+    {
+        std::cout << "\n Error: the sparse cell linked list of " << getName()
+                  << " does not support the split cell lists required by splitting dynamics!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
 void RealBody::updateCellLinkedList()
 {
+    ScopedProfiling profiling(*this, "updateCellLinkedList");
     getCellLinkedList().UpdateCellLists(*base_particles_);
     base_particles_->total_ghost_particles_ = 0;
 }
@@ -129,7 +149,9 @@ void RealBody::updateCellLinkedListWithParticleSort(size_t particle_sorting_peri
 {
     if (iteration_count_ % particle_sorting_period == 0)
     {
-        base_particles_->sortParticles(getCellLinkedList());
+        use_sorting_by_permutation_
+            ? base_particles_->sortParticlesByPermutation(getCellLinkedList())
+            : base_particles_->sortParticles(getCellLinkedList());
     }
 
     iteration_count_++;
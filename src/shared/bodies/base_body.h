@@ -207,14 +207,18 @@ class RealBody : public SPHBody
      */
     SplitCellLists split_cell_lists_;
     bool use_split_cell_lists_;
+    bool use_sorting_by_permutation_; /**< radix sort and gather particle data instead of quick sort with swaps */
     size_t iteration_count_;
     bool cell_linked_list_created_;
 
+    /** the split cell lists require the dense cell lists, which is checked at setup */
+    void checkSplitCellLists();
+
   public:
     template <typename... Args>
     RealBody(Args &&...args)
         : SPHBody(std::forward<Args>(args)...),
-          use_split_cell_lists_(false), iteration_count_(1),
+          use_split_cell_lists_(false), use_sorting_by_permutation_(false), iteration_count_(1),
           cell_linked_list_created_(false)
     {
         this->getSPHSystem().real_bodies_.push_back(this);
@@ -223,9 +227,10 @@ class RealBody : public SPHBody
     };
     virtual ~RealBody(){};
     BaseCellLinkedList &getCellLinkedList();
-    void setUseSplitCellLists() { use_split_cell_lists_ = true; };
+    void setUseSplitCellLists();
     bool getUseSplitCellLists() { return use_split_cell_lists_; };
     SplitCellLists &getSplitCellLists() { return split_cell_lists_; };
+    void setUseSortingByPermutation() { use_sorting_by_permutation_ = true; };
     void updateCellLinkedList();
     void updateCellLinkedListWithParticleSort(size_t particle_sort_period);
 };
@@ -80,6 +80,10 @@ class BaseInnerRelationInFVM : public BaseInnerRelation
     virtual ~BaseInnerRelationInFVM(){};
 
     virtual void resizeConfiguration() override;
+    virtual void setUseCompressedConfiguration() override
+    {
+        reportUnsupportedCompressedConfiguration("BaseInnerRelationInFVM");
+    };
 };
 
 /**
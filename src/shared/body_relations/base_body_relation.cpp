@@ -15,11 +15,107 @@ namespace SPH
 		return real_bodies;
 	}
 	//=================================================================================================//
+	DisplacementSinceSearch::DisplacementSinceSearch(BaseParticles &base_particles)
+		: base_particles_(base_particles), total_particles_at_search_(MaxSize_t),
+		  total_sortings_at_search_(0) {}
+	//=================================================================================================//
+	void DisplacementSinceSearch::recordPositions()
+	{
+		StdLargeVec<Vecd> &pos = base_particles_.pos_;
+		total_particles_at_search_ = base_particles_.total_real_particles_;
+		total_sortings_at_search_ = base_particles_.particle_sorting_.TotalSortings();
+		pos_at_search_.resize(total_particles_at_search_);
+		parallel_for(
+			IndexRange(0, total_particles_at_search_),
+			[&](const IndexRange &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					pos_at_search_[i] = pos[i];
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	Real DisplacementSinceSearch::MaximumDisplacement()
+	{
+		if (total_particles_at_search_ != base_particles_.total_real_particles_ ||
+			total_sortings_at_search_ != base_particles_.particle_sorting_.TotalSortings())
+			return MaxReal;
+
+		StdLargeVec<Vecd> &pos = base_particles_.pos_;
+		Real max_displacement_sqr = parallel_reduce(
+			IndexRange(0, total_particles_at_search_), Real(0),
+			[&](const IndexRange &r, Real max_value) -> Real
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					max_value = SMAX(max_value, (pos[i] - pos_at_search_[i]).squaredNorm());
+				}
+				return max_value;
+			},
+			[](Real x, Real y) -> Real
+			{ return SMAX(x, y); });
+		return std::sqrt(max_displacement_sqr);
+	}
+	//=================================================================================================//
+	template <typename LoopRange, typename GetParticleIndex>
+	BoundingBox boundingBoxInRange(StdLargeVec<Vecd> &pos, const LoopRange &loop_range,
+								   const GetParticleIndex &get_particle_index)
+	{
+		return parallel_reduce(
+			loop_range, BoundingBox(MaxReal * Vecd::Ones(), -MaxReal * Vecd::Ones()),
+			[&](const LoopRange &r, BoundingBox bounds) -> BoundingBox
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					const Vecd &position = pos[get_particle_index(n)];
+					bounds.first_ = bounds.first_.cwiseMin(position);
+					bounds.second_ = bounds.second_.cwiseMax(position);
+				}
+				return bounds;
+			},
+			[](const BoundingBox &x, const BoundingBox &y) -> BoundingBox
+			{ return BoundingBox(x.first_.cwiseMin(y.first_), x.second_.cwiseMax(y.second_)); });
+	}
+	//=================================================================================================//
+	BoundingBox ParticlesBoundingBox(StdLargeVec<Vecd> &pos, size_t total_particles)
+	{
+		return boundingBoxInRange(pos, IndexRange(0, total_particles),
+								  [](size_t n)
+								  { return n; });
+	}
+	//=================================================================================================//
+	BoundingBox ParticlesBoundingBox(StdLargeVec<Vecd> &pos, const IndexVector &particle_list)
+	{
+		return boundingBoxInRange(pos, IndexRange(0, particle_list.size()),
+								  [&](size_t n)
+								  { return particle_list[n]; });
+	}
+	//=================================================================================================//
+	bool checkBoundingBoxesOverlap(const BoundingBox &bb1, const BoundingBox &bb2, Real margin)
+	{
+		for (int i = 0; i != Dimensions; ++i)
+		{
+			if (bb1.first_[i] - margin > bb2.second_[i] || bb1.second_[i] + margin < bb2.first_[i])
+				return false;
+		}
+		return true;
+	}
+	//=================================================================================================//
 	SPHRelation::SPHRelation(SPHBody &sph_body)
 		: sph_body_(sph_body), base_particles_(sph_body.getBaseParticles()) {}
 	//=================================================================================================//
+	void SPHRelation::reportUnsupportedCompressedConfiguration(const std::string &relation_name)
+	{
+		std::cout << "\n Error: the compressed configuration is not supported by "
+				  << relation_name << " of " << sph_body_.getName() << "!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
 	BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
-		: SPHRelation(real_body), real_body_(&real_body)
+		: SPHRelation(real_body), use_compressed_configuration_(false), real_body_(&real_body)
 	{
 		subscribeToBody();
 		resizeConfiguration();
@@ -45,11 +141,17 @@ namespace SPH
 			ap);
 	}
 	//=================================================================================================//
+	void BaseInnerRelation::bindCompressedConfiguration()
+	{
+		compressed_storage_.bindConfiguration(inner_configuration_, base_particles_.total_real_particles_);
+	}
+	//=================================================================================================//
 	BaseContactRelation::BaseContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
-		: SPHRelation(sph_body), contact_bodies_(contact_sph_bodies)
+		: SPHRelation(sph_body), use_compressed_configuration_(false), contact_bodies_(contact_sph_bodies)
 	{
 		subscribeToBody();
 		contact_configuration_.resize(contact_bodies_.size());
+		compressed_storages_.resize(contact_bodies_.size());
 	}
 	//=================================================================================================//
 	void BaseContactRelation::resizeConfiguration()
@@ -61,6 +163,37 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	size_t countNeighborPairs(ParticleConfiguration &configuration, size_t total_particles)
+	{
+		return parallel_reduce(
+			IndexRange(0, total_particles), size_t(0),
+			[&](const IndexRange &r, size_t sum) -> size_t
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					sum += configuration[i].current_size_;
+				}
+				return sum;
+			},
+			[](size_t x, size_t y) -> size_t
+			{ return x + y; });
+	}
+	//=================================================================================================//
+	size_t BaseInnerRelation::TotalNeighborPairs()
+	{
+		return countNeighborPairs(inner_configuration_, base_particles_.total_real_particles_);
+	}
+	//=================================================================================================//
+	size_t BaseContactRelation::TotalNeighborPairs()
+	{
+		size_t total_neighbor_pairs = 0;
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+		{
+			total_neighbor_pairs += countNeighborPairs(contact_configuration_[k], base_particles_.total_real_particles_);
+		}
+		return total_neighbor_pairs;
+	}
+	//=================================================================================================//
 	void BaseContactRelation::resetNeighborhoodCurrentSize()
 	{
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
@@ -78,4 +211,10 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void BaseContactRelation::bindCompressedConfiguration(size_t contact_body_index)
+	{
+		compressed_storages_[contact_body_index].bindConfiguration(
+			contact_configuration_[contact_body_index], base_particles_.total_real_particles_);
+	}
+	//=================================================================================================//
 }
@@ -35,6 +35,7 @@
 #include "base_particles.h"
 #include "cell_linked_list.h"
 #include "neighborhood.h"
+#include "profiling_registry.h"
 
 namespace SPH
 {
@@ -96,6 +97,45 @@ struct SearchDepthAdaptiveContact
     };
 };
 
+/** @brief a small functor for obtaining search depth for a given search radius, e.g. with a skin
+ */
+struct SearchDepthByRadius
+{
+    int search_depth_;
+    SearchDepthByRadius(Real search_radius, CellLinkedList *target_cell_linked_list)
+        : search_depth_(1 + (int)floor(search_radius / target_cell_linked_list->GridSpacing())){};
+    int operator()(size_t particle_index) const { return search_depth_; };
+};
+
+/**
+ * @class DisplacementSinceSearch
+ * @brief Records the particle positions at a neighbor search and gives the maximum displacement since then.
+ * 		  If the particles have been sorted or their number changed, the displacement is taken as infinite,
+ * 		  as the cached neighbor indexes are no longer valid.
+ */
+class DisplacementSinceSearch
+{
+  protected:
+    BaseParticles &base_particles_;
+    StdLargeVec<Vecd> pos_at_search_;
+    size_t total_particles_at_search_;
+    size_t total_sortings_at_search_;
+
+  public:
+    explicit DisplacementSinceSearch(BaseParticles &base_particles);
+    virtual ~DisplacementSinceSearch(){};
+
+    void recordPositions();
+    Real MaximumDisplacement();
+};
+
+/** Bounding box of the first total_particles particles. An empty box has its lower bound above the upper bound. */
+BoundingBox ParticlesBoundingBox(StdLargeVec<Vecd> &pos, size_t total_particles);
+/** Bounding box of the particles in the given list. */
+BoundingBox ParticlesBoundingBox(StdLargeVec<Vecd> &pos, const IndexVector &particle_list);
+/** Check whether two bounding boxes overlap after the first is extended by a margin in each direction. */
+bool checkBoundingBoxesOverlap(const BoundingBox &bb1, const BoundingBox &bb2, Real margin);
+
 /** Transfer body parts to real bodies. **/
 RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts);
 
@@ -107,6 +147,8 @@ class SPHRelation
 {
   protected:
     SPHBody &sph_body_;
+    /** for the relations which build their configurations only in the neighborhoods */
+    void reportUnsupportedCompressedConfiguration(const std::string &relation_name);
 
   public:
     BaseParticles &base_particles_;
@@ -126,7 +168,11 @@ class SPHRelation
 class BaseInnerRelation : public SPHRelation
 {
   protected:
+    bool use_compressed_configuration_;
+    CompressedNeighborStorage compressed_storage_;
     virtual void resetNeighborhoodCurrentSize();
+    /** bind the counted neighborhoods to the compressed storage */
+    void bindCompressedConfiguration();
 
   public:
     RealBody *real_body_;
@@ -135,6 +181,10 @@ class BaseInnerRelation : public SPHRelation
     virtual ~BaseInnerRelation(){};
     BaseInnerRelation &getRelation() { return *this; };
     virtual void resizeConfiguration() override;
+    /** save the neighbor data of all particles contiguously, instead of in each neighborhood */
+    virtual void setUseCompressedConfiguration() { use_compressed_configuration_ = true; };
+    /** the total number of neighbor pairs in the configuration */
+    size_t TotalNeighborPairs();
 };
 
 /**
@@ -144,7 +194,11 @@ class BaseInnerRelation : public SPHRelation
 class BaseContactRelation : public SPHRelation
 {
   protected:
+    bool use_compressed_configuration_;
+    StdVec<CompressedNeighborStorage> compressed_storages_;
     virtual void resetNeighborhoodCurrentSize();
+    /** bind the counted neighborhoods of a contact body to the compressed storage */
+    void bindCompressedConfiguration(size_t contact_body_index);
 
   public:
     RealBodyVector contact_bodies_;
@@ -155,8 +209,12 @@ class BaseContactRelation : public SPHRelation
         : BaseContactRelation(sph_body, BodyPartsToRealBodies(contact_body_parts)){};
     virtual ~BaseContactRelation(){};
     BaseContactRelation &getRelation() { return *this; };
+    /** the total number of neighbor pairs with all contact bodies */
+    size_t TotalNeighborPairs();
 
     virtual void resizeConfiguration() override;
+    /** save the neighbor data of all particles contiguously, instead of in each neighborhood */
+    virtual void setUseCompressedConfiguration() { use_compressed_configuration_ = true; };
 };
 } // namespace SPH
 #endif // BASE_BODY_RELATION_H
\ No newline at end of file
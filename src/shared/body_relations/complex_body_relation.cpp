@@ -43,6 +43,7 @@ void ComplexRelation::resizeConfiguration()
 //=================================================================================================//
 void ComplexRelation::updateConfiguration()
 {
+    // profiled by the inner and contact relations, so that the time is not counted twice
     inner_relation_.updateConfiguration();
     for (size_t k = 0; k != contact_relations_.size(); ++k)
         contact_relations_[k]->updateConfiguration();
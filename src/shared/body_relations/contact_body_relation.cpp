@@ -5,8 +5,22 @@
 namespace SPH
 {
 //=================================================================================================//
+BoundingBox ContactRelationCrossResolution::ContactBoundingBox(size_t contact_body_index)
+{
+    BaseParticles &contact_particles = contact_bodies_[contact_body_index]->getBaseParticles();
+    return ParticlesBoundingBox(contact_particles.pos_, contact_particles.total_real_particles_);
+}
+//=================================================================================================//
+bool ContactRelationCrossResolution::
+    isContactSearchNeeded(size_t contact_body_index, const BoundingBox &source_bounds, Real margin)
+{
+    return !use_broad_phase_ ||
+           checkBoundingBoxesOverlap(source_bounds, ContactBoundingBox(contact_body_index), margin);
+}
+//=================================================================================================//
 ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
-    : ContactRelationCrossResolution(sph_body, contact_bodies)
+    : ContactRelationCrossResolution(sph_body, contact_bodies), skin_width_(0.0),
+      displacement_since_search_(base_particles_)
 {
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -16,15 +30,124 @@ ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodie
     }
 }
 //=================================================================================================//
+void ContactRelation::setUseNeighborSkin(Real skin_width)
+{
+    skin_width_ = skin_width;
+    get_candidate_search_depths_.clear();
+    get_neighbor_candidates_.clear();
+    contact_displacements_since_search_.clear();
+    candidate_configurations_.resize(contact_bodies_.size());
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        Real search_radius = get_contact_neighbors_[k]->CutOffRadius() + skin_width_;
+        get_candidate_search_depths_.push_back(SearchDepthByRadius(search_radius, target_cell_linked_lists_[k]));
+        get_neighbor_candidates_.push_back(
+            NeighborBuilderCandidate(search_radius, contact_bodies_[k]->getBaseParticles().pos_));
+        target_cell_linked_lists_[k]->setNeighborSkinWidth(skin_width_);
+        contact_displacements_since_search_.push_back(
+            displacement_ptrs_keeper_.createPtr<DisplacementSinceSearch>(contact_bodies_[k]->getBaseParticles()));
+    }
+}
+//=================================================================================================//
+void ContactRelation::updateNeighborCandidates()
+{
+    // ghost particles are re-inserted with new indexes at each update of the cell linked list
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        if (contact_bodies_[k]->getBaseParticles().total_ghost_particles_ != 0)
+        {
+            std::cout << "\n Error: the neighbor skin of " << sph_body_.getName()
+                      << " does not support the ghost particles of " << contact_bodies_[k]->getName() << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+
+    Real max_contact_displacement = 0.0;
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        max_contact_displacement =
+            SMAX(max_contact_displacement, contact_displacements_since_search_[k]->MaximumDisplacement());
+    }
+    if (displacement_since_search_.MaximumDisplacement() + max_contact_displacement <= skin_width_)
+        return;
+
+    BoundingBox source_bounds = ParticlesBoundingBox(base_particles_.pos_, base_particles_.total_real_particles_);
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        ParticleConfiguration &candidate_configuration = candidate_configurations_[k];
+        candidate_configuration.resize(contact_configuration_[k].size(), Neighborhood());
+        particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                     [&](size_t index_i)
+                     { candidate_configuration[index_i].current_size_ = 0; });
+        Real candidate_margin = SearchRangeInTargetCells(get_candidate_search_depths_[k].search_depth_, k);
+        if (isContactSearchNeeded(k, source_bounds, candidate_margin))
+        {
+            target_cell_linked_lists_[k]->searchNeighborsByParticles(
+                sph_body_, candidate_configuration,
+                get_candidate_search_depths_[k], get_neighbor_candidates_[k]);
+        }
+        contact_displacements_since_search_[k]->recordPositions();
+    }
+    displacement_since_search_.recordPositions();
+}
+//=================================================================================================//
+void ContactRelation::searchNeighbors(size_t contact_body_index)
+{
+    size_t k = contact_body_index;
+    if (skin_width_ > 0.0)
+    {
+        StdLargeVec<Vecd> &pos = base_particles_.pos_;
+        StdLargeVec<Vecd> &contact_pos = contact_bodies_[k]->getBaseParticles().pos_;
+        StdLargeVec<Real> &contact_Vol = contact_bodies_[k]->getBaseParticles().Vol_;
+        NeighborBuilderContact &get_contact_neighbor = *get_contact_neighbors_[k];
+        particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                     [&](size_t index_i)
+                     {
+                         Neighborhood &candidates = candidate_configurations_[k][index_i];
+                         Neighborhood &neighborhood = contact_configuration_[k][index_i];
+                         for (size_t n = 0; n != candidates.current_size_; ++n)
+                         {
+                             size_t index_j = candidates.j_[n];
+                             get_contact_neighbor(neighborhood, pos[index_i], index_i,
+                                                  ListData(index_j, contact_pos[index_j] + candidates.e_ij_[n], contact_Vol[index_j]));
+                         }
+                     });
+        return;
+    }
+
+    target_cell_linked_lists_[k]->searchNeighborsByParticles(
+        sph_body_, contact_configuration_[k],
+        *get_search_depths_[k], *get_contact_neighbors_[k]);
+}
+//=================================================================================================//
 void ContactRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
+    if (skin_width_ > 0.0)
+        updateNeighborCandidates();
+
     resetNeighborhoodCurrentSize();
+    BoundingBox source_bounds = use_broad_phase_ && skin_width_ <= 0.0
+                                    ? ParticlesBoundingBox(base_particles_.pos_, base_particles_.total_real_particles_)
+                                    : BoundingBox();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            sph_body_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
+        // with neighbor skin, the broad phase is applied when the candidates are searched
+        if (skin_width_ <= 0.0 && !isContactSearchNeeded(k, source_bounds, broad_phase_margins_[k]))
+            continue;
+
+        if (use_compressed_configuration_)
+        {
+            get_contact_neighbors_[k]->setCountOnly(true);
+            searchNeighbors(k);
+            get_contact_neighbors_[k]->setCountOnly(false);
+            bindCompressedConfiguration(k);
+        }
+        searchNeighbors(k);
     }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 SurfaceContactRelation::SurfaceContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
@@ -54,18 +177,28 @@ void SurfaceContactRelation::resetNeighborhoodCurrentSize()
 //=================================================================================================//
 void SurfaceContactRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
+    BoundingBox source_bounds = use_broad_phase_
+                                    ? ParticlesBoundingBox(base_particles_.pos_, body_part_particles_)
+                                    : BoundingBox();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            *body_surface_layer_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
+        if (isContactSearchNeeded(k, source_bounds, broad_phase_margins_[k]))
+        {
+            target_cell_linked_lists_[k]->searchNeighborsByParticles(
+                *body_surface_layer_, contact_configuration_[k],
+                *get_search_depths_[k], *get_contact_neighbors_[k]);
+        }
     }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 ContactRelationToBodyPart::
-    ContactRelationToBodyPart(SPHBody &sph_body, BodyPartVector contact_body_parts_)
-    : ContactRelationCrossResolution(sph_body, contact_body_parts_)
+    ContactRelationToBodyPart(SPHBody &sph_body, BodyPartVector contact_body_parts)
+    : ContactRelationCrossResolution(sph_body, contact_body_parts),
+      contact_body_parts_(contact_body_parts)
 {
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -77,13 +210,43 @@ ContactRelationToBodyPart::
 //=================================================================================================//
 void ContactRelationToBodyPart::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
+    BoundingBox source_bounds = use_broad_phase_
+                                    ? ParticlesBoundingBox(base_particles_.pos_, base_particles_.total_real_particles_)
+                                    : BoundingBox();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        if (!isContactSearchNeeded(k, source_bounds, broad_phase_margins_[k]))
+            continue;
+
+        if (use_compressed_configuration_)
+        {
+            get_part_contact_neighbors_[k]->setCountOnly(true);
+            target_cell_linked_lists_[k]->searchNeighborsByParticles(
+                sph_body_, contact_configuration_[k],
+                *get_search_depths_[k], *get_part_contact_neighbors_[k]);
+            get_part_contact_neighbors_[k]->setCountOnly(false);
+            bindCompressedConfiguration(k);
+        }
         target_cell_linked_lists_[k]->searchNeighborsByParticles(
             sph_body_, contact_configuration_[k],
             *get_search_depths_[k], *get_part_contact_neighbors_[k]);
     }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
+}
+//=================================================================================================//
+BoundingBox ContactRelationToBodyPart::ContactBoundingBox(size_t contact_body_index)
+{
+    BodyPartByParticle *body_part_by_particle =
+        dynamic_cast<BodyPartByParticle *>(contact_body_parts_[contact_body_index]);
+    if (body_part_by_particle != nullptr)
+    {
+        BaseParticles &contact_particles = body_part_by_particle->getBaseParticles();
+        return ParticlesBoundingBox(contact_particles.pos_, body_part_by_particle->body_part_particles_);
+    }
+    return ContactRelationCrossResolution::ContactBoundingBox(contact_body_index);
 }
 //=================================================================================================//
 AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
@@ -115,9 +278,22 @@ AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVect
 //=================================================================================================//
 void AdaptiveContactRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        if (use_compressed_configuration_)
+        {
+            for (size_t l = 0; l != cell_linked_list_levels_[k].size(); ++l)
+            {
+                get_contact_neighbors_adaptive_[k][l]->setCountOnly(true);
+                cell_linked_list_levels_[k][l]->searchNeighborsByParticles(
+                    sph_body_, contact_configuration_[k],
+                    *get_multi_level_search_range_[k][l], *get_contact_neighbors_adaptive_[k][l]);
+                get_contact_neighbors_adaptive_[k][l]->setCountOnly(false);
+            }
+            bindCompressedConfiguration(k);
+        }
         for (size_t l = 0; l != cell_linked_list_levels_[k].size(); ++l)
         {
             cell_linked_list_levels_[k][l]->searchNeighborsByParticles(
@@ -125,6 +301,8 @@ void AdaptiveContactRelation::updateConfiguration()
                 *get_multi_level_search_range_[k][l], *get_contact_neighbors_adaptive_[k][l]);
         }
     }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 } // namespace SPH
@@ -48,7 +48,7 @@ class ContactRelationCrossResolution : public BaseContactRelation
   public:
     template <typename... Args>
     ContactRelationCrossResolution(SPHBody &sph_body, Args &&...args)
-        : BaseContactRelation(sph_body, std::forward<Args>(args)...)
+        : BaseContactRelation(sph_body, std::forward<Args>(args)...), use_broad_phase_(false)
     {
         for (size_t k = 0; k != contact_bodies_.size(); ++k)
         {
@@ -58,14 +58,31 @@ class ContactRelationCrossResolution : public BaseContactRelation
             get_search_depths_.push_back(
                 search_depth_ptrs_keeper_.createPtr<SearchDepthContact>(
                     sph_body_, target_cell_linked_list));
+            broad_phase_margins_.push_back(
+                SearchRangeInTargetCells(get_search_depths_.back()->search_depth_, k));
         }
         resizeConfiguration();
     };
     virtual ~ContactRelationCrossResolution(){};
+    /** The search with a contact body is skipped if the bounding boxes
+     *  of the searching and the contact particles are farther apart than the search range. */
+    void setUseBroadPhase() { use_broad_phase_ = true; };
 
   protected:
     StdVec<CellLinkedList *> target_cell_linked_lists_;
     StdVec<SearchDepthContact *> get_search_depths_;
+    bool use_broad_phase_;
+    StdVec<Real> broad_phase_margins_; /**< the farthest distance in each direction at which a contact neighbor can be found */
+
+    /** the distance in each direction covered by a search with the given depth in the target cell linked list */
+    Real SearchRangeInTargetCells(int search_depth, size_t contact_body_index)
+    {
+        return Real(search_depth + 1) * target_cell_linked_lists_[contact_body_index]->GridSpacing();
+    };
+    /** the bounding box of the particles which may be found as contact neighbors */
+    virtual BoundingBox ContactBoundingBox(size_t contact_body_index);
+    /** broad phase: whether the search with a contact body may find any neighbor */
+    bool isContactSearchNeeded(size_t contact_body_index, const BoundingBox &source_bounds, Real margin);
 };
 
 /**
@@ -76,14 +93,50 @@ class ContactRelation : public ContactRelationCrossResolution
 {
   protected:
     UniquePtrsKeeper<NeighborBuilderContact> neighbor_builder_contact_ptrs_keeper_;
+    UniquePtrsKeeper<DisplacementSinceSearch> displacement_ptrs_keeper_;
 
   public:
     ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies);
     virtual ~ContactRelation(){};
     virtual void updateConfiguration() override;
+    /** use Verlet lists, for which the neighbor candidates are only searched again
+     * when the maximum particle displacements of the two bodies together exceed the skin width */
+    void setUseNeighborSkin(Real skin_width);
 
   protected:
     StdVec<NeighborBuilderContact *> get_contact_neighbors_;
+    /** for Verlet lists, the neighbor candidates within the cutoff radius extended by the skin */
+    Real skin_width_;
+    StdVec<SearchDepthByRadius> get_candidate_search_depths_;
+    StdVec<NeighborBuilderCandidate> get_neighbor_candidates_;
+    StdVec<ParticleConfiguration> candidate_configurations_;
+    DisplacementSinceSearch displacement_since_search_;
+    StdVec<DisplacementSinceSearch *> contact_displacements_since_search_;
+
+    /** search the candidates again if particles may have moved into the cutoff radius */
+    void updateNeighborCandidates();
+    /** build the neighbors from the cell linked list or from the candidates */
+    void searchNeighbors(size_t contact_body_index);
+};
+
+/**
+ * @class ContactRelationWithKernel
+ * @brief The contact relation with the kernel type as template parameter,
+ * 		  so that the neighbor data are built without virtual kernel calls.
+ * 		  The kernel chosen for each contact body, i.e. the one with the larger smoothing length,
+ * 		  should be exactly of the kernel type, which is checked at construction.
+ */
+template <class KernelType>
+class ContactRelationWithKernel : public ContactRelationCrossResolution
+{
+  protected:
+    UniquePtrsKeeper<NeighborBuilderContactWithKernel<KernelType>> neighbor_builder_contact_ptrs_keeper_;
+    StdVec<NeighborBuilderContactWithKernel<KernelType> *> get_contact_neighbors_;
+
+  public:
+    ContactRelationWithKernel(SPHBody &sph_body, RealBodyVector contact_bodies);
+    virtual ~ContactRelationWithKernel(){};
+    virtual void updateConfiguration() override;
 };
 
 /**
@@ -105,6 +158,10 @@ class SurfaceContactRelation : public ContactRelationCrossResolution
         : SurfaceContactRelation(*solid_body_relation_self_contact.real_body_, contact_bodies){};
     virtual ~SurfaceContactRelation(){};
     virtual void updateConfiguration() override;
+    virtual void setUseCompressedConfiguration() override
+    {
+        reportUnsupportedCompressedConfiguration("SurfaceContactRelation");
+    };
 
   protected:
     IndexVector &body_part_particles_;
@@ -123,12 +180,16 @@ class ContactRelationToBodyPart : public ContactRelationCrossResolution
     UniquePtrsKeeper<NeighborBuilderContactBodyPart> neighbor_builder_contact_ptrs_keeper_;
 
   public:
+    BodyPartVector contact_body_parts_;
     StdVec<NeighborBuilderContactBodyPart *> get_part_contact_neighbors_;
 
-    ContactRelationToBodyPart(SPHBody &sph_body, BodyPartVector contact_body_parts_);
+    ContactRelationToBodyPart(SPHBody &sph_body, BodyPartVector contact_body_parts);
     virtual ~ContactRelationToBodyPart(){};
 
     virtual void updateConfiguration() override;
+
+  protected:
+    virtual BoundingBox ContactBoundingBox(size_t contact_body_index) override;
 };
 
 /**
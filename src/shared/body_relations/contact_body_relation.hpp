@@ -0,0 +1,61 @@
+/**
+ * @file 	contact_body_relation.hpp
+ * @brief 	This is the implementation of the template classes in contact_body_relation.h
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef CONTACT_BODY_RELATION_HPP
+#define CONTACT_BODY_RELATION_HPP
+
+#include "contact_body_relation.h"
+#include "cell_linked_list.hpp"
+
+//=====================================================================================================//
+namespace SPH
+{
+//=================================================================================================//
+template <class KernelType>
+ContactRelationWithKernel<KernelType>::
+    ContactRelationWithKernel(SPHBody &sph_body, RealBodyVector contact_bodies)
+    : ContactRelationCrossResolution(sph_body, contact_bodies)
+{
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        get_contact_neighbors_.push_back(
+            neighbor_builder_contact_ptrs_keeper_.template createPtr<NeighborBuilderContactWithKernel<KernelType>>(
+                sph_body_, *contact_bodies_[k]));
+    }
+}
+//=================================================================================================//
+template <class KernelType>
+void ContactRelationWithKernel<KernelType>::updateConfiguration()
+{
+    ScopedProfiling profiling(sph_body_, typeid(*this));
+    resetNeighborhoodCurrentSize();
+    BoundingBox source_bounds = use_broad_phase_
+                                    ? ParticlesBoundingBox(base_particles_.pos_, base_particles_.total_real_particles_)
+                                    : BoundingBox();
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        if (!isContactSearchNeeded(k, source_bounds, broad_phase_margins_[k]))
+            continue;
+
+        if (use_compressed_configuration_)
+        {
+            get_contact_neighbors_[k]->setCountOnly(true);
+            target_cell_linked_lists_[k]->searchNeighborsByParticles(
+                sph_body_, contact_configuration_[k],
+                *get_search_depths_[k], *get_contact_neighbors_[k]);
+            get_contact_neighbors_[k]->setCountOnly(false);
+            bindCompressedConfiguration(k);
+        }
+        target_cell_linked_lists_[k]->searchNeighborsByParticles(
+            sph_body_, contact_configuration_[k],
+            *get_search_depths_[k], *get_contact_neighbors_[k]);
+    }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // CONTACT_BODY_RELATION_HPP
@@ -9,14 +9,200 @@ namespace SPH
 //=================================================================================================//
 InnerRelation::InnerRelation(RealBody &real_body)
     : BaseInnerRelation(real_body), get_inner_neighbor_(real_body),
-      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())),
+      skin_width_(0.0), get_candidate_search_depth_(get_inner_neighbor_.CutOffRadius(), &cell_linked_list_),
+      get_neighbor_candidate_(get_inner_neighbor_.CutOffRadius(), base_particles_.pos_),
+      displacement_since_search_(base_particles_) {}
+//=================================================================================================//
+void InnerRelation::setUseNeighborSkin(Real skin_width)
+{
+    skin_width_ = skin_width;
+    Real search_radius = get_inner_neighbor_.CutOffRadius() + skin_width_;
+    get_candidate_search_depth_ = SearchDepthByRadius(search_radius, &cell_linked_list_);
+    get_neighbor_candidate_ = NeighborBuilderCandidate(search_radius, base_particles_.pos_);
+    cell_linked_list_.setNeighborSkinWidth(skin_width_);
+}
+//=================================================================================================//
+void InnerRelation::updateNeighborCandidates()
+{
+    // ghost particles are re-inserted with new indexes at each update of the cell linked list
+    if (base_particles_.total_ghost_particles_ != 0)
+    {
+        std::cout << "\n Error: the neighbor skin of " << sph_body_.getName()
+                  << " does not support ghost particles!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    // two particles moving toward each other by half of the skin width may become neighbors
+    if (2.0 * displacement_since_search_.MaximumDisplacement() <= skin_width_)
+        return;
+
+    candidate_configuration_.resize(inner_configuration_.size(), Neighborhood());
+    particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                 [&](size_t index_i)
+                 { candidate_configuration_[index_i].current_size_ = 0; });
+    cell_linked_list_.searchNeighborsByParticles(
+        sph_body_, candidate_configuration_,
+        get_candidate_search_depth_, get_neighbor_candidate_);
+    displacement_since_search_.recordPositions();
+}
+//=================================================================================================//
+void InnerRelation::searchNeighbors()
+{
+    if (skin_width_ > 0.0)
+    {
+        StdLargeVec<Vecd> &pos = base_particles_.pos_;
+        StdLargeVec<Real> &Vol = base_particles_.Vol_;
+        particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                     [&](size_t index_i)
+                     {
+                         Neighborhood &candidates = candidate_configuration_[index_i];
+                         Neighborhood &neighborhood = inner_configuration_[index_i];
+                         for (size_t n = 0; n != candidates.current_size_; ++n)
+                         {
+                             size_t index_j = candidates.j_[n];
+                             get_inner_neighbor_(neighborhood, pos[index_i], index_i,
+                                                 ListData(index_j, pos[index_j] + candidates.e_ij_[n], Vol[index_j]));
+                         }
+                     });
+        return;
+    }
+
+    cell_linked_list_.searchNeighborsByParticles(
+        sph_body_, inner_configuration_,
+        get_single_search_depth_, get_inner_neighbor_);
+}
 //=================================================================================================//
 void InnerRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
+    if (skin_width_ > 0.0)
+        updateNeighborCandidates();
+
+    resetNeighborhoodCurrentSize();
+    if (use_compressed_configuration_)
+    {
+        get_inner_neighbor_.setCountOnly(true);
+        searchNeighbors();
+        get_inner_neighbor_.setCountOnly(false);
+        bindCompressedConfiguration();
+    }
+    searchNeighbors();
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
+}
+//=================================================================================================//
+ReferenceInnerRelation::ReferenceInnerRelation(RealBody &real_body)
+    : InnerRelation(real_body), is_configuration_built_(false),
+      total_particles_at_build_(0), total_sortings_at_build_(0)
+{
+    setUseCompressedConfiguration();
+}
+//=================================================================================================//
+void ReferenceInnerRelation::sortNeighborsByIndex()
+{
+    particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                 [&](size_t index_i)
+                 {
+                     Neighborhood &neighborhood = inner_configuration_[index_i];
+                     size_t total_neighbors = neighborhood.current_size_;
+                     // scratch buffer reused by all particles handled by this thread
+                     thread_local StdVec<size_t> sequence;
+                     sequence.resize(total_neighbors);
+                     for (size_t n = 0; n != total_neighbors; ++n)
+                         sequence[n] = n;
+                     std::sort(sequence.begin(), sequence.end(),
+                               [&](size_t a, size_t b)
+                               { return neighborhood.j_[a] < neighborhood.j_[b]; });
+
+                     // the neighbor data are permuted in place cycle by cycle,
+                     // a position is marked as done by setting its sequence to itself
+                     for (size_t start = 0; start != total_neighbors; ++start)
+                     {
+                         if (sequence[start] == start)
+                             continue;
+
+                         size_t j = neighborhood.j_[start];
+                         Real W_ij = neighborhood.W_ij_[start];
+                         Real dW_ijV_j = neighborhood.dW_ijV_j_[start];
+                         Real r_ij = neighborhood.r_ij_[start];
+                         Vecd e_ij = neighborhood.e_ij_[start];
+                         size_t n = start;
+                         while (sequence[n] != start)
+                         {
+                             size_t m = sequence[n];
+                             neighborhood.j_[n] = neighborhood.j_[m];
+                             neighborhood.W_ij_[n] = neighborhood.W_ij_[m];
+                             neighborhood.dW_ijV_j_[n] = neighborhood.dW_ijV_j_[m];
+                             neighborhood.r_ij_[n] = neighborhood.r_ij_[m];
+                             neighborhood.e_ij_[n] = neighborhood.e_ij_[m];
+                             sequence[n] = n;
+                             n = m;
+                         }
+                         neighborhood.j_[n] = j;
+                         neighborhood.W_ij_[n] = W_ij;
+                         neighborhood.dW_ijV_j_[n] = dW_ijV_j;
+                         neighborhood.r_ij_[n] = r_ij;
+                         neighborhood.e_ij_[n] = e_ij;
+                         sequence[n] = n;
+                     }
+                 });
+}
+//=================================================================================================//
+void ReferenceInnerRelation::updateConfiguration()
+{
+    if (is_configuration_built_)
+    {
+        if (total_particles_at_build_ != base_particles_.total_real_particles_ ||
+            total_sortings_at_build_ != base_particles_.particle_sorting_.TotalSortings())
+        {
+            std::cout << "\n Error: the particles of " << sph_body_.getName()
+                      << " are sorted or changed after the reference configuration is built!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        return;
+    }
+
+    InnerRelation::updateConfiguration();
+    sortNeighborsByIndex();
+    total_particles_at_build_ = base_particles_.total_real_particles_;
+    total_sortings_at_build_ = base_particles_.particle_sorting_.TotalSortings();
+    is_configuration_built_ = true;
+}
+//=================================================================================================//
+HalfInnerRelation::HalfInnerRelation(RealBody &real_body)
+    : BaseInnerRelation(real_body), get_half_inner_neighbor_(real_body),
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList()))
+{
+    if (get_half_inner_neighbor_.CutOffRadius() > (1.0 + SqrtEps) * cell_linked_list_.GridSpacing())
+    {
+        std::cout << "\n Error: the cut-off radius of " << sph_body_.getName()
+                  << " is larger than the cell spacing, which is not supported by the half inner relation!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void HalfInnerRelation::updateConfiguration()
+{
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
+    if (use_compressed_configuration_)
+    {
+        get_half_inner_neighbor_.setCountOnly(true);
+        cell_linked_list_.searchNeighborsByParticles(
+            sph_body_, inner_configuration_,
+            get_single_search_depth_, get_half_inner_neighbor_);
+        get_half_inner_neighbor_.setCountOnly(false);
+        bindCompressedConfiguration();
+    }
     cell_linked_list_.searchNeighborsByParticles(
         sph_body_, inner_configuration_,
-        get_single_search_depth_, get_inner_neighbor_);
+        get_single_search_depth_, get_half_inner_neighbor_);
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 AdaptiveInnerRelation::
@@ -38,13 +224,28 @@ AdaptiveInnerRelation::
 //=================================================================================================//
 void AdaptiveInnerRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
+    if (use_compressed_configuration_)
+    {
+        get_adaptive_inner_neighbor_.setCountOnly(true);
+        for (size_t l = 0; l != total_levels_; ++l)
+        {
+            cell_linked_list_levels_[l]->searchNeighborsByParticles(
+                sph_body_, inner_configuration_,
+                *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor_);
+        }
+        get_adaptive_inner_neighbor_.setCountOnly(false);
+        bindCompressedConfiguration();
+    }
     for (size_t l = 0; l != total_levels_; ++l)
     {
         cell_linked_list_levels_[l]->searchNeighborsByParticles(
             sph_body_, inner_configuration_,
             *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor_);
     }
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 SelfSurfaceContactRelation::
@@ -66,10 +267,13 @@ void SelfSurfaceContactRelation::resetNeighborhoodCurrentSize()
 //=================================================================================================//
 void SelfSurfaceContactRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         body_surface_layer_, inner_configuration_,
         get_single_search_depth_, get_self_contact_neighbor_);
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
 }
 //=================================================================================================//
 TreeInnerRelation::TreeInnerRelation(RealBody &real_body)
@@ -78,7 +282,18 @@ TreeInnerRelation::TreeInnerRelation(RealBody &real_body)
 //=================================================================================================//
 void TreeInnerRelation::updateConfiguration()
 {
+    ScopedProfiling profiling(sph_body_, typeid(*this));
     generative_tree_.buildParticleConfiguration(inner_configuration_);
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
+}
+//=================================================================================================//
+void TreeInnerRelation::setUseNeighborSkin(Real skin_width)
+{
+    std::cout << "\n Error: TreeInnerRelation of " << sph_body_.getName()
+              << " does not support the neighbor skin!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
 }
 //=================================================================================================//
 } // namespace SPH
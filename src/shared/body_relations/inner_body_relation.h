@@ -43,11 +43,95 @@ class InnerRelation : public BaseInnerRelation
     SearchDepthSingleResolution get_single_search_depth_;
     NeighborBuilderInner get_inner_neighbor_;
     CellLinkedList &cell_linked_list_;
+    /** for Verlet lists, the neighbor candidates within the cutoff radius extended by the skin */
+    Real skin_width_;
+    SearchDepthByRadius get_candidate_search_depth_;
+    NeighborBuilderCandidate get_neighbor_candidate_;
+    ParticleConfiguration candidate_configuration_;
+    DisplacementSinceSearch displacement_since_search_;
+
+    /** search the candidates again if particles may have moved into the cutoff radius */
+    void updateNeighborCandidates();
+    /** build the neighbors from the cell linked list or from the candidates */
+    void searchNeighbors();
 
   public:
     explicit InnerRelation(RealBody &real_body);
     virtual ~InnerRelation(){};
 
+    virtual void updateConfiguration() override;
+    /** use Verlet lists, for which the neighbor candidates are only searched again
+     * when the maximum particle displacement exceeds half of the skin width */
+    virtual void setUseNeighborSkin(Real skin_width);
+};
+
+/**
+ * @class ReferenceInnerRelation
+ * @brief The inner relation with frozen topology for total Lagrangian formulations,
+ * 		  in which the neighbors and their kernel data are those of the reference configuration.
+ * 		  The configuration is built by the first updateConfiguration in compressed storage,
+ * 		  with the neighbors of each particle sorted by their indexes, and is not changed afterwards.
+ * 		  Note that the particles should not be sorted or added after the configuration is built.
+ */
+class ReferenceInnerRelation : public InnerRelation
+{
+  protected:
+    bool is_configuration_built_;
+    size_t total_particles_at_build_;
+    size_t total_sortings_at_build_;
+
+    void sortNeighborsByIndex();
+
+  public:
+    explicit ReferenceInnerRelation(RealBody &real_body);
+    virtual ~ReferenceInnerRelation(){};
+
+    virtual void updateConfiguration() override;
+    /** build the configuration again at the next update, e.g. for a new reference configuration */
+    void resetReferenceConfiguration() { is_configuration_built_ = false; };
+};
+
+/**
+ * @class HalfInnerRelation
+ * @brief The inner relation in which each pair of neighboring particles is saved once,
+ * 		  in the neighborhood of the particle with the smaller index.
+ * 		  It is used with InteractionPairSymmetric, in which the pair contribution
+ * 		  is added to both particles. As the particles are swept by the colors of the split cell lists,
+ * 		  the neighbors should be in the adjacent cells, i.e. the search depth is one.
+ */
+class HalfInnerRelation : public BaseInnerRelation
+{
+  protected:
+    SearchDepthSingleResolution get_single_search_depth_;
+    NeighborBuilderInnerHalf get_half_inner_neighbor_;
+    CellLinkedList &cell_linked_list_;
+
+  public:
+    explicit HalfInnerRelation(RealBody &real_body);
+    virtual ~HalfInnerRelation(){};
+
+    virtual void updateConfiguration() override;
+};
+
+/**
+ * @class InnerRelationWithKernel
+ * @brief The inner relation with the kernel type of the body as template parameter,
+ * 		  so that the neighbor data are built without virtual kernel calls.
+ * 		  The kernel type should be the one given by SPHAdaptation, i.e. KernelWendlandC2 by default
+ * 		  or the one set by SPHAdaptation::resetKernel<KernelType>, which is checked at construction.
+ */
+template <class KernelType>
+class InnerRelationWithKernel : public BaseInnerRelation
+{
+  protected:
+    SearchDepthSingleResolution get_single_search_depth_;
+    NeighborBuilderInnerWithKernel<KernelType> get_inner_neighbor_;
+    CellLinkedList &cell_linked_list_;
+
+  public:
+    explicit InnerRelationWithKernel(RealBody &real_body);
+    virtual ~InnerRelationWithKernel(){};
+
     virtual void updateConfiguration() override;
 };
 
@@ -85,6 +169,10 @@ class SelfSurfaceContactRelation : public BaseInnerRelation
     explicit SelfSurfaceContactRelation(RealBody &real_body);
     virtual ~SelfSurfaceContactRelation(){};
     virtual void updateConfiguration() override;
+    virtual void setUseCompressedConfiguration() override
+    {
+        reportUnsupportedCompressedConfiguration("SelfSurfaceContactRelation");
+    };
 
   protected:
     IndexVector &body_part_particles_;
@@ -110,6 +198,12 @@ class TreeInnerRelation : public InnerRelation
     virtual ~TreeInnerRelation(){};
 
     virtual void updateConfiguration() override;
+    virtual void setUseCompressedConfiguration() override
+    {
+        reportUnsupportedCompressedConfiguration("TreeInnerRelation");
+    };
+    /** the configuration is given by the tree, so that the request fails at setup */
+    virtual void setUseNeighborSkin(Real skin_width) override;
 };
 } // namespace SPH
 #endif // INNER_BODY_RELATION_H
\ No newline at end of file
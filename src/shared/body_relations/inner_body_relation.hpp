@@ -0,0 +1,45 @@
+/**
+ * @file 	inner_body_relation.hpp
+ * @brief 	This is the implementation of the template classes in inner_body_relation.h
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef INNER_BODY_RELATION_HPP
+#define INNER_BODY_RELATION_HPP
+
+#include "inner_body_relation.h"
+#include "cell_linked_list.hpp"
+
+//=====================================================================================================//
+namespace SPH
+{
+//=================================================================================================//
+template <class KernelType>
+InnerRelationWithKernel<KernelType>::InnerRelationWithKernel(RealBody &real_body)
+    : BaseInnerRelation(real_body),
+      get_inner_neighbor_(real_body.sph_adaptation_->getKernel()),
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
+//=================================================================================================//
+template <class KernelType>
+void InnerRelationWithKernel<KernelType>::updateConfiguration()
+{
+    ScopedProfiling profiling(sph_body_, typeid(*this));
+    resetNeighborhoodCurrentSize();
+    if (use_compressed_configuration_)
+    {
+        get_inner_neighbor_.setCountOnly(true);
+        cell_linked_list_.searchNeighborsByParticles(
+            sph_body_, inner_configuration_,
+            get_single_search_depth_, get_inner_neighbor_);
+        get_inner_neighbor_.setCountOnly(false);
+        bindCompressedConfiguration();
+    }
+    cell_linked_list_.searchNeighborsByParticles(
+        sph_body_, inner_configuration_,
+        get_single_search_depth_, get_inner_neighbor_);
+    profiling.countNeighborPairs([&]()
+                                 { return TotalNeighborPairs(); });
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // INNER_BODY_RELATION_HPP
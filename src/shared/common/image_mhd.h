@@ -31,6 +31,7 @@
 
 #ifndef __EMSCRIPTEN__
 
+#include "image_volume_data.h"
 #include "sph_data_containers.h"
 #include "vector_functions.h"
 
@@ -85,6 +86,7 @@ class ImageMHD
     void set_transformMatrix(Mat3d transformMatrix)
     {
         transformMatrix_ = transformMatrix;
+        inverse_transformMatrix_ = transformMatrix_.inverse();
     };
     void set_offset(Vec3d offset)
     {
@@ -115,7 +117,10 @@ class ImageMHD
         elementDataFile_ = elementDataFile;
     };
 
-    T *get_data() { return data_; };
+    /** contiguous voxel data, a compressed volume is decoded completely for this */
+    const T *get_data() { return voxel_data_.data(); };
+    /** the number of decoded bricks kept in memory for a compressed volume */
+    void setMaxCachedBricks(size_t max_cached_bricks) { voxel_data_.setMaxCachedBricks(max_cached_bricks); };
 
     int get_size() { return size_; }
 
@@ -136,6 +141,7 @@ class ImageMHD
     bool binaryDataByteOrderMSB_;
     bool compressedData_;
     Mat3d transformMatrix_;
+    Mat3d inverse_transformMatrix_; /**< precomputed for probing */
     Vec3d offset_;
     Vec3d centerOfRotation_;
     Vec3d elementSpacing_;
@@ -147,11 +153,18 @@ class ImageMHD
     std::string anatomicalOrientation_;
     Image_Data_Type elementType_;
     std::string elementDataFile_;
+    size_t headerSize_; /**< bytes skipped at the beginning of the element data file */
     Real min_value_;
     Real max_value_;
-    T *data_;
-
-    std::vector<int> findNeighbors(const Vec3d &probe_point, Array3i &this_cell);
+    ImageVoxelData<T> voxel_data_;
+
+    /** the cell containing the probe point and the fraction of the probe point in the cell,
+     * returns false if the probe point is out of the image. */
+    bool findStencil(const Vec3d &probe_point, Array3i &cell, Vec3d &fraction);
+    /** the trilinear stencil of the 8 voxels around the probe point, given as indices and weights,
+     * the voxels beyond the last ones of the image are clamped to the last ones */
+    template <typename FunctionOnVoxel>
+    void forEachStencilVoxel(const Array3i &cell, const Vec3d &fraction, const FunctionOnVoxel &function);
     Vec3d computeGradientAtCell(int i);
     Vec3d computeNormalAtCell(int i);
     T getValueAtCell(int i);
@@ -23,6 +23,7 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
       binaryDataByteOrderMSB_(false),
       compressedData_(false),
       transformMatrix_(Matd::Identity()),
+      inverse_transformMatrix_(Matd::Identity()),
       offset_(Vecd::Zero()),
       centerOfRotation_(Vecd::Zero()),
       elementSpacing_(Vecd::Ones()),
@@ -34,9 +35,9 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
       anatomicalOrientation_("???"),
       elementType_(MET_FLOAT),
       elementDataFile_(""),
+      headerSize_(0),
       min_value_(MaxReal),
-      max_value_(MinReal),
-      data_(nullptr)
+      max_value_(-MaxReal)
 {
     //- read mhd file
     std::ifstream dataFile(full_path_to_file, std::ifstream::in);
@@ -95,8 +96,16 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
                     height_ = dimSize_[1];
                     depth_ = dimSize_[2];
                     size_ = width_ * height_ * depth_;
-                    if (data_ == nullptr)
-                        data_ = new T[dimSize_[0] * dimSize_[1] * dimSize_[2]];
+                }
+                else if (elements[0].compare("CompressedData") == 0)
+                {
+                    compressedData_ = boost::iequals(elements[1], "True") || elements[1].compare("1") == 0;
+                }
+                else if (elements[0].compare("HeaderSize") == 0)
+                {
+                    // -1 means that the element data are at the end of the file
+                    long header_size = std::stol(elements[1]);
+                    headerSize_ = header_size < 0 ? std::string::npos : size_t(header_size);
                 }
                 else if (elements[0].compare("ElementDataFile") == 0)
                 {
@@ -108,30 +117,41 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
     }
 
     dataFile.close();
+    inverse_transformMatrix_ = transformMatrix_.inverse();
     std::cout << "dimensions: " << dimSize_ << std::endl;
     std::cout << "spacing: " << elementSpacing_ << std::endl;
     std::cout << "offset: " << offset_ << std::endl;
     std::cout << "transformMatrix: " << transformMatrix_ << std::endl;
 
-    //- read raw file
-    std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
-
-    if (dataFileRaw.is_open())
+    //- map or index the element data file without reading it into memory
+    auto find_min_max = [&](const T &distance)
     {
-        dataFileRaw.read((char *)data_, sizeof(T) * size_);
-        T distance = 0;
-        for (int index = 0; index < size_; index++)
+        if (distance < min_value_)
+            min_value_ = distance;
+        if (distance > max_value_)
+            max_value_ = distance;
+    };
+    if (compressedData_)
+    {
+        // bricks of consecutive slices of about 4 MB
+        size_t slice_size = size_t(width_) * size_t(height_);
+        size_t slices_in_brick = SMAX(size_t(1), (size_t(1) << 22) / (sizeof(T) * SMAX(slice_size, size_t(1))));
+        size_t header_size = headerSize_ == std::string::npos ? 0 : headerSize_;
+        voxel_data_.loadCompressedFile(file_path_to_raw_file, header_size, size_, slices_in_brick * slice_size, find_min_max);
+    }
+    else
+    {
+        if (headerSize_ == std::string::npos)
         {
-            distance = data_[index];
-            data_[index] = distance;
-            // std::cout <<index <<" "<< distance << '\n';
-            if (distance < min_value_)
-                min_value_ = distance;
-            if (distance > max_value_)
-                max_value_ = distance;
+            std::ifstream raw_file(file_path_to_raw_file, std::ios::binary | std::ios::ate);
+            std::streamoff file_size = raw_file.is_open() ? std::streamoff(raw_file.tellg()) : 0;
+            headerSize_ = size_t(SMAX(std::streamoff(0), file_size - std::streamoff(sizeof(T) * size_)));
         }
+        voxel_data_.mapRawFile(file_path_to_raw_file, headerSize_, size_);
+        const T *data = voxel_data_.data();
+        for (int index = 0; index < size_; index++)
+            find_min_max(data[index]);
     }
-    dataFileRaw.close();
 
     // write(std::string("sphere-binary"),ASCII);
 }
@@ -143,6 +163,7 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
       binaryDataByteOrderMSB_(false),
       compressedData_(false),
       transformMatrix_(Matd::Identity()),
+      inverse_transformMatrix_(Matd::Identity()),
       offset_(Vecd(-0.5 * NxNyNz[0] * spacings[0], -0.5 * NxNyNz[1] * spacings[1], -0.5 * NxNyNz[2] * spacings[2])),
       centerOfRotation_(Vecd::Zero()),
       elementSpacing_(spacings),
@@ -154,12 +175,11 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
       anatomicalOrientation_("???"),
       elementType_(MET_FLOAT),
       elementDataFile_(""),
+      headerSize_(0),
       min_value_(MaxReal),
-      max_value_(MinReal),
-      data_(nullptr)
+      max_value_(-MaxReal)
 {
-    if (data_ == nullptr)
-        data_ = new float[size_];
+    T *data = voxel_data_.allocate(size_);
 
     Vecd center(0.5 * width_, 0.5 * height_, 0.5 * depth_);
 
@@ -175,7 +195,7 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
                     min_value_ = distance;
                 if (distance > max_value_)
                     max_value_ = distance;
-                data_[index] = float(distance);
+                data[index] = float(distance);
             }
         }
     }
@@ -183,23 +203,13 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
 }
 
 template <typename T, int nDims>
-ImageMHD<T, nDims>::~ImageMHD()
-{
-    if (data_)
-    {
-        delete data_;
-        data_ = nullptr;
-    }
-}
+ImageMHD<T, nDims>::~ImageMHD() {}
 
 //=================================================================================================//
 template <typename T, int nDims>
-std::vector<int> ImageMHD<T, nDims>::findNeighbors(const Vec3d &probe_point, Array3i &this_cell)
+bool ImageMHD<T, nDims>::findStencil(const Vec3d &probe_point, Array3i &cell, Vec3d &fraction)
 {
-    std::vector<int> neighbors;
-
-    Vec3d image_coord = transformMatrix_.inverse() * (probe_point - offset_);
-    // std::cout <<"findNeighbor of " << probe_point << " ........... " << image_coord << std::endl;
+    Vec3d image_coord = inverse_transformMatrix_ * (probe_point - offset_);
 
     int z = int(floor(image_coord[2]));
     int y = int(floor(image_coord[1]));
@@ -207,23 +217,31 @@ std::vector<int> ImageMHD<T, nDims>::findNeighbors(const Vec3d &probe_point, Arr
 
     //- cannot count cells in buffer zone
     if (x < 0 || x > width_ - 1 || y < 0 || y > height_ - 1 || z < 0 || z > depth_ - 1)
-        return neighbors;
+        return false;
 
-    for (int k = z - 1; k < z + 2; k = k + 2)
-    {
-        for (int j = y - 1; j < y + 2; j = j + 2)
-        {
-            for (int i = x - 1; i < x + 2; i = i + 2)
+    cell = Array3i(x, y, z);
+    fraction = image_coord - Vec3d(x, y, z);
+    return true;
+}
+//=================================================================================================//
+template <typename T, int nDims>
+template <typename FunctionOnVoxel>
+void ImageMHD<T, nDims>::
+    forEachStencilVoxel(const Array3i &cell, const Vec3d &fraction, const FunctionOnVoxel &function)
+{
+    Array3i upper_cell = (cell + Array3i::Ones()).min(dimSize_ - Array3i::Ones());
+    for (int k = 0; k != 2; ++k)
+        for (int j = 0; j != 2; ++j)
+            for (int i = 0; i != 2; ++i)
             {
-                if (i < 0 || i > width_ - 1 || j < 0 || j > height_ - 1 || k < 0 || k > depth_)
-                    continue;
-                int index = z * width_ * height_ + y * width_ + x;
-                neighbors.push_back(index);
+                int x = i == 0 ? cell[0] : upper_cell[0];
+                int y = j == 0 ? cell[1] : upper_cell[1];
+                int z = k == 0 ? cell[2] : upper_cell[2];
+                Real weight = (i == 0 ? 1.0 - fraction[0] : fraction[0]) *
+                              (j == 0 ? 1.0 - fraction[1] : fraction[1]) *
+                              (k == 0 ? 1.0 - fraction[2] : fraction[2]);
+                function(z * width_ * height_ + y * width_ + x, weight);
             }
-        }
-    }
-
-    return neighbors;
 }
 //=================================================================================================//
 template <typename T, int nDims>
@@ -310,13 +328,13 @@ Vec3d ImageMHD<T, nDims>::computeNormalAtCell(int i)
 template <typename T, int nDims>
 T ImageMHD<T, nDims>::getValueAtCell(int i)
 {
-    if (i < 0 || i > size_)
+    if (i < 0 || i > size_ - 1)
     {
         return float(max_value_);
     }
     else
     {
-        return data_[i];
+        return voxel_data_.getValue(i);
     }
 }
 //=================================================================================================//
@@ -347,27 +365,10 @@ void ImageMHD<T, nDims>::split(const std::string &s, char delim,
 template <typename T, int nDims>
 Vec3d ImageMHD<T, nDims>::findClosestPoint(const Vec3d &probe_point)
 {
-    Array3i this_cell = Array3i::Zero();
-    std::vector<int> neighbors = findNeighbors(probe_point, this_cell);
-    Vec3d n_sum = Vecd::Zero();
-    Real weight_sum = 0.0;
-    Real d_sum = 0.0;
-    for (const int &i : neighbors)
-    {
-        // checkIndexBound(i);
-        Vec3d nCj = computeNormalAtCell(i);
-        Real dCj = float(getValueAtCell(i));
-        Real weight_Cj = 1.0 / (fabs(dCj) + Eps);
-        n_sum = n_sum + weight_Cj * nCj;
-        weight_sum = weight_sum + weight_Cj;
-        d_sum = d_sum + dCj;
-    }
-    Vec3d n = n_sum / (weight_sum + Eps);
-    Real d = d_sum / (weight_sum + Eps);
-
-    Vec3d p_image = Vec3d(this_cell[0], this_cell[1], this_cell[2]) + n.normalized() * d;
-    Vec3d p = convertToPhysicalSpace(p_image);
-    return p;
+    // the voxel values are the signed distances to the surface
+    Real distance = findValueAtPoint(probe_point);
+    Vec3d normal = findNormalAtPoint(probe_point);
+    return probe_point - distance * normal;
 }
 
 template <typename T, int nDims>
@@ -375,13 +376,14 @@ BoundingBox ImageMHD<T, nDims>::findBounds()
 {
     // initial reference values
     Vec3d lower_bound = MaxReal * Vec3d::Ones();
-    Vec3d upper_bound = MinReal * Vec3d::Ones();
+    Vec3d upper_bound = -MaxReal * Vec3d::Ones();
 
-    for (int z = 0; z < depth_ + 1; z++)
+    // the mapping to physical space is affine, so that the bounds are given by the corner vertices
+    for (int z = 0; z < depth_ + 1; z += SMAX(depth_, 1))
     {
-        for (int y = 0; y < height_ + 1; y++)
+        for (int y = 0; y < height_ + 1; y += SMAX(height_, 1))
         {
-            for (int x = 0; x < width_ + 1; x++)
+            for (int x = 0; x < width_ + 1; x += SMAX(width_, 1))
             {
                 Vec3d p_image = Vec3d(x, y, z);
                 Vec3d vertex_position = convertToPhysicalSpace(p_image);
@@ -399,61 +401,40 @@ BoundingBox ImageMHD<T, nDims>::findBounds()
 template <typename T, int nDims>
 Real ImageMHD<T, nDims>::findValueAtPoint(const Vec3d &probe_point)
 {
-    Array3i this_cell;
-    std::vector<int> neighbors = findNeighbors(probe_point, this_cell);
-    Real weight_sum = 0.0;
-    Real d_sum = 0.0;
-    if (neighbors.size() > 0)
-    {
-        for (const int &i : neighbors)
-        {
-            // checkIndexBound(i);
-            Real dCj = float(getValueAtCell(i));
-            Real weight_Cj = 1.0 / (fabs(dCj) + Eps);
-            weight_sum = weight_sum + weight_Cj;
-            d_sum = d_sum + dCj;
-        }
-        return d_sum / (weight_sum + Eps);
-    }
-    else
-    {
+    Array3i cell;
+    Vec3d fraction;
+    if (!findStencil(probe_point, cell, fraction))
         return max_value_;
-    }
+
+    Real value = 0.0;
+    forEachStencilVoxel(cell, fraction, [&](int index, Real weight)
+                        { value += weight * Real(getValueAtCell(index)); });
+    return value;
 }
 //=================================================================================================//
 template <typename T, int nDims>
 Vec3d ImageMHD<T, nDims>::findNormalAtPoint(const Vec3d &probe_point)
 {
-    Array3i this_cell = Array3i::Zero();
-    std::vector<int> neighbors = findNeighbors(probe_point, this_cell);
-    Vec3d n_sum = Vecd::Zero();
-    Real weight_sum = 0.0;
-    Real d_sum = 0.0;
-    if (neighbors.size() > 0)
-    {
-        for (const int &i : neighbors)
-        {
-            // checkIndexBound(i);
-            Vec3d nCj = computeNormalAtCell(i);
-            Real dCj = float(getValueAtCell(i));
-            Real weight_Cj = 1.0 / (fabs(dCj) + Eps);
-            n_sum = n_sum + weight_Cj * nCj;
-            weight_sum = weight_sum + weight_Cj;
-            d_sum = d_sum + dCj;
-        }
-        Vec3d n = n_sum / (weight_sum + Eps);
-        return n.normalized();
-    }
-    else
-    {
+    Array3i cell;
+    Vec3d fraction;
+    if (!findStencil(probe_point, cell, fraction))
         return Vec3d::Ones();
-    }
-}
 
+    Vec3d gradient = Vec3d::Zero();
+    forEachStencilVoxel(cell, fraction, [&](int index, Real weight)
+                        { gradient += weight * computeGradientAtCell(index); });
+    return gradient.normalized();
+}
 //=================================================================================================//
 template <typename T, int nDims>
 void ImageMHD<T, nDims>::write(std::string filename, Output_Mode mode)
 {
+    const T *data = voxel_data_.data();
+    StdVec<char> compressed_data;
+    bool is_compressed = mode == BINARY && compressedData_ &&
+                         IndexedZlibStream::compress(reinterpret_cast<const char *>(data), sizeof(T) * size_, compressed_data);
+    std::string raw_file_extension = is_compressed ? ".zraw" : ".raw";
+
     std::ofstream output_file(filename + ".mhd", std::ofstream::out);
     output_file << "ObjectType = " << objectType_ << "\n";
     output_file << "NDims = " << nDims_ << "\n";
@@ -464,7 +445,9 @@ void ImageMHD<T, nDims>::write(std::string filename, Output_Mode mode)
         output_file << "BinaryData = False"
                     << "\n";
     output_file << "BinaryDataByteOrderMSB = " << binaryDataByteOrderMSB_ << "\n";
-    output_file << "CompressedData = " << compressedData_ << "\n";
+    output_file << "CompressedData = " << (is_compressed ? "True" : "False") << "\n";
+    if (is_compressed)
+        output_file << "CompressedDataSize = " << compressed_data.size() << "\n";
     output_file << "TransformMatrix = "
                 << transformMatrix_(0, 0) << " " << transformMatrix_(0, 1) << " " << transformMatrix_(0, 2) << " "
                 << transformMatrix_(1, 0) << " " << transformMatrix_(1, 1) << " " << transformMatrix_(1, 2) << " "
@@ -487,15 +470,21 @@ void ImageMHD<T, nDims>::write(std::string filename, Output_Mode mode)
     if (elementType_ == MET_LONG)
         output_file << "ElementType = MET_LONG"
                     << "\n";
-    output_file << "ElementDataFile = " << filename + ".raw"
+    output_file << "ElementDataFile = " << filename + raw_file_extension
                 << "\n";
 
     output_file.close();
 
-    if (mode == BINARY)
+    if (is_compressed)
+    {
+        std::ofstream output_file_raw(filename + raw_file_extension, std::ios::binary | std::ios::out);
+        output_file_raw.write(compressed_data.data(), compressed_data.size());
+        output_file_raw.close();
+    }
+    else if (mode == BINARY)
     {
         std::ofstream output_file_raw(filename + ".raw", std::ios::binary | std::ios::out);
-        output_file_raw.write((const char *)data_, sizeof(T) * size_);
+        output_file_raw.write((const char *)data, sizeof(T) * size_);
         output_file_raw.close();
     }
     else
@@ -503,7 +492,7 @@ void ImageMHD<T, nDims>::write(std::string filename, Output_Mode mode)
         std::ofstream output_file_raw(filename + ".raw");
         for (int index = 0; index < size_; index++)
         {
-            output_file_raw << data_[index] << std::endl;
+            output_file_raw << data[index] << std::endl;
         }
         output_file_raw.close();
     }
@@ -0,0 +1,280 @@
+#ifndef __EMSCRIPTEN__
+
+#include "image_volume_data.h"
+
+#include <cstdio>
+#include <fstream>
+
+#ifdef ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+namespace
+{
+constexpr size_t zlib_window_size = 32768;
+constexpr size_t zlib_input_chunk = 1 << 20;
+} // namespace
+//=================================================================================================//
+void MappedFile::open(const std::string &filefullpath, size_t offset, size_t bytes)
+{
+    close();
+#ifndef _WIN32
+    // the mapping starts at a page boundary
+    size_t page_size = sysconf(_SC_PAGE_SIZE);
+    size_t page_offset = offset / page_size * page_size;
+    mapped_size_ = bytes + offset - page_offset;
+    int file_descriptor = ::open(filefullpath.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor == -1 || fstat(file_descriptor, &file_status) != 0 ||
+        size_t(file_status.st_size) < offset + bytes)
+    {
+        std::cout << "\n Error: the element data file " << filefullpath << " is missing or too short!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    void *mapped_file = mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, file_descriptor, page_offset);
+    ::close(file_descriptor); // the mapping is kept after closing
+    if (mapped_file == MAP_FAILED)
+    {
+        std::cout << "\n Error: the element data file " << filefullpath << " can not be mapped!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    mapped_address_ = mapped_file;
+    data_ = static_cast<const char *>(mapped_file) + offset - page_offset;
+#else
+    file_buffer_.resize(bytes);
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    in_file.seekg(offset);
+    in_file.read(file_buffer_.data(), bytes);
+    if (!in_file)
+    {
+        std::cout << "\n Error: the element data file " << filefullpath << " is missing or too short!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    data_ = file_buffer_.data();
+#endif
+}
+//=================================================================================================//
+void MappedFile::close()
+{
+#ifndef _WIN32
+    if (mapped_address_ != nullptr)
+        munmap(mapped_address_, mapped_size_);
+#else
+    StdVec<char>().swap(file_buffer_);
+#endif
+    mapped_address_ = nullptr;
+    mapped_size_ = 0;
+    data_ = nullptr;
+}
+//=================================================================================================//
+void IndexedZlibStream::exitWithError(const std::string &message)
+{
+    std::cout << "\n Error: " << message << " " << filefullpath_ << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+#ifdef ZLIB_AVAILABLE
+void IndexedZlibStream::buildIndex(const std::string &filefullpath, size_t offset, size_t span,
+                                   const DecodedBytesFunction &decoded_bytes_function)
+{
+    filefullpath_ = filefullpath;
+    offset_ = offset;
+    access_points_.clear();
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    if (!in_file.is_open())
+        exitWithError("cannot open the compressed element data file");
+    in_file.seekg(offset);
+
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(z_stream));
+    // automatic detection of zlib or gzip header
+    if (inflateInit2(&stream, 47) != Z_OK)
+        exitWithError("cannot initialize decompression for");
+
+    StdVec<unsigned char> input(zlib_input_chunk);
+    StdVec<unsigned char> window(zlib_window_size);
+    size_t total_in = 0, total_out = 0, last_point = 0;
+    int ret = Z_OK;
+    do
+    {
+        in_file.read(reinterpret_cast<char *>(input.data()), zlib_input_chunk);
+        stream.avail_in = uInt(in_file.gcount());
+        if (stream.avail_in == 0)
+            exitWithError("unexpected end of the compressed element data file");
+        stream.next_in = input.data();
+        do
+        {
+            // the output is decoded into the circular window
+            if (stream.avail_out == 0)
+            {
+                stream.avail_out = zlib_window_size;
+                stream.next_out = window.data();
+            }
+            unsigned char *decoded_begin = stream.next_out;
+            total_in += stream.avail_in;
+            total_out += stream.avail_out;
+            ret = inflate(&stream, Z_BLOCK);
+            total_in -= stream.avail_in;
+            total_out -= stream.avail_out;
+            if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR)
+                exitWithError("invalid compressed data in");
+            decoded_bytes_function(reinterpret_cast<const char *>(decoded_begin), stream.next_out - decoded_begin);
+            if (ret == Z_STREAM_END)
+                break;
+
+            // at the end of a deflate block, but not the last block
+            if ((stream.data_type & 128) && !(stream.data_type & 64) &&
+                (total_out == 0 || total_out - last_point > span))
+            {
+                AccessPoint access_point;
+                access_point.uncompressed_position_ = total_out;
+                access_point.compressed_position_ = total_in;
+                access_point.bits_ = stream.data_type & 7;
+                access_point.window_.resize(zlib_window_size);
+                size_t left = stream.avail_out;
+                if (left != 0)
+                    std::memcpy(access_point.window_.data(), window.data() + zlib_window_size - left, left);
+                if (left < zlib_window_size)
+                    std::memcpy(access_point.window_.data() + left, window.data(), zlib_window_size - left);
+                access_points_.push_back(std::move(access_point));
+                last_point = total_out;
+            }
+        } while (stream.avail_in != 0);
+    } while (ret != Z_STREAM_END);
+    inflateEnd(&stream);
+    total_bytes_ = total_out;
+}
+//=================================================================================================//
+void IndexedZlibStream::read(size_t begin, size_t bytes, char *destination)
+{
+    if (bytes == 0)
+        return;
+    // the number of output bytes of a single inflate is limited
+    constexpr size_t max_bytes_in_read = size_t(1) << 30;
+    if (bytes > max_bytes_in_read)
+    {
+        for (size_t decoded = 0; decoded < bytes; decoded += max_bytes_in_read)
+            read(begin + decoded, SMIN(max_bytes_in_read, bytes - decoded), destination + decoded);
+        return;
+    }
+    if (access_points_.empty() || begin + bytes > total_bytes_)
+        exitWithError("reading out of the range of the compressed element data file");
+
+    size_t point_index = 0;
+    while (point_index + 1 < access_points_.size() &&
+           access_points_[point_index + 1].uncompressed_position_ <= begin)
+        ++point_index;
+    AccessPoint &access_point = access_points_[point_index];
+
+    std::ifstream in_file(filefullpath_.c_str(), std::ios::binary);
+    if (!in_file.is_open())
+        exitWithError("cannot open the compressed element data file");
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(z_stream));
+    // raw inflate started from the access point
+    if (inflateInit2(&stream, -15) != Z_OK)
+        exitWithError("cannot initialize decompression for");
+    in_file.seekg(offset_ + access_point.compressed_position_ - (access_point.bits_ ? 1 : 0));
+    if (access_point.bits_)
+    {
+        int byte = in_file.get();
+        if (byte == EOF)
+            exitWithError("unexpected end of the compressed element data file");
+        inflatePrime(&stream, access_point.bits_, byte >> (8 - access_point.bits_));
+    }
+    inflateSetDictionary(&stream, access_point.window_.data(), zlib_window_size);
+
+    StdVec<unsigned char> input(zlib_input_chunk);
+    StdVec<unsigned char> discard(zlib_window_size);
+    size_t skip = begin - access_point.uncompressed_position_;
+    bool is_skipping = true;
+    int ret = Z_OK;
+    do
+    {
+        if (skip == 0 && is_skipping)
+        {
+            stream.avail_out = uInt(bytes);
+            stream.next_out = reinterpret_cast<unsigned char *>(destination);
+            is_skipping = false;
+        }
+        else if (skip > zlib_window_size)
+        {
+            stream.avail_out = zlib_window_size;
+            stream.next_out = discard.data();
+            skip -= zlib_window_size;
+        }
+        else if (skip != 0)
+        {
+            stream.avail_out = uInt(skip);
+            stream.next_out = discard.data();
+            skip = 0;
+        }
+
+        do
+        {
+            if (stream.avail_in == 0)
+            {
+                in_file.read(reinterpret_cast<char *>(input.data()), zlib_input_chunk);
+                stream.avail_in = uInt(in_file.gcount());
+                if (stream.avail_in == 0)
+                    exitWithError("unexpected end of the compressed element data file");
+                stream.next_in = input.data();
+            }
+            ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR)
+                exitWithError("invalid compressed data in");
+        } while (stream.avail_out != 0 && ret != Z_STREAM_END);
+    } while (is_skipping && ret != Z_STREAM_END);
+    inflateEnd(&stream);
+
+    if (is_skipping || stream.avail_out != 0)
+        exitWithError("unexpected end of the compressed stream in");
+}
+//=================================================================================================//
+bool IndexedZlibStream::compress(const char *bytes, size_t number_of_bytes, StdVec<char> &compressed)
+{
+    uLongf compressed_size = compressBound(uLong(number_of_bytes));
+    compressed.resize(compressed_size);
+    if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &compressed_size,
+                  reinterpret_cast<const Bytef *>(bytes), uLong(number_of_bytes), Z_DEFAULT_COMPRESSION) != Z_OK)
+        return false;
+    compressed.resize(compressed_size);
+    return true;
+}
+#else
+//=================================================================================================//
+void IndexedZlibStream::buildIndex(const std::string &filefullpath, size_t offset, size_t span,
+                                   const DecodedBytesFunction &decoded_bytes_function)
+{
+    filefullpath_ = filefullpath;
+    exitWithError("zlib is not available for the compressed element data file");
+}
+//=================================================================================================//
+void IndexedZlibStream::read(size_t begin, size_t bytes, char *destination)
+{
+    exitWithError("zlib is not available for the compressed element data file");
+}
+//=================================================================================================//
+bool IndexedZlibStream::compress(const char *bytes, size_t number_of_bytes, StdVec<char> &compressed)
+{
+    return false;
+}
+#endif
+//=================================================================================================//
+} // namespace SPH
+
+#endif // __EMSCRIPTEN__
@@ -0,0 +1,324 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	image_volume_data.h
+ * @brief 	Storage of the voxel data of image volumes.
+ * @details The element data of an uncompressed volume are memory mapped from the raw file,
+ *          so that only the touched pages are resident. The zlib compressed volume is indexed
+ *          by access points once and decoded on demand brick by brick, where a brick consists of
+ *          consecutive slices, into a cache of bounded size.
+ * @author	Yijin Mao and Xiangyu Hu
+ */
+
+#ifndef IMAGE_VOLUME_DATA_H
+#define IMAGE_VOLUME_DATA_H
+
+#ifndef __EMSCRIPTEN__
+
+#include "sph_data_containers.h"
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class MappedFile
+ * @brief Read-only mapping of a part of a file.
+ * On platforms without mmap, the part is read into memory instead.
+ */
+class MappedFile
+{
+  public:
+    MappedFile() : mapped_address_(nullptr), mapped_size_(0), data_(nullptr){};
+    ~MappedFile() { close(); };
+
+    /** map the given number of bytes from the offset in the file */
+    void open(const std::string &filefullpath, size_t offset, size_t bytes);
+    void close();
+    const char *data() { return data_; };
+
+  protected:
+    void *mapped_address_;
+    size_t mapped_size_;
+    const char *data_;
+    StdVec<char> file_buffer_; /**< used when mmap is not available */
+};
+
+/**
+ * @class IndexedZlibStream
+ * @brief Random access to a zlib compressed stream in a file.
+ * While the stream is decoded once for building the index, access points,
+ * i.e. the positions and the decoding windows at deflate block boundaries,
+ * are saved at about the given span of uncompressed bytes.
+ * A range of the uncompressed data is then decoded from the nearest access point before.
+ */
+class IndexedZlibStream
+{
+  public:
+    using DecodedBytesFunction = std::function<void(const char *, size_t)>;
+
+    IndexedZlibStream() : offset_(0), total_bytes_(0){};
+    ~IndexedZlibStream(){};
+
+    /** build the index, the decoded bytes are passed to the function in order */
+    void buildIndex(const std::string &filefullpath, size_t offset, size_t span,
+                    const DecodedBytesFunction &decoded_bytes_function);
+    /** decode the uncompressed bytes [begin, begin + bytes) */
+    void read(size_t begin, size_t bytes, char *destination);
+    size_t TotalBytes() { return total_bytes_; };
+    /** compress the bytes into a zlib stream, false if zlib is not available */
+    static bool compress(const char *bytes, size_t number_of_bytes, StdVec<char> &compressed);
+
+  protected:
+    struct AccessPoint
+    {
+        size_t uncompressed_position_;
+        size_t compressed_position_;
+        int bits_; /**< bits of the byte before the compressed position, if non-zero */
+        StdVec<unsigned char> window_;
+    };
+    std::string filefullpath_;
+    size_t offset_; /**< of the compressed stream in the file */
+    size_t total_bytes_;
+    StdVec<AccessPoint> access_points_;
+
+    void exitWithError(const std::string &message);
+};
+
+/**
+ * @class ImageVoxelData
+ * @brief Voxel values of an image volume, which are in memory,
+ * memory mapped from a raw file, or decoded on demand from a compressed file.
+ */
+template <typename T>
+class ImageVoxelData
+{
+  public:
+    ImageVoxelData()
+        : size_(0), data_(nullptr), voxels_in_brick_(0), max_cached_bricks_(32),
+          id_(++instance_count_){};
+    ~ImageVoxelData(){};
+
+    /** the voxel data in memory are returned for writing */
+    T *allocate(size_t size)
+    {
+        size_ = size;
+        memory_data_.assign(size, T(0));
+        data_.store(memory_data_.data());
+        return memory_data_.data();
+    };
+
+    void mapRawFile(const std::string &filefullpath, size_t header_size, size_t size)
+    {
+        size_ = size;
+        mapped_file_.open(filefullpath, header_size, size * sizeof(T));
+        data_.store(reinterpret_cast<const T *>(mapped_file_.data()));
+    };
+
+    /** the volume is indexed by bricks of at least the given number of voxels, the decoded voxels are given in order */
+    void loadCompressedFile(const std::string &filefullpath, size_t header_size, size_t size, size_t voxels_in_brick,
+                            const std::function<void(const T &)> &voxel_function)
+    {
+        size_ = size;
+        voxels_in_brick_ = SMAX(voxels_in_brick, size_t(1));
+        size_t total_bricks = (size_ + voxels_in_brick_ - 1) / voxels_in_brick_;
+        cached_bricks_.assign(total_bricks, nullptr);
+        recently_used_bricks_.clear();
+        positions_in_recently_used_.assign(total_bricks, recently_used_bricks_.end());
+
+        // voxels may be split between the decoded chunks
+        char partial_voxel[sizeof(T)];
+        size_t partial_bytes = 0;
+        size_t decoded_voxels = 0;
+        zlib_stream_.buildIndex(
+            filefullpath, header_size, voxels_in_brick_ * sizeof(T),
+            [&](const char *bytes, size_t number_of_bytes)
+            {
+                T voxel;
+                size_t i = 0;
+                if (partial_bytes != 0)
+                {
+                    size_t completing_bytes = SMIN(sizeof(T) - partial_bytes, number_of_bytes);
+                    std::memcpy(partial_voxel + partial_bytes, bytes, completing_bytes);
+                    partial_bytes += completing_bytes;
+                    i = completing_bytes;
+                    if (partial_bytes != sizeof(T))
+                        return;
+                    std::memcpy(&voxel, partial_voxel, sizeof(T));
+                    if (decoded_voxels++ < size_)
+                        voxel_function(voxel);
+                    partial_bytes = 0;
+                }
+                for (; i + sizeof(T) <= number_of_bytes; i += sizeof(T))
+                {
+                    std::memcpy(&voxel, bytes + i, sizeof(T));
+                    if (decoded_voxels++ < size_)
+                        voxel_function(voxel);
+                }
+                partial_bytes = number_of_bytes - i;
+                std::memcpy(partial_voxel, bytes + i, partial_bytes);
+            });
+        if (zlib_stream_.TotalBytes() < size_ * sizeof(T))
+        {
+            std::cout << "\n Error: the compressed element data file " << filefullpath << " is too short!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+
+    void setMaxCachedBricks(size_t max_cached_bricks) { max_cached_bricks_ = SMAX(max_cached_bricks, size_t(1)); };
+
+    T getValue(size_t index)
+    {
+        const T *data = data_.load(std::memory_order_acquire);
+        if (data != nullptr)
+            return data[index];
+        Brick brick = findBrick(index / voxels_in_brick_);
+        return (*brick)[index % voxels_in_brick_];
+    };
+
+    /** the contiguous voxel data, the compressed volume is decoded completely into memory,
+     * which may be called concurrently with getValue */
+    const T *data()
+    {
+        const T *data = data_.load(std::memory_order_acquire);
+        if (data == nullptr && size_ != 0)
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            data = data_.load(std::memory_order_relaxed);
+            if (data == nullptr)
+            {
+                memory_data_.resize(size_);
+                zlib_stream_.read(0, size_ * sizeof(T), reinterpret_cast<char *>(memory_data_.data()));
+                data = memory_data_.data();
+                // the cached bricks are not used anymore
+                for (size_t brick_index : recently_used_bricks_)
+                    cached_bricks_[brick_index] = nullptr;
+                recently_used_bricks_.clear();
+                data_.store(data, std::memory_order_release);
+            }
+        }
+        return data;
+    };
+
+  protected:
+    using Brick = std::shared_ptr<const StdVec<T>>;
+    static inline std::atomic<size_t> instance_count_{0};
+
+    size_t size_;
+    std::atomic<const T *> data_; /**< contiguous data in memory or mapped */
+    StdVec<T> memory_data_;
+    MappedFile mapped_file_;
+
+    IndexedZlibStream zlib_stream_;
+    size_t voxels_in_brick_;
+    size_t max_cached_bricks_;
+    size_t id_; /**< identifies the bricks cached by the threads */
+    std::mutex cache_mutex_;
+    StdVec<Brick> cached_bricks_;                                      /**< nullptr if not cached */
+    std::list<size_t> recently_used_bricks_;                           /**< cached bricks, the most recently used first */
+    StdVec<std::list<size_t>::iterator> positions_in_recently_used_; /**< of the cached bricks */
+
+    Brick decodeBrick(size_t brick_index)
+    {
+        size_t begin = brick_index * voxels_in_brick_;
+        size_t voxels = SMIN(voxels_in_brick_, size_ - begin);
+        auto brick = std::make_shared<StdVec<T>>(voxels);
+        zlib_stream_.read(begin * sizeof(T), voxels * sizeof(T), reinterpret_cast<char *>(brick->data()));
+        return brick;
+    };
+
+    /** move a cached brick to the front of the recently used list, the cache mutex is locked */
+    void markRecentlyUsed(size_t brick_index)
+    {
+        recently_used_bricks_.splice(recently_used_bricks_.begin(), recently_used_bricks_,
+                                     positions_in_recently_used_[brick_index]);
+    };
+
+    Brick findBrick(size_t brick_index)
+    {
+        /** The last brick used by this thread is referred, so that the cache is locked only on changing brick.
+         * The reference is weak so that an evicted brick is released as soon as no thread is reading it. */
+        struct ThreadBrick
+        {
+            size_t owner_id_ = 0;
+            size_t brick_index_ = 0;
+            std::weak_ptr<const StdVec<T>> brick_;
+        };
+        thread_local ThreadBrick thread_brick;
+        if (thread_brick.owner_id_ == id_ && thread_brick.brick_index_ == brick_index)
+        {
+            Brick brick = thread_brick.brick_.lock();
+            if (brick != nullptr)
+                return brick;
+        }
+
+        Brick brick;
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            brick = cached_bricks_[brick_index];
+            if (brick != nullptr)
+                markRecentlyUsed(brick_index);
+        }
+
+        if (brick == nullptr)
+        {
+            // decoded without lock, a brick decoded concurrently by another thread is preferred
+            Brick decoded_brick = decodeBrick(brick_index);
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            brick = cached_bricks_[brick_index];
+            if (brick == nullptr)
+            {
+                if (recently_used_bricks_.size() >= max_cached_bricks_)
+                {
+                    cached_bricks_[recently_used_bricks_.back()] = nullptr;
+                    recently_used_bricks_.pop_back();
+                }
+                brick = decoded_brick;
+                cached_bricks_[brick_index] = brick;
+                recently_used_bricks_.push_front(brick_index);
+                positions_in_recently_used_[brick_index] = recently_used_bricks_.begin();
+            }
+            else
+            {
+                markRecentlyUsed(brick_index);
+            }
+        }
+
+        thread_brick.owner_id_ = id_;
+        thread_brick.brick_index_ = brick_index;
+        thread_brick.brick_ = brick;
+        return brick;
+    };
+};
+} // namespace SPH
+
+#endif //__EMSCRIPTEN__
+
+#endif // IMAGE_VOLUME_DATA_H
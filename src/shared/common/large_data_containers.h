@@ -36,13 +36,17 @@
 #include "tbb/concurrent_vector.h"
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
+#include "tbb/parallel_scan.h"
 #include "tbb/scalable_allocator.h"
 #include "tbb/tick_count.h"
 
 namespace SPH
 {
 
-static tbb::affinity_partitioner ap;
+/** An affinity partitioner must not be used by concurrent loops, e.g. those of independent task graph stages.
+ *  Therefore, each thread has its own, and the task graph isolates its stages,
+ *  so that a thread waiting for the loops of a stage does not start another stage. */
+static thread_local tbb::affinity_partitioner ap;
 typedef tbb::blocked_range<size_t> IndexRange;
 typedef tbb::blocked_range2d<size_t> IndexRange2d;
 typedef tbb::blocked_range3d<size_t> IndexRange3d;
@@ -0,0 +1,138 @@
+#include "profiling_registry.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#include <memory>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+std::string demangledTypeName(const std::type_info &type_info)
+{
+#ifdef __GNUG__
+    int status = 0;
+    std::unique_ptr<char, void (*)(void *)> demangled(
+        abi::__cxa_demangle(type_info.name(), nullptr, nullptr, &status), std::free);
+    std::string name = status == 0 ? demangled.get() : type_info.name();
+#else
+    std::string name = type_info.name();
+#endif
+    // the namespace is the same for all
+    size_t position = 0;
+    while ((position = name.find("SPH::", position)) != std::string::npos)
+        name.erase(position, 5);
+    return name;
+}
+//=================================================================================================//
+ProfilingRegistry &ProfilingRegistry::getRegistry()
+{
+    static ProfilingRegistry registry;
+    return registry;
+}
+//=================================================================================================//
+ProfilingRegistry::~ProfilingRegistry()
+{
+    if (is_enabled_ && !records_.empty())
+    {
+        writeTable(std::cout);
+        std::ofstream out_file(json_file_path_.c_str(), std::ios::trunc);
+        writeJson(out_file);
+        out_file.close();
+        std::cout << "\n Profiling records are written to " << json_file_path_ << std::endl;
+    }
+}
+//=================================================================================================//
+void ProfilingRegistry::addRecord(const std::string &name, Real time, size_t particles, size_t neighbor_pairs)
+{
+    std::lock_guard<std::mutex> lock(record_mutex_);
+    ProfilingRecord &record = records_[name];
+    record.calls_++;
+    record.total_time_ += time;
+    record.max_time_ = SMAX(record.max_time_, time);
+    record.particles_ += particles;
+    record.neighbor_pairs_ += neighbor_pairs;
+}
+//=================================================================================================//
+void ProfilingRegistry::writeTable(std::ostream &output_stream)
+{
+    std::lock_guard<std::mutex> lock(record_mutex_);
+    StdVec<std::pair<std::string, ProfilingRecord>> sorted_records(records_.begin(), records_.end());
+    std::sort(sorted_records.begin(), sorted_records.end(),
+              [](const auto &a, const auto &b)
+              { return a.second.total_time_ > b.second.total_time_; });
+
+    output_stream << "\n Profiling records sorted by total time (seconds):\n";
+    output_stream << std::setw(12) << "total" << std::setw(12) << "max" << std::setw(10) << "calls"
+                  << std::setw(16) << "particles" << std::setw(16) << "pairs" << "  name\n";
+    for (const auto &named_record : sorted_records)
+    {
+        const ProfilingRecord &record = named_record.second;
+        output_stream << std::fixed << std::setprecision(6)
+                      << std::setw(12) << record.total_time_ << std::setw(12) << record.max_time_
+                      << std::setw(10) << record.calls_ << std::setw(16) << record.particles_
+                      << std::setw(16) << record.neighbor_pairs_ << "  " << named_record.first << "\n";
+    }
+    output_stream << std::endl;
+}
+//=================================================================================================//
+void ProfilingRegistry::writeJson(std::ostream &output_stream)
+{
+    std::lock_guard<std::mutex> lock(record_mutex_);
+    auto escaped = [](const std::string &name)
+    {
+        std::string result;
+        for (char c : name)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    };
+
+    output_stream << "[\n";
+    size_t count = 0;
+    for (const auto &named_record : records_)
+    {
+        const ProfilingRecord &record = named_record.second;
+        output_stream << "  {\"name\": \"" << escaped(named_record.first) << "\", "
+                      << "\"calls\": " << record.calls_ << ", "
+                      << std::setprecision(9) << "\"total_time\": " << record.total_time_ << ", "
+                      << "\"max_time\": " << record.max_time_ << ", "
+                      << "\"particles\": " << record.particles_ << ", "
+                      << "\"neighbor_pairs\": " << record.neighbor_pairs_ << "}"
+                      << (++count == records_.size() ? "\n" : ",\n");
+    }
+    output_stream << "]\n";
+}
+//=================================================================================================//
+void ProfilingRegistry::clear()
+{
+    std::lock_guard<std::mutex> lock(record_mutex_);
+    records_.clear();
+}
+//=================================================================================================//
+void ScopedProfiling::start(const std::string &name, size_t particles)
+{
+    name_ = name;
+    particles_ = particles;
+    start_time_ = TickCount::now();
+}
+//=================================================================================================//
+ScopedProfiling::~ScopedProfiling()
+{
+    if (is_active_)
+    {
+        Real time = Real((TickCount::now() - start_time_).seconds());
+        ProfilingRegistry::getRegistry().addRecord(name_, time, particles_, neighbor_pairs_);
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,138 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    profiling_registry.h
+ * @brief   Opt-in timing and counters for particle dynamics, relations, cell linked lists and outputs.
+ * @details The records are collected by name with ScopedProfiling objects and are written
+ *          as a table and in JSON format at exit. When profiling is not enabled,
+ *          ScopedProfiling only checks a static flag.
+ * @author	Xiangyu Hu
+ */
+#ifndef PROFILING_REGISTRY_H
+#define PROFILING_REGISTRY_H
+
+#include "base_data_package.h"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+namespace SPH
+{
+/** human readable name of a type */
+std::string demangledTypeName(const std::type_info &type_info);
+
+/**
+ * @struct ProfilingRecord
+ * @brief The accumulated timing and counters of a named operation.
+ */
+struct ProfilingRecord
+{
+    size_t calls_ = 0;
+    Real total_time_ = 0.0;
+    Real max_time_ = 0.0;
+    size_t particles_ = 0;
+    size_t neighbor_pairs_ = 0;
+};
+
+/**
+ * @class ProfilingRegistry
+ * @brief The registry of all profiling records.
+ */
+class ProfilingRegistry
+{
+  public:
+    static ProfilingRegistry &getRegistry();
+    static bool isEnabled() { return is_enabled_; };
+    static void setEnabled(bool is_enabled) { is_enabled_ = is_enabled; };
+
+    void setJsonFilePath(const std::string &json_file_path) { json_file_path_ = json_file_path; };
+    void addRecord(const std::string &name, Real time, size_t particles, size_t neighbor_pairs);
+    void writeTable(std::ostream &output_stream);
+    void writeJson(std::ostream &output_stream);
+    void clear();
+
+  private:
+    static inline bool is_enabled_ = false;
+    std::string json_file_path_;
+    std::mutex record_mutex_;
+    std::map<std::string, ProfilingRecord> records_;
+
+    ProfilingRegistry() : json_file_path_("./profiling.json"){};
+    ~ProfilingRegistry();
+};
+
+/**
+ * @class ScopedProfiling
+ * @brief Measures the wall time from construction to destruction
+ * and adds it to the registry if profiling is enabled.
+ */
+class ScopedProfiling
+{
+  public:
+    /** the name is given by the owner, e.g. a body or dynamics identifier, and a type */
+    template <class OwnerType>
+    ScopedProfiling(OwnerType &owner, const std::type_info &type_info)
+        : is_active_(ProfilingRegistry::isEnabled()), particles_(0), neighbor_pairs_(0)
+    {
+        if (is_active_)
+            start(owner.getName() + "::" + demangledTypeName(type_info), owner.SizeOfLoopRange());
+    };
+    /** the name is given by the owner and an operation */
+    template <class OwnerType>
+    ScopedProfiling(OwnerType &owner, const char *operation)
+        : is_active_(ProfilingRegistry::isEnabled()), particles_(0), neighbor_pairs_(0)
+    {
+        if (is_active_)
+            start(owner.getName() + "::" + operation, owner.SizeOfLoopRange());
+    };
+    /** the name is given by a type only */
+    ScopedProfiling(const std::type_info &type_info, size_t particles)
+        : is_active_(ProfilingRegistry::isEnabled()), particles_(0), neighbor_pairs_(0)
+    {
+        if (is_active_)
+            start(demangledTypeName(type_info), particles);
+    };
+    ~ScopedProfiling();
+
+    /** the counting is only carried out if profiling is enabled */
+    template <class CountFunction>
+    void countNeighborPairs(const CountFunction &count_neighbor_pairs)
+    {
+        if (is_active_)
+            neighbor_pairs_ += count_neighbor_pairs();
+    };
+
+  protected:
+    bool is_active_;
+    std::string name_;
+    size_t particles_;
+    size_t neighbor_pairs_;
+    TickCount start_time_;
+
+    void start(const std::string &name, size_t particles);
+};
+} // namespace SPH
+#endif // PROFILING_REGISTRY_H
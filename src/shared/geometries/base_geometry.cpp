@@ -13,6 +13,16 @@ BoundingBox Shape::getBounds()
     return bounding_box_;
 }
 //=================================================================================================//
+void Shape::checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                              bool BOUNDARY_INCLUDED)
+{
+    is_contained.resize(probe_points.size());
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        is_contained[i] = checkContain(probe_points[i], BOUNDARY_INCLUDED);
+    }
+}
+//=================================================================================================//
 bool Shape::checkNotFar(const Vecd &probe_point, Real threshold)
 {
     return checkContain(probe_point) || checkNearSurface(probe_point, threshold) ? true : false;
@@ -30,6 +40,15 @@ Real Shape::findSignedDistance(const Vecd &probe_point)
     return checkContain(probe_point) ? -distance_to_surface : distance_to_surface;
 }
 //=================================================================================================//
+void Shape::findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances)
+{
+    signed_distances.resize(probe_points.size());
+    for (size_t i = 0; i != probe_points.size(); ++i)
+    {
+        signed_distances[i] = findSignedDistance(probe_points[i]);
+    }
+}
+//=================================================================================================//
 Vecd Shape::findNormalDirection(const Vecd &probe_point)
 {
     bool is_contain = checkContain(probe_point);
@@ -73,12 +73,17 @@ class Shape
     BoundingBox getBounds();
     virtual bool isValid() { return true; };
     virtual bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true) = 0;
+    /** Check containment for a batch of points. Shapes may override it with a vectorizable loop. */
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true);
     virtual Vecd findClosestPoint(const Vecd &probe_point) = 0;
 
     bool checkNotFar(const Vecd &probe_point, Real threshold);
     bool checkNearSurface(const Vecd &probe_point, Real threshold);
     /** Signed distance is negative for point within the shape. */
     Real findSignedDistance(const Vecd &probe_point);
+    /** Signed distances for a batch of points. Shapes may override it with a faster batched query. */
+    virtual void findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances);
     /** Normal direction point toward outside of the shape. */
     Vecd findNormalDirection(const Vecd &probe_point);
 
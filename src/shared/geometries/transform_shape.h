@@ -62,6 +62,19 @@ class TransformShape : public BaseShapeType
         return BaseShapeType::checkContain(input_pnt_origin);
     };
 
+    virtual void checkContainBatch(const StdVec<Vecd> &probe_points, StdVec<int> &is_contained,
+                                   bool BOUNDARY_INCLUDED = true) override
+    {
+        // the default batch calls back the transformed point-wise check
+        if constexpr (!has_batched_containment_)
+            return Shape::checkContainBatch(probe_points, is_contained, BOUNDARY_INCLUDED);
+
+        StdVec<Vecd> input_pnts_origin(probe_points.size());
+        for (size_t i = 0; i != probe_points.size(); ++i)
+            input_pnts_origin[i] = transform_.shiftBaseStationToFrame(probe_points[i]);
+        BaseShapeType::checkContainBatch(input_pnts_origin, is_contained, BOUNDARY_INCLUDED);
+    };
+
     virtual Vecd findClosestPoint(const Vecd &probe_point) override
     {
         Vecd input_pnt_origin = transform_.shiftBaseStationToFrame(probe_point);
@@ -69,8 +82,25 @@ class TransformShape : public BaseShapeType
         return transform_.shiftFrameStationToBase(closest_point_origin);
     };
 
+    virtual void findSignedDistanceBatch(const StdVec<Vecd> &probe_points, StdVec<Real> &signed_distances) override
+    {
+        // the default batch calls back the transformed point-wise queries
+        if constexpr (!has_batched_signed_distance_)
+            return Shape::findSignedDistanceBatch(probe_points, signed_distances);
+
+        StdVec<Vecd> input_pnts_origin(probe_points.size());
+        for (size_t i = 0; i != probe_points.size(); ++i)
+            input_pnts_origin[i] = transform_.shiftBaseStationToFrame(probe_points[i]);
+        BaseShapeType::findSignedDistanceBatch(input_pnts_origin, signed_distances);
+    };
+
   protected:
     Transform transform_;
+    /** the base shape declares its own batched query instead of inheriting the default one of Shape */
+    static constexpr bool has_batched_containment_ =
+        !std::is_same<decltype(&BaseShapeType::checkContainBatch), decltype(&Shape::checkContainBatch)>::value;
+    static constexpr bool has_batched_signed_distance_ =
+        !std::is_same<decltype(&BaseShapeType::findSignedDistanceBatch), decltype(&Shape::findSignedDistanceBatch)>::value;
 
     virtual BoundingBox findBounds() override
     {
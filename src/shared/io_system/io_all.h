@@ -31,6 +31,7 @@ io class used in SPHinXsys. **/
 #include "io_observation.h"
 #include "io_plt.h"
 #include "io_simbody.h"
+#include "io_time_series.h"
 #include "io_vtk.h"
 
 #endif // IO_ALL_H
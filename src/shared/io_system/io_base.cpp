@@ -20,6 +20,24 @@ std::string BaseIO::convertPhysicalTimeToString(Real convertPhysicalTimeToStream
     return padValueWithZeros(i_time);
 }
 //=============================================================================================//
+Real BaseIO::readRestartTime(size_t restart_step)
+{
+    std::string overall_filefullpath =
+        io_environment_.restart_folder_ + "/Restart_time_" + padValueWithZeros(restart_step) + ".dat";
+    if (!fs::exists(overall_filefullpath))
+    {
+        std::cout << "\n Error: the input file:" << overall_filefullpath << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    Real restart_time;
+    std::ifstream in_file(overall_filefullpath.c_str());
+    in_file >> restart_time;
+    in_file.close();
+
+    return restart_time;
+}
+//=============================================================================================//
 BodyStatesRecording::BodyStatesRecording(SPHBodyVector bodies)
     : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies),
       state_recording_(sph_system_.StateRecording()) {}
@@ -27,19 +45,30 @@ BodyStatesRecording::BodyStatesRecording(SPHBodyVector bodies)
 BodyStatesRecording::BodyStatesRecording(SPHBody &body)
     : BodyStatesRecording({&body}) {}
 //=============================================================================================//
+size_t BodyStatesRecording::TotalParticles()
+{
+    size_t total_particles = 0;
+    for (SPHBody *body : bodies_)
+        total_particles += body->SizeOfLoopRange();
+    return total_particles;
+}
+//=============================================================================================//
 void BodyStatesRecording::writeToFile()
 {
+    ScopedProfiling profiling(typeid(*this), TotalParticles());
     writeWithFileName(convertPhysicalTimeToString(GlobalStaticVariables::physical_time_));
 }
 //=============================================================================================//
 void BodyStatesRecording::writeToFile(size_t iteration_step)
 {
+    ScopedProfiling profiling(typeid(*this), TotalParticles());
     writeWithFileName(padValueWithZeros(iteration_step));
 };
 //=============================================================================================//
 RestartIO::RestartIO(SPHBodyVector bodies)
     : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies),
-      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_")
+      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_"),
+      use_binary_format_(false)
 {
     std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_names_),
                    [&](SPHBody *body) -> std::string
@@ -59,39 +88,31 @@ void RestartIO::writeToFile(size_t iteration_step)
 
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".xml";
+        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) +
+                                   (use_binary_format_ ? ".bin" : ".xml");
 
         if (fs::exists(filefullpath))
         {
             fs::remove(filefullpath);
         }
-        bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
-    }
-}
-//=============================================================================================//
-Real RestartIO::readRestartTime(size_t restart_step)
-{
-    std::cout << "\n Reading restart files from the restart step = " << restart_step << std::endl;
-    std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(restart_step) + ".dat";
-    if (!fs::exists(overall_filefullpath))
-    {
-        std::cout << "\n Error: the input file:" << overall_filefullpath << " is not exists" << std::endl;
-        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-        exit(1);
+        if (use_binary_format_)
+        {
+            bodies_[i]->getBaseParticles().writeParticlesToBinaryForRestart(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+        }
     }
-    Real restart_time;
-    std::ifstream in_file(overall_filefullpath.c_str());
-    in_file >> restart_time;
-    in_file.close();
-
-    return restart_time;
 }
 //=============================================================================================//
 void RestartIO::readFromFile(size_t restart_step)
 {
+    std::cout << "\n Reading restart files from the restart step = " << restart_step << std::endl;
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".xml";
+        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) +
+                                   (use_binary_format_ ? ".bin" : ".xml");
 
         if (!fs::exists(filefullpath))
         {
@@ -100,12 +121,19 @@ void RestartIO::readFromFile(size_t restart_step)
             exit(1);
         }
 
-        bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        if (use_binary_format_)
+        {
+            bodies_[i]->getBaseParticles().readParticleFromBinaryForRestart(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        }
     }
 }
 //=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
-    : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies)
+    : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies), use_binary_format_(false)
 {
     std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_names_),
                    [&](SPHBody *body) -> std::string
@@ -113,7 +141,7 @@ ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
 }
 //=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBody &sph_body, const std::string &given_body_name)
-    : BaseIO(sph_body.getSPHSystem()), bodies_({&sph_body})
+    : BaseIO(sph_body.getSPHSystem()), bodies_({&sph_body}), use_binary_format_(false)
 {
     file_names_.push_back(io_environment_.reload_folder_ + "/" + given_body_name + "_rld.xml");
 }
@@ -126,12 +154,23 @@ void ReloadParticleIO::writeToFile(size_t iteration_step)
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
         std::string filefullpath = file_names_[i];
+        if (use_binary_format_)
+        {
+            filefullpath = fs::path(filefullpath).replace_extension(".bin").string();
+        }
 
         if (fs::exists(filefullpath))
         {
             fs::remove(filefullpath);
         }
-        bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+        if (use_binary_format_)
+        {
+            bodies_[i]->getBaseParticles().writeToBinaryForReloadParticle(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+        }
     }
 }
 //=============================================================================================//
@@ -141,6 +180,10 @@ void ReloadParticleIO::readFromFile(size_t restart_step)
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
         std::string filefullpath = file_names_[i];
+        if (use_binary_format_)
+        {
+            filefullpath = fs::path(filefullpath).replace_extension(".bin").string();
+        }
 
         if (!fs::exists(filefullpath))
         {
@@ -149,7 +192,14 @@ void ReloadParticleIO::readFromFile(size_t restart_step)
             exit(1);
         }
 
-        bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+        if (use_binary_format_)
+        {
+            bodies_[i]->getBaseParticles().readFromBinaryForReloadParticle(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+        }
     }
 }
 //=================================================================================================//
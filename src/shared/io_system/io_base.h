@@ -62,6 +62,8 @@ class BaseIO
     IOEnvironment &io_environment_;
 
     std::string convertPhysicalTimeToString(Real physical_time);
+    /** the physical time saved with the restart files */
+    Real readRestartTime(size_t restart_step);
 
     template <typename T>
     std::string padValueWithZeros(T &&value, size_t max_string_width = 10)
@@ -91,12 +93,14 @@ class BodyStatesRecording : public BaseIO
     SPHBodyVector bodies_;
     bool state_recording_;
 
+    size_t TotalParticles();
     virtual void writeWithFileName(const std::string &sequence) = 0;
 };
 
 /**
  * @class RestartIO
- * @brief Write and read the restart files in XML format.
+ * @brief Write and read the restart files in XML format,
+ * or in binary format for large cases after setUseBinaryFormat.
  */
 class RestartIO : public BaseIO
 {
@@ -104,12 +108,12 @@ class RestartIO : public BaseIO
     SPHBodyVector bodies_;
     std::string overall_file_path_;
     StdVec<std::string> file_names_;
-
-    Real readRestartTime(size_t restart_step);
+    bool use_binary_format_;
 
   public:
     RestartIO(SPHBodyVector bodies);
     virtual ~RestartIO(){};
+    void setUseBinaryFormat() { use_binary_format_ = true; };
 
     virtual void writeToFile(size_t iteration_step = 0) override;
     virtual void readFromFile(size_t iteration_step = 0);
@@ -123,19 +127,22 @@ class RestartIO : public BaseIO
 
 /**
  * @class ReloadParticleIO
- * @brief Write and read the particle-reloading files in XML format.
+ * @brief Write and read the particle-reloading files in XML format,
+ * or in binary format for large cases after setUseBinaryFormat.
  */
 class ReloadParticleIO : public BaseIO
 {
   protected:
     SPHBodyVector bodies_;
     StdVec<std::string> file_names_;
+    bool use_binary_format_;
 
   public:
     ReloadParticleIO(SPHBodyVector bodies);
     ReloadParticleIO(SPHBody &sph_body);
     ReloadParticleIO(SPHBody &sph_body, const std::string &given_body_name);
     virtual ~ReloadParticleIO(){};
+    void setUseBinaryFormat() { use_binary_format_ = true; };
 
     virtual void writeToFile(size_t iteration_step = 0) override;
     virtual void readFromFile(size_t iteration_step = 0);
@@ -1,6 +1,7 @@
 
 #include "io_environment.h"
 
+#include "profiling_registry.h"
 #include "sph_system.h"
 
 namespace SPH
@@ -42,6 +43,7 @@ IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
         }
     }
 
+    ProfilingRegistry::getRegistry().setJsonFilePath(output_folder_ + "/profiling.json");
     sph_system.io_environment_ = this;
 }
 //=============================================================================================//
@@ -31,12 +31,15 @@
 #include "io_base.h"
 
 #include "io_plt.h"
+#include "io_time_series.h"
 
 namespace SPH
 {
 /**
  * @class ObservedQuantityRecording
- * @brief write files for observed quantity
+ * @brief write files for observed quantity.
+ * The observed values are recorded in a buffered binary time series
+ * and, by default, also exported to a .dat file.
  */
 template <typename VariableType>
 class ObservedQuantityRecording : public BodyStatesRecording,
@@ -49,6 +52,7 @@ class ObservedQuantityRecording : public BodyStatesRecording,
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
     std::string filefullpath_output_;
+    TimeSeriesRecorder<VariableType> time_series_;
 
   public:
     VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
@@ -60,10 +64,20 @@ class ObservedQuantityRecording : public BodyStatesRecording,
           observer_(contact_relation.getSPHBody()), plt_engine_(),
           base_particles_(observer_.getBaseParticles()),
           dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
-          quantity_name_(quantity_name)
+          quantity_name_(quantity_name),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat"),
+          time_series_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + "_time_series.bin",
+                       base_particles_.total_real_particles_)
     {
+        /** after a restart, the time series and the .dat file are continued */
+        if (sph_system_.RestartStep() != 0)
+        {
+            time_series_.continueAfterRestart(readRestartTime(sph_system_.RestartStep()));
+            time_series_.setTextExport(filefullpath_output_);
+            return;
+        }
         /** Output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat";
+        time_series_.setTextExport(filefullpath_output_);
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "run_time"
                  << "   ";
@@ -80,16 +94,13 @@ class ObservedQuantityRecording : public BodyStatesRecording,
     virtual void writeWithFileName(const std::string &sequence) override
     {
         this->exec();
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << GlobalStaticVariables::physical_time_ << "   ";
-        for (size_t i = 0; i != base_particles_.total_real_particles_; ++i)
-        {
-            plt_engine_.writeAQuantity(out_file, (*this->interpolated_quantities_)[i]);
-        }
-        out_file << "\n";
-        out_file.close();
+        time_series_.recordRow(GlobalStaticVariables::physical_time_, *this->interpolated_quantities_);
     };
 
+    /** only the binary time series is recorded without .dat file */
+    void setUseBinaryOutputOnly() { time_series_.setNoTextExport(); };
+    TimeSeriesRecorder<VariableType> &getTimeSeries() { return time_series_; };
+
     StdLargeVec<VariableType> *getObservedQuantity()
     {
         return this->interpolated_quantities_;
@@ -98,7 +109,9 @@ class ObservedQuantityRecording : public BodyStatesRecording,
 
 /**
  * @class ReducedQuantityRecording
- * @brief write reduced quantity of a body
+ * @brief write reduced quantity of a body.
+ * The reduced values are recorded in a buffered binary time series
+ * and, by default, also exported to a .dat file.
  */
 template <class LocalReduceMethodType>
 class ReducedQuantityRecording : public BaseIO
@@ -115,16 +128,28 @@ class ReducedQuantityRecording : public BaseIO
     using VariableType = typename LocalReduceMethodType::ReduceReturnType;
     VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
 
+  protected:
+    TimeSeriesRecorder<VariableType> time_series_;
+
   public:
     template <class DynamicsIdentifier, typename... Args>
     ReducedQuantityRecording(DynamicsIdentifier &identifier, Args &&...args)
         : BaseIO(identifier.getSPHBody().getSPHSystem()), plt_engine_(),
           reduce_method_(identifier, std::forward<Args>(args)...),
           dynamics_identifier_name_(reduce_method_.DynamicsIdentifierName()),
-          quantity_name_(reduce_method_.QuantityName())
+          quantity_name_(reduce_method_.QuantityName()),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat"),
+          time_series_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + "_time_series.bin", 1)
     {
+        /** after a restart, the time series and the .dat file are continued */
+        if (sph_system_.RestartStep() != 0)
+        {
+            time_series_.continueAfterRestart(readRestartTime(sph_system_.RestartStep()));
+            time_series_.setTextExport(filefullpath_output_);
+            return;
+        }
         /** output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat";
+        time_series_.setTextExport(filefullpath_output_);
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "\"run_time\""
                  << "   ";
@@ -136,11 +161,11 @@ class ReducedQuantityRecording : public BaseIO
 
     virtual void writeToFile(size_t iteration_step = 0) override
     {
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << GlobalStaticVariables::physical_time_ << "   ";
-        plt_engine_.writeAQuantity(out_file, reduce_method_.exec());
-        out_file << "\n";
-        out_file.close();
+        time_series_.recordRow(GlobalStaticVariables::physical_time_, reduce_method_.exec());
     };
+
+    /** only the binary time series is recorded without .dat file */
+    void setUseBinaryOutputOnly() { time_series_.setNoTextExport(); };
+    TimeSeriesRecorder<VariableType> &getTimeSeries() { return time_series_; };
 };
 } // namespace SPH
@@ -0,0 +1,266 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_time_series.h
+ * @brief 	Buffered binary recording of time series, such as observed or reduced quantities.
+ * @author	Chi Zhang, Shuoguo Zhang, Zhenxi Zhao and Xiangyu Hu
+ */
+
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <type_traits>
+
+namespace SPH
+{
+/**
+ * @struct TimeSeriesData
+ * @brief Conversion between a recorded variable and its components saved as floating point numbers.
+ */
+template <typename DataType, typename Enable = void>
+struct TimeSeriesData
+{
+    static constexpr int size_ = DataType::SizeAtCompileTime;
+    static void write(const DataType &value, Real *data)
+    {
+        for (int i = 0; i != size_; ++i)
+            data[i] = value.data()[i];
+    };
+    static void read(const Real *data, DataType &value)
+    {
+        for (int i = 0; i != size_; ++i)
+            value.data()[i] = data[i];
+    };
+};
+
+template <typename DataType>
+struct TimeSeriesData<DataType, std::enable_if_t<std::is_arithmetic<DataType>::value>>
+{
+    static constexpr int size_ = 1;
+    static void write(const DataType &value, Real *data) { data[0] = Real(value); };
+    static void read(const Real *data, DataType &value) { value = DataType(data[0]); };
+};
+
+/**
+ * @class TimeSeriesRecorder
+ * @brief Records rows of a time series, i.e. the time and the values of a fixed number of columns.
+ * The rows are kept in a block buffer in memory, which is flushed to a binary file once it is full.
+ * The binary file starts with a typed header, giving the components of a value,
+ * the size of the floating point number and the number of columns, followed by the rows.
+ * Optionally, each row is also written to a text file in the Tecplot .dat format when it is recorded.
+ * The text file is buffered as well and flushed together with the binary file.
+ * Both files are truncated when they are set up, so that they always hold the same rows,
+ * unless the time series is continued after a restart. Then, the binary rows after the restart time
+ * are dropped and the new rows are appended to both files.
+ */
+template <typename DataType>
+class TimeSeriesRecorder
+{
+    static constexpr char file_identifier_[8] = {'S', 'P', 'H', 'T', 'S', '0', '0', '1'};
+    static constexpr int data_size_ = TimeSeriesData<DataType>::size_;
+
+    std::string filefullpath_;
+    std::string text_filefullpath_;
+    bool use_text_export_;
+    std::ofstream text_file_;
+    bool is_file_set_up_;
+    bool is_continued_; /**< after a restart */
+    size_t number_of_columns_;
+    size_t row_size_; /**< number of floating point numbers in a row, including time */
+    size_t rows_in_block_;
+    size_t buffered_rows_;
+    StdVec<Real> block_buffer_;
+
+    void exitWithError(const std::string &message)
+    {
+        std::cout << "\n Error: " << message << " " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    };
+
+    /** the binary file is truncated to the header and the given rows */
+    void writeFile(const StdVec<Real> &rows)
+    {
+        std::ofstream out_file(filefullpath_.c_str(), std::ios::trunc | std::ios::binary);
+        if (!out_file.is_open())
+            exitWithError("cannot open the time series file");
+        uint32_t data_size = data_size_;
+        uint32_t real_size = sizeof(Real);
+        uint64_t number_of_columns = number_of_columns_;
+        out_file.write(file_identifier_, sizeof(file_identifier_));
+        out_file.write(reinterpret_cast<const char *>(&data_size), sizeof(data_size));
+        out_file.write(reinterpret_cast<const char *>(&real_size), sizeof(real_size));
+        out_file.write(reinterpret_cast<const char *>(&number_of_columns), sizeof(number_of_columns));
+        out_file.write(reinterpret_cast<const char *>(rows.data()), rows.size() * sizeof(Real));
+        is_file_set_up_ = true;
+    };
+
+    /** read the rows of the binary file, whose number of columns is returned */
+    size_t readRows(StdVec<Real> &rows)
+    {
+        std::ifstream in_file(filefullpath_.c_str(), std::ios::binary | std::ios::ate);
+        if (!in_file.is_open())
+            exitWithError("cannot open the time series file");
+        std::streamoff file_size = in_file.tellg();
+        in_file.seekg(0);
+
+        char file_identifier[sizeof(file_identifier_)];
+        uint32_t data_size = 0, real_size = 0;
+        uint64_t number_of_columns = 0;
+        in_file.read(file_identifier, sizeof(file_identifier));
+        in_file.read(reinterpret_cast<char *>(&data_size), sizeof(data_size));
+        in_file.read(reinterpret_cast<char *>(&real_size), sizeof(real_size));
+        in_file.read(reinterpret_cast<char *>(&number_of_columns), sizeof(number_of_columns));
+        if (!in_file || std::memcmp(file_identifier, file_identifier_, sizeof(file_identifier_)) != 0 ||
+            data_size != uint32_t(data_size_) || real_size != sizeof(Real))
+            exitWithError("the header does not match the recorded type of the time series file");
+
+        size_t row_size = 1 + number_of_columns * data_size_;
+        size_t total_rows = (file_size - in_file.tellg()) / (row_size * sizeof(Real));
+        rows.resize(total_rows * row_size);
+        in_file.read(reinterpret_cast<char *>(rows.data()), rows.size() * sizeof(Real));
+        return number_of_columns;
+    };
+
+    void exportRow(const Real *row_data)
+    {
+        text_file_.unsetf(std::ios_base::floatfield);
+        text_file_ << std::setprecision(6) << row_data[0] << "   ";
+        for (size_t i = 1; i != row_size_; ++i)
+            text_file_ << std::fixed << std::setprecision(9) << row_data[i] << "   ";
+        text_file_ << "\n";
+    };
+
+    void finishRow()
+    {
+        if (use_text_export_)
+            exportRow(block_buffer_.data() + buffered_rows_ * row_size_);
+        if (++buffered_rows_ == rows_in_block_)
+            flush();
+    };
+
+  public:
+    TimeSeriesRecorder(const std::string &filefullpath, size_t number_of_columns, size_t rows_in_block = 256)
+        : filefullpath_(filefullpath), use_text_export_(false), is_file_set_up_(false), is_continued_(false),
+          number_of_columns_(number_of_columns), row_size_(1 + number_of_columns * data_size_),
+          rows_in_block_(SMAX(rows_in_block, size_t(1))), buffered_rows_(0), block_buffer_(rows_in_block_ * row_size_){};
+    ~TimeSeriesRecorder() { flush(); };
+
+    /** continue the time series recorded before a restart, called before recording and setting the text export.
+     * The rows after the restart time are dropped from the binary file, which is started again if it is missing. */
+    void continueAfterRestart(Real restart_time)
+    {
+        StdVec<Real> rows;
+        if (std::ifstream(filefullpath_.c_str()).is_open())
+        {
+            if (readRows(rows) != number_of_columns_)
+                exitWithError("the number of columns does not match the time series file before the restart");
+            size_t kept_rows = 0;
+            while (kept_rows * row_size_ != rows.size() && rows[kept_rows * row_size_] <= restart_time)
+                kept_rows++;
+            rows.resize(kept_rows * row_size_);
+        }
+        writeFile(rows);
+        is_continued_ = true;
+    };
+
+    /** the recorded rows are also written to a text file, which is truncated here unless the time series is continued.
+     * Headers can be appended to the text file before recording. */
+    void setTextExport(const std::string &text_filefullpath)
+    {
+        text_filefullpath_ = text_filefullpath;
+        if (!is_continued_)
+            std::ofstream(text_filefullpath_.c_str(), std::ios::trunc);
+        text_file_.open(text_filefullpath_.c_str(), std::ios::app);
+        if (!text_file_.is_open())
+            exitWithError("cannot open the text file of the time series");
+        use_text_export_ = true;
+    };
+    void setNoTextExport()
+    {
+        if (text_file_.is_open())
+            text_file_.close();
+        use_text_export_ = false;
+    };
+    size_t NumberOfColumns() { return number_of_columns_; };
+
+    template <class ValueContainer>
+    void recordRow(Real time, const ValueContainer &values)
+    {
+        Real *row_data = block_buffer_.data() + buffered_rows_ * row_size_;
+        row_data[0] = time;
+        for (size_t column = 0; column != number_of_columns_; ++column)
+            TimeSeriesData<DataType>::write(values[column], row_data + 1 + column * data_size_);
+        finishRow();
+    };
+
+    /** record a row of a single column */
+    void recordRow(Real time, const DataType &value)
+    {
+        Real *row_data = block_buffer_.data() + buffered_rows_ * row_size_;
+        row_data[0] = time;
+        TimeSeriesData<DataType>::write(value, row_data + 1);
+        finishRow();
+    };
+
+    /** write the buffered rows to the binary file and the text file */
+    void flush()
+    {
+        if (text_file_.is_open())
+            text_file_.flush();
+        if (!is_file_set_up_)
+            writeFile(StdVec<Real>());
+        if (buffered_rows_ == 0)
+            return;
+        std::ofstream out_file(filefullpath_.c_str(), std::ios::app | std::ios::binary);
+        out_file.write(reinterpret_cast<const char *>(block_buffer_.data()), buffered_rows_ * row_size_ * sizeof(Real));
+        buffered_rows_ = 0;
+    };
+
+    /** read all recorded rows, the values are given as rows * columns */
+    void readAll(StdVec<Real> &times, BiVector<DataType> &values)
+    {
+        flush();
+        StdVec<Real> rows;
+        size_t number_of_columns = readRows(rows);
+        size_t row_size = 1 + number_of_columns * data_size_;
+        size_t total_rows = rows.size() / row_size;
+
+        times.resize(total_rows);
+        values.assign(total_rows, StdVec<DataType>(number_of_columns));
+        for (size_t row = 0; row != total_rows; ++row)
+        {
+            const Real *row_data = rows.data() + row * row_size;
+            times[row] = row_data[0];
+            for (size_t column = 0; column != number_of_columns; ++column)
+                TimeSeriesData<DataType>::read(row_data + 1 + column * data_size_, values[row][column]);
+        }
+    };
+};
+} // namespace SPH
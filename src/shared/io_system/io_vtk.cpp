@@ -5,9 +5,345 @@
 
 #include "io_vtk.h"
 
+#ifdef ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
 namespace SPH
 {
 //=============================================================================================//
+BackgroundFileWriter::BackgroundFileWriter(size_t max_pending_tasks)
+    : max_pending_tasks_(SMAX(max_pending_tasks, size_t(1))), is_stopping_(false), is_writing_(false),
+      writer_thread_(&BackgroundFileWriter::runTasks, this) {}
+//=============================================================================================//
+BackgroundFileWriter::~BackgroundFileWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(task_mutex_);
+        is_stopping_ = true;
+    }
+    task_condition_.notify_all();
+    writer_thread_.join();
+    if (task_exception_)
+    {
+        // a destructor should not throw, the exception is only reported
+        try
+        {
+            std::rethrow_exception(task_exception_);
+        }
+        catch (const std::exception &exception)
+        {
+            std::cout << "\n Error: a background file writing task failed: " << exception.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cout << "\n Error: a background file writing task failed!" << std::endl;
+        }
+    }
+}
+//=============================================================================================//
+void BackgroundFileWriter::rethrowTaskException(std::unique_lock<std::mutex> &lock)
+{
+    if (task_exception_)
+    {
+        std::exception_ptr task_exception = task_exception_;
+        task_exception_ = nullptr;
+        lock.unlock();
+        std::rethrow_exception(task_exception);
+    }
+}
+//=============================================================================================//
+void BackgroundFileWriter::addTask(const std::function<void()> &task)
+{
+    {
+        std::unique_lock<std::mutex> lock(task_mutex_);
+        rethrowTaskException(lock);
+        task_condition_.wait(lock, [&]
+                             { return pending_tasks_.size() < max_pending_tasks_; });
+        pending_tasks_.push_back(task);
+    }
+    task_condition_.notify_all();
+}
+//=============================================================================================//
+void BackgroundFileWriter::waitForAllTasks()
+{
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    task_condition_.wait(lock, [&]
+                         { return pending_tasks_.empty() && !is_writing_; });
+    rethrowTaskException(lock);
+}
+//=============================================================================================//
+void BackgroundFileWriter::runTasks()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(task_mutex_);
+            task_condition_.wait(lock, [&]
+                                 { return is_stopping_ || !pending_tasks_.empty(); });
+            if (pending_tasks_.empty())
+                return; // stopping and all tasks finished
+            task = std::move(pending_tasks_.front());
+            pending_tasks_.pop_front();
+            is_writing_ = true;
+        }
+        task_condition_.notify_all();
+
+        // an exception can not leave the thread, it is kept and rethrown to the solver thread
+        std::exception_ptr task_exception;
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            task_exception = std::current_exception();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(task_mutex_);
+            is_writing_ = false;
+            if (task_exception && !task_exception_)
+                task_exception_ = task_exception;
+        }
+        task_condition_.notify_all();
+    }
+}
+//=============================================================================================//
+template <typename OutputType, typename GetComponentsFunction>
+VtkBinaryDataArray makeVtkBinaryDataArray(const std::string &name, const std::string &type,
+                                          int number_of_components, size_t total_real_particles,
+                                          const GetComponentsFunction &get_components)
+{
+    VtkBinaryDataArray data_array{name, type, number_of_components, StdVec<char>()};
+    data_array.raw_data_.resize(total_real_particles * number_of_components * sizeof(OutputType));
+    OutputType *output = reinterpret_cast<OutputType *>(data_array.raw_data_.data());
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                get_components(i, output + i * number_of_components);
+            }
+        },
+        ap);
+    return data_array;
+}
+//=============================================================================================//
+BodyStatesRecordingToVtpBinary::BodyStatesRecordingToVtpBinary(SPHBody &body, bool use_compression)
+    : BodyStatesRecording(body), use_compression_(use_compression)
+{
+#ifndef ZLIB_AVAILABLE
+    use_compression_ = false;
+#endif
+}
+//=============================================================================================//
+BodyStatesRecordingToVtpBinary::BodyStatesRecordingToVtpBinary(SPHBodyVector bodies, bool use_compression)
+    : BodyStatesRecording(bodies), use_compression_(use_compression)
+{
+#ifndef ZLIB_AVAILABLE
+    use_compression_ = false;
+#endif
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtpBinary::writeWithFileName(const std::string &sequence)
+{
+    for (SPHBody *body : bodies_)
+    {
+        if (body->checkNewlyUpdated())
+        {
+            BaseParticles &base_particles = body->getBaseParticles();
+            base_particles.computeDerivedVariables();
+
+            if (state_recording_)
+            {
+                std::string filefullpath = io_environment_.output_folder_ + "/" + body->getName() + "_" + sequence + ".vtp";
+                size_t total_real_particles = base_particles.total_real_particles_;
+                auto point_data = std::make_shared<StdVec<VtkBinaryDataArray>>(
+                    copyParticleDataToStaging(base_particles));
+
+                auto verts_data = std::make_shared<StdVec<VtkBinaryDataArray>>();
+                verts_data->push_back(makeVtkBinaryDataArray<int32_t>(
+                    "connectivity", "Int32", 1, total_real_particles,
+                    [&](size_t i, int32_t *output)
+                    { output[0] = int32_t(i); }));
+                verts_data->push_back(makeVtkBinaryDataArray<int32_t>(
+                    "offsets", "Int32", 1, total_real_particles,
+                    [&](size_t i, int32_t *output)
+                    { output[0] = int32_t(i + 1); }));
+
+                std::string body_name = body->getName();
+                background_writer_.addTask(
+                    [this, filefullpath, body_name, total_real_particles, point_data, verts_data]()
+                    { writeVtpFile(filefullpath, body_name, total_real_particles, *point_data, *verts_data); });
+            }
+        }
+        body->setNotNewlyUpdated();
+    }
+}
+//=============================================================================================//
+StdVec<VtkBinaryDataArray> BodyStatesRecordingToVtpBinary::
+    copyParticleDataToStaging(BaseParticles &base_particles)
+{
+    size_t total_real_particles = base_particles.total_real_particles_;
+    StdVec<VtkBinaryDataArray> staging;
+
+    // the positions are the first array, written as points
+    StdLargeVec<Vecd> &pos = base_particles.pos_;
+    staging.push_back(makeVtkBinaryDataArray<float>(
+        "Position", "Float32", 3, total_real_particles,
+        [&](size_t i, float *output)
+        {
+            Vec3d particle_position = upgradeToVec3d(pos[i]);
+            for (int k = 0; k != 3; ++k)
+                output[k] = float(particle_position[k]);
+        }));
+
+    base_particles.forEachVtkDataArray(
+        [&](const std::string &name, int number_of_components, auto component_type, const auto &get_components)
+        {
+            using ComponentType = decltype(component_type);
+            if (std::is_same<ComponentType, int>::value)
+            {
+                staging.push_back(makeVtkBinaryDataArray<int32_t>(
+                    name, "Int32", number_of_components, total_real_particles,
+                    [&](size_t i, int32_t *output)
+                    {
+                        ComponentType components[9];
+                        get_components(i, components);
+                        for (int k = 0; k != number_of_components; ++k)
+                            output[k] = int32_t(components[k]);
+                    }));
+            }
+            else
+            {
+                staging.push_back(makeVtkBinaryDataArray<float>(
+                    name, "Float32", number_of_components, total_real_particles,
+                    [&](size_t i, float *output)
+                    {
+                        ComponentType components[9];
+                        get_components(i, components);
+                        for (int k = 0; k != number_of_components; ++k)
+                            output[k] = float(components[k]);
+                    }));
+            }
+        });
+
+    return staging;
+}
+//=============================================================================================//
+std::string BodyStatesRecordingToVtpBinary::encodeDataArray(const StdVec<char> &raw_data)
+{
+    std::string block;
+    auto append_header = [&](uint64_t value)
+    { block.append(reinterpret_cast<const char *>(&value), sizeof(uint64_t)); };
+
+#ifdef ZLIB_AVAILABLE
+    if (use_compression_)
+    {
+        if (raw_data.empty())
+        {
+            // no blocks
+            append_header(0);
+            append_header(0);
+            append_header(0);
+            return block;
+        }
+        uLongf compressed_size = compressBound(uLong(raw_data.size()));
+        StdVec<Bytef> compressed_data(compressed_size);
+        int status = compress2(compressed_data.data(), &compressed_size,
+                               reinterpret_cast<const Bytef *>(raw_data.data()), uLong(raw_data.size()),
+                               Z_DEFAULT_COMPRESSION);
+        if (status != Z_OK)
+        {
+            throw std::runtime_error("compressing a VTP data array failed with zlib error " + std::to_string(status));
+        }
+        // a single block, so that the last block is not partial
+        append_header(1);
+        append_header(raw_data.size());
+        append_header(0);
+        append_header(compressed_size);
+        block.append(reinterpret_cast<const char *>(compressed_data.data()), compressed_size);
+        return block;
+    }
+#endif
+    append_header(raw_data.size());
+    block.append(raw_data.data(), raw_data.size());
+    return block;
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtpBinary::
+    writeVtpFile(const std::string &filefullpath, const std::string &body_name, size_t total_real_particles,
+                 StdVec<VtkBinaryDataArray> &point_data, StdVec<VtkBinaryDataArray> &verts_data)
+{
+    std::string appended_data;
+    auto write_data_array_header = [&](std::ofstream &out_file, VtkBinaryDataArray &data_array)
+    {
+        out_file << "    <DataArray Name=\"" << data_array.name_ << "\" type=\"" << data_array.type_
+                 << "\" NumberOfComponents=\"" << data_array.number_of_components_
+                 << "\" format=\"appended\" offset=\"" << appended_data.size() << "\"/>\n";
+        appended_data += encodeDataArray(data_array.raw_data_);
+        // release the staged data as early as possible
+        StdVec<char>().swap(data_array.raw_data_);
+    };
+
+    if (fs::exists(filefullpath))
+    {
+        fs::remove(filefullpath);
+    }
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    // begin of the XML file
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+    if (use_compression_)
+        out_file << " compressor=\"vtkZLibDataCompressor\"";
+    out_file << ">\n";
+    out_file << " <PolyData>\n";
+    out_file << "  <Piece Name =\"" << body_name << "\" NumberOfPoints=\"" << total_real_particles
+             << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+    // the first staged array is the particle positions
+    out_file << "   <Points>\n";
+    write_data_array_header(out_file, point_data[0]);
+    out_file << "   </Points>\n";
+
+    out_file << "   <PointData  Vectors=\"vector\">\n";
+    for (size_t k = 1; k < point_data.size(); ++k)
+    {
+        write_data_array_header(out_file, point_data[k]);
+    }
+    out_file << "   </PointData>\n";
+
+    out_file << "   <Verts>\n";
+    for (VtkBinaryDataArray &data_array : verts_data)
+    {
+        write_data_array_header(out_file, data_array);
+    }
+    out_file << "   </Verts>\n";
+
+    out_file << "  </Piece>\n";
+    out_file << " </PolyData>\n";
+
+    out_file << " <AppendedData encoding=\"raw\">\n";
+    out_file << "_";
+    out_file.write(appended_data.data(), appended_data.size());
+    out_file << "\n </AppendedData>\n";
+    out_file << "</VTKFile>\n";
+
+    out_file.close();
+    // the error state is kept, so that failures of opening or any writing are found here
+    if (!out_file)
+    {
+        throw std::runtime_error("writing the VTP file " + filefullpath + " failed");
+    }
+}
+//=============================================================================================//
 void BodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
 {
     for (SPHBody *body : bodies_)
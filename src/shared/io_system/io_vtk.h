@@ -30,6 +30,13 @@
 
 #include "io_base.h"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 using VtuStringData = std::map<std::string, std::string>;
 
 namespace SPH
@@ -50,6 +57,80 @@ class BodyStatesRecordingToVtp : public BodyStatesRecording
     virtual void writeWithFileName(const std::string &sequence) override;
 };
 
+/**
+ * @class BackgroundFileWriter
+ * @brief Carries out file writing tasks in order on a background thread,
+ * so that the computation continues while the files are written.
+ * The number of pending tasks is bounded to limit the memory of staged data.
+ * An exception thrown by a task is kept and rethrown by the next addTask or waitForAllTasks,
+ * or reported when the writer is destroyed.
+ */
+class BackgroundFileWriter
+{
+  public:
+    explicit BackgroundFileWriter(size_t max_pending_tasks = 2);
+    virtual ~BackgroundFileWriter();
+    /** add a task, waits if too many tasks are pending */
+    void addTask(const std::function<void()> &task);
+    /** wait until all added tasks are finished */
+    void waitForAllTasks();
+
+  protected:
+    size_t max_pending_tasks_;
+    bool is_stopping_;
+    bool is_writing_;
+    std::deque<std::function<void()>> pending_tasks_;
+    std::mutex task_mutex_;
+    std::condition_variable task_condition_;
+    std::exception_ptr task_exception_; /**< the first exception thrown by a task and not rethrown yet */
+    std::thread writer_thread_;
+
+    void runTasks();
+    void rethrowTaskException(std::unique_lock<std::mutex> &lock);
+};
+
+/**
+ * @class VtkBinaryDataArray
+ * @brief A data array copied from particle data and stored as raw bytes
+ * for the appended binary data of a VTK XML file.
+ */
+struct VtkBinaryDataArray
+{
+    std::string name_;
+    std::string type_;
+    int number_of_components_;
+    StdVec<char> raw_data_;
+};
+
+/**
+ * @class BodyStatesRecordingToVtpBinary
+ * @brief Write files for bodies in VTK XML format with raw binary appended data,
+ * which is optionally zlib compressed when ZLIB_AVAILABLE.
+ * The particle data are copied into a staging buffer
+ * and the file is written by a background thread.
+ */
+class BodyStatesRecordingToVtpBinary : public BodyStatesRecording
+{
+  public:
+    BodyStatesRecordingToVtpBinary(SPHBody &body, bool use_compression = false);
+    BodyStatesRecordingToVtpBinary(SPHBodyVector bodies, bool use_compression = false);
+    /** the remaining files are written when the background writer is destroyed */
+    virtual ~BodyStatesRecordingToVtpBinary(){};
+    /** wait until all the files are written */
+    void waitForWriting() { background_writer_.waitForAllTasks(); };
+
+  protected:
+    bool use_compression_;
+    BackgroundFileWriter background_writer_;
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+    StdVec<VtkBinaryDataArray> copyParticleDataToStaging(BaseParticles &base_particles);
+    void writeVtpFile(const std::string &filefullpath, const std::string &body_name, size_t total_real_particles,
+                      StdVec<VtkBinaryDataArray> &point_data, StdVec<VtkBinaryDataArray> &verts_data);
+    /** encode a data array with the header into a block of the appended data */
+    std::string encodeDataArray(const StdVec<char> &raw_data);
+};
+
 /**
  * @class BodyStatesRecordingToVtpString
  * @brief  Write strings for bodies
@@ -6,15 +6,7 @@ namespace SPH
 Kernel::Kernel(Real h, Real kernel_size, Real truncation, const std::string &name)
     : kernel_name_(name), h_(h), inv_h_(1.0 / h), kernel_size_(kernel_size),
       truncation_(truncation), rc_ref_(truncation * h), rc_ref_sqr_(rc_ref_ * rc_ref_),
-      h_factor_W_1D_(std::bind(&Kernel::factorW1D, this, _1)),
-      h_factor_W_2D_(std::bind(&Kernel::factorW2D, this, _1)),
-      h_factor_W_3D_(std::bind(&Kernel::factorW3D, this, _1)),
-      h_factor_dW_1D_(std::bind(&Kernel::factordW1D, this, _1)),
-      h_factor_dW_2D_(std::bind(&Kernel::factordW2D, this, _1)),
-      h_factor_dW_3D_(std::bind(&Kernel::factordW3D, this, _1)),
-      h_factor_d2W_1D_(std::bind(&Kernel::factord2W1D, this, _1)),
-      h_factor_d2W_2D_(std::bind(&Kernel::factord2W2D, this, _1)),
-      h_factor_d2W_3D_(std::bind(&Kernel::factord2W3D, this, _1)){};
+      h_factor_dimension_1D_(1), h_factor_dimension_2D_(2), h_factor_dimension_3D_(3){};
 //=================================================================================================//
 void Kernel::setDerivativeParameters()
 {
@@ -98,70 +90,70 @@ Real Kernel::d2W(const Real &r_ij, const Vec3d &displacement) const
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_1D_ * W_1D(q) * h_factor_W_1D_(h_ratio);
+    return factor_W_1D_ * W_1D(q) * factorW(h_ratio, h_factor_dimension_1D_);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_2D_ * W_2D(q) * h_factor_W_2D_(h_ratio);
+    return factor_W_2D_ * W_2D(q) * factorW(h_ratio, h_factor_dimension_2D_);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_3D_ * W_3D(q) * h_factor_W_3D_(h_ratio);
+    return factor_W_3D_ * W_3D(q) * factorW(h_ratio, h_factor_dimension_3D_);
 }
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Real &point_i) const
 {
-    return factor_W_1D_ * h_factor_W_1D_(h_ratio);
+    return factor_W_1D_ * factorW(h_ratio, h_factor_dimension_1D_);
 };
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Vec2d &point_i) const
 {
-    return factor_W_2D_ * h_factor_W_2D_(h_ratio);
+    return factor_W_2D_ * factorW(h_ratio, h_factor_dimension_2D_);
 };
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Vec3d &point_i) const
 {
-    return factor_W_3D_ * h_factor_W_3D_(h_ratio);
+    return factor_W_3D_ * factorW(h_ratio, h_factor_dimension_3D_);
 };
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_1D_ * dW_1D(q) * h_factor_dW_1D_(h_ratio);
+    return factor_dW_1D_ * dW_1D(q) * factordW(h_ratio, h_factor_dimension_1D_);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_2D_ * dW_2D(q) * h_factor_dW_2D_(h_ratio);
+    return factor_dW_2D_ * dW_2D(q) * factordW(h_ratio, h_factor_dimension_2D_);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_3D_ * dW_3D(q) * h_factor_dW_1D_(h_ratio);
+    return factor_dW_3D_ * dW_3D(q) * factordW(h_ratio, h_factor_dimension_1D_);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_1D_ * d2W_1D(q) * h_factor_d2W_1D_(h_ratio);
+    return factor_d2W_1D_ * d2W_1D(q) * factord2W(h_ratio, h_factor_dimension_1D_);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_2D_ * d2W_2D(q) * h_factor_d2W_2D_(h_ratio);
+    return factor_d2W_2D_ * d2W_2D(q) * factord2W(h_ratio, h_factor_dimension_2D_);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_3D_ * d2W_3D(q) * h_factor_d2W_3D_(h_ratio);
+    return factor_d2W_3D_ * d2W_3D(q) * factord2W(h_ratio, h_factor_dimension_3D_);
 }
 //=================================================================================================//
 void Kernel::reduceOnce()
@@ -171,12 +163,8 @@ void Kernel::reduceOnce()
     factor_W_1D_ = 0.0;
     setDerivativeParameters();
 
-    h_factor_W_3D_ = std::bind(&Kernel::factorW2D, this, _1);
-    h_factor_W_2D_ = std::bind(&Kernel::factorW1D, this, _1);
-    h_factor_dW_3D_ = std::bind(&Kernel::factordW2D, this, _1);
-    h_factor_dW_2D_ = std::bind(&Kernel::factordW1D, this, _1);
-    h_factor_d2W_3D_ = std::bind(&Kernel::factord2W2D, this, _1);
-    h_factor_d2W_2D_ = std::bind(&Kernel::factord2W1D, this, _1);
+    h_factor_dimension_3D_ = 2;
+    h_factor_dimension_2D_ = 1;
 }
 //=================================================================================================//
 void Kernel::reduceTwice()
@@ -186,9 +174,7 @@ void Kernel::reduceTwice()
     factor_W_1D_ = 0.0;
     setDerivativeParameters();
 
-    h_factor_W_3D_ = std::bind(&Kernel::factorW1D, this, _1);
-    h_factor_dW_3D_ = std::bind(&Kernel::factordW1D, this, _1);
-    h_factor_d2W_3D_ = std::bind(&Kernel::factord2W1D, this, _1);
+    h_factor_dimension_3D_ = 1;
 }
 //=================================================================================================//
 } // namespace SPH
@@ -87,6 +87,10 @@ class Kernel
     Real FactorW1D() const { return factor_W_1D_; };
     Real FactorW2D() const { return factor_W_2D_; };
     Real FactorW3D() const { return factor_W_3D_; };
+    Real FactordW1D() const { return factor_dW_1D_; };
+    Real FactordW2D() const { return factor_dW_2D_; };
+    Real FactordW3D() const { return factor_dW_3D_; };
+    Real InvSmoothingLength() const { return inv_h_; };
     
     /**
      * unit vector pointing from j to i or inter-particle surface direction
@@ -170,21 +174,19 @@ class Kernel
     //		to the variable smoothing length.
     //----------------------------------------------------------------------
   protected:
-    /** Functor for variable smoothing length. */
-    typedef std::function<Real(const Real &)> FactorFunctor;
-    FactorFunctor h_factor_W_1D_, h_factor_W_2D_, h_factor_W_3D_;
-    FactorFunctor h_factor_dW_1D_, h_factor_dW_2D_, h_factor_dW_3D_;
-    FactorFunctor h_factor_d2W_1D_, h_factor_d2W_2D_, h_factor_d2W_3D_;
-
-    Real factorW1D(const Real &h_ratio) const { return h_ratio; };
-    Real factorW2D(const Real &h_ratio) const { return h_ratio * h_ratio; };
-    Real factorW3D(const Real &h_ratio) const { return h_ratio * h_ratio * h_ratio; };
-    Real factordW1D(const Real &h_ratio) const { return factorW1D(h_ratio) * h_ratio; };
-    Real factordW2D(const Real &h_ratio) const { return factorW2D(h_ratio) * h_ratio; };
-    Real factordW3D(const Real &h_ratio) const { return factorW3D(h_ratio) * h_ratio; };
-    Real factord2W1D(const Real &h_ratio) const { return factordW1D(h_ratio) * h_ratio; };
-    Real factord2W2D(const Real &h_ratio) const { return factordW2D(h_ratio) * h_ratio; };
-    Real factord2W3D(const Real &h_ratio) const { return factordW3D(h_ratio) * h_ratio; };
+    /** Effective dimensions of the factors for variable smoothing length, which are lowered for reduced kernels.
+     * Plain integers instead of functors so that the factors are computed inline. */
+    int h_factor_dimension_1D_, h_factor_dimension_2D_, h_factor_dimension_3D_;
+
+    Real factorW(const Real &h_ratio, int dimension) const
+    {
+        Real factor = 1.0;
+        for (int i = 0; i != dimension; ++i)
+            factor *= h_ratio;
+        return factor;
+    };
+    Real factordW(const Real &h_ratio, int dimension) const { return factorW(h_ratio, dimension) * h_ratio; };
+    Real factord2W(const Real &h_ratio, int dimension) const { return factordW(h_ratio, dimension) * h_ratio; };
 
   public:
     Real CutOffRadius(Real h_ratio) const { return rc_ref_ / h_ratio; };
@@ -31,6 +31,8 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
@@ -58,5 +60,75 @@ class KernelCubicBSpline : public Kernel
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
 };
+//=================================================================================================//
+// The dimensional functions are defined inline, so that they can be inlined
+// when called on a kernel of known type, e.g. by NeighborBuilderWithKernel.
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return (1.0 - 3.0 * pow(q, 2) * (1.0 - q / 2.0) / 2.0);
+    }
+    else
+    {
+        return pow(2.0 - q, 3) / 4.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_2D(const Real q) const
+{
+    return W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_3D(const Real q) const
+{
+    return W_2D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return (9.0 * pow(q, 2) / 4.0 - 3.0 * q);
+    }
+    else
+    {
+        return (-1.0) * 3.0 * pow(2.0 - q, 2) / 4.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_2D(const Real q) const
+{
+    return dW_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_3D(const Real q) const
+{
+    return dW_2D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return 9.0 * q / 2.0 - 3.0;
+    }
+    else
+    {
+        return 3.0 * (2.0 - q) / 2.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_2D(const Real q) const
+{
+    return d2W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_3D(const Real q) const
+{
+    return d2W_2D(q);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // KERNEL_CUBIC_B_SPLINE_H
\ No newline at end of file
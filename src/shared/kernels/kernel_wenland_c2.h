@@ -31,6 +31,8 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
@@ -58,5 +60,54 @@ class KernelWendlandC2 : public Kernel
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
 };
+//=================================================================================================//
+// The dimensional functions are defined inline, so that they can be inlined
+// when called on a kernel of known type, e.g. by NeighborBuilderWithKernel.
+//=================================================================================================//
+inline Real KernelWendlandC2::W_1D(const Real q) const
+{
+    return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::W_2D(const Real q) const
+{
+    return W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::W_3D(const Real q) const
+{
+    return W_2D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_1D(const Real q) const
+{
+    return 0.625 * pow(q - 2.0, 3) * q;
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_2D(const Real q) const
+{
+    return dW_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_3D(const Real q) const
+{
+    return dW_2D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_1D(const Real q) const
+{
+    return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_2D(const Real q) const
+{
+    return d2W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_3D(const Real q) const
+{
+    return d2W_2D(q);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // KERNEL_WENLAND_C2_H
\ No newline at end of file
@@ -15,11 +15,6 @@ void ElasticSolid::setSoundSpeeds()
     cs0_ = sqrt(G0_ / rho0_);
 };
 //=================================================================================================//
-Real ElasticSolid::PairNumericalDamping(Real dE_dt_ij, Real smoothing_length)
-{
-    return 0.5 * rho0_ * c0_ * dE_dt_ij * smoothing_length;
-}
-//=================================================================================================//
 Matd ElasticSolid::DeviatoricKirchhoff(const Matd &deviatoric_be)
 {
     return G0_ * deviatoric_be;
@@ -58,12 +53,6 @@ Matd LinearElasticSolid::StressPK1(Matd &F, size_t index_i)
     return F * StressPK2(F, index_i);
 }
 //=================================================================================================//
-Matd LinearElasticSolid::StressPK2(Matd &F, size_t index_i)
-{
-    Matd strain = 0.5 * (F.transpose() + F) - Matd::Identity();
-    return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
-}
-//=================================================================================================//
 Matd LinearElasticSolid::StressCauchy(Matd &almansi_strain, size_t index_i)
 {
     return lambda0_ * almansi_strain.trace() * Matd::Identity() + 2.0 * G0_ * almansi_strain;
@@ -74,22 +63,6 @@ Real LinearElasticSolid::VolumetricKirchhoff(Real J)
     return K0_ * J * (J - 1);
 }
 //=================================================================================================//
-Matd SaintVenantKirchhoffSolid::StressPK2(Matd &F, size_t index_i)
-{
-    Matd strain = 0.5 * (F.transpose() * F - Matd::Identity());
-    return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
-}
-//=================================================================================================//
-Matd NeoHookeanSolid::StressPK2(Matd &F, size_t index_i)
-{
-    // This formulation allows negative determinant of F. Please refer Eq. (12) in
-    // Smith et al. (2018) Stable Neo-Hookean Flesh Simulation.
-    // ACM Transactions on Graphics, Vol. 37, No. 2, Article 12.
-    Matd right_cauchy = F.transpose() * F;
-    Real J = F.determinant();
-    return G0_ * Matd::Identity() + (lambda0_ * (J - 1.0) - G0_) * J * right_cauchy.inverse();
-}
-//=================================================================================================//
 Matd NeoHookeanSolid::StressCauchy(Matd &almansi_strain, size_t index_i)
 {
     Matd B = (-2.0 * almansi_strain + Matd::Identity()).inverse();
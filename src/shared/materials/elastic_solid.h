@@ -93,7 +93,10 @@ class ElasticSolid : public Solid
         return 0.5 * rho0_ * (cs0_ * (strain_rate - normal_rate) + c0_ * normal_rate) * scaling;
     }
     /** Numerical damping is computed between particles i and j */
-    virtual Real PairNumericalDamping(Real dE_dt_ij, Real smoothing_length);
+    virtual Real PairNumericalDamping(Real dE_dt_ij, Real smoothing_length)
+    {
+        return 0.5 * rho0_ * c0_ * dE_dt_ij * smoothing_length;
+    };
 
     /** Deviatoric Kirchhoff stress related with the deviatoric part of left Cauchy-Green deformation tensor.
      *  Note that, dependent of the normalization of the later, the returned stress can be normalized or non-normalized. */
@@ -118,7 +121,11 @@ class LinearElasticSolid : public ElasticSolid
     virtual ~LinearElasticSolid(){};
 
     virtual Matd StressPK1(Matd &deformation, size_t particle_index_i) override;
-    virtual Matd StressPK2(Matd &deformation, size_t particle_index_i) override;
+    virtual Matd StressPK2(Matd &F, size_t particle_index_i) override
+    {
+        Matd strain = 0.5 * (F.transpose() + F) - Matd::Identity();
+        return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
+    };
     virtual Matd StressCauchy(Matd &almansi_strain, size_t particle_index_i) override;
     /** Volumetric Kirchhoff stress from determinate */
     virtual Real VolumetricKirchhoff(Real J) override;
@@ -154,7 +161,11 @@ class SaintVenantKirchhoffSolid : public LinearElasticSolid
     virtual ~SaintVenantKirchhoffSolid(){};
 
     /** second Piola-Kirchhoff stress related with green-lagrangian deformation tensor */
-    virtual Matd StressPK2(Matd &deformation, size_t particle_index_i) override;
+    virtual Matd StressPK2(Matd &F, size_t particle_index_i) override
+    {
+        Matd strain = 0.5 * (F.transpose() * F - Matd::Identity());
+        return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
+    };
 };
 
 /**
@@ -172,7 +183,15 @@ class NeoHookeanSolid : public LinearElasticSolid
     virtual ~NeoHookeanSolid(){};
 
     /** second Piola-Kirchhoff stress related with green-lagrangian deformation tensor */
-    virtual Matd StressPK2(Matd &deformation, size_t particle_index_i) override;
+    virtual Matd StressPK2(Matd &F, size_t particle_index_i) override
+    {
+        // This formulation allows negative determinant of F. Please refer Eq. (12) in
+        // Smith et al. (2018) Stable Neo-Hookean Flesh Simulation.
+        // ACM Transactions on Graphics, Vol. 37, No. 2, Article 12.
+        Matd right_cauchy = F.transpose() * F;
+        Real J = F.determinant();
+        return G0_ * Matd::Identity() + (lambda0_ * (J - 1.0) - G0_) * J * right_cauchy.inverse();
+    };
     virtual Matd StressCauchy(Matd &almansi_strain, size_t particle_index_i) override;
     /** Volumetric Kirchhoff stress from determinate */
     virtual Real VolumetricKirchhoff(Real J) override;
@@ -4,6 +4,7 @@
 #include "base_kernel.h"
 #include "base_particle_dynamics.h"
 #include "base_particles.h"
+#include "cell_linked_list.hpp"
 #include "particle_iterators.h"
 
 namespace SPH
@@ -12,7 +13,7 @@ namespace SPH
 BaseCellLinkedList::
     BaseCellLinkedList(RealBody &real_body, SPHAdaptation &sph_adaptation)
     : BaseMeshField("CellLinkedList"),
-      real_body_(real_body), kernel_(*sph_adaptation.getKernel()) {}
+      real_body_(real_body), kernel_(*sph_adaptation.getKernel()), neighbor_skin_width_(0.0) {}
 //=================================================================================================//
 void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 {
@@ -22,14 +23,33 @@ void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 //=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                RealBody &real_body, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2)
+    : CellLinkedList(tentative_bounds, grid_spacing, real_body, sph_adaptation, true) {}
+//=================================================================================================//
+CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
+                               RealBody &real_body, SPHAdaptation &sph_adaptation, bool has_dense_cell_lists)
+    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+      has_dense_cell_lists_(has_dense_cell_lists), use_sorted_cell_lists_(false),
+      cell_index_lists_required_(false), sorted_cell_lists_built_(false),
+      use_adaptive_bounds_(false), adaptive_bounds_limited_(false),
+      max_adaptive_cells_(8 * all_cells_.cast<size_t>().prod())
 {
-    allocateMeshDataMatrix();
+    if (has_dense_cell_lists_)
+        allocateMeshDataMatrix();
     single_cell_linked_list_level_.push_back(this);
 }
 //=================================================================================================//
 void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
 {
+    adaptMeshBounds(base_particles);
+    sorted_cell_lists_built_ = use_sorted_cell_lists_ && !cell_index_lists_required_ &&
+                               !real_body_.getUseSplitCellLists();
+    if (sorted_cell_lists_built_)
+    {
+        sortParticlesByCells(base_particles);
+        updateCellOffsets(base_particles.total_real_particles_);
+        return;
+    }
+
     clearCellLists();
     StdLargeVec<Vecd> &pos_n = base_particles.pos_;
     size_t total_real_particles = base_particles.total_real_particles_;
@@ -52,6 +72,115 @@ void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
     }
 }
 //=================================================================================================//
+void CellLinkedList::sortParticlesByCells(BaseParticles &base_particles)
+{
+    StdLargeVec<Vecd> &pos = base_particles.pos_;
+    StdLargeVec<Real> &Vol = base_particles.Vol_;
+    size_t total_real_particles = base_particles.total_real_particles_;
+    particle_cell_keys_.resize(total_real_particles);
+    particle_for(execution::ParallelPolicy(), total_real_particles, [&](size_t i)
+                 { particle_cell_keys_[i] = transferMeshIndexTo1D(all_cells_, CellIndexFromPosition(pos[i])); });
+    radix_sort_cell_keys_.sort(particle_cell_keys_.data(), total_real_particles, sorted_particle_index_);
+
+    sorted_particle_position_.resize(total_real_particles);
+    sorted_particle_volume_.resize(total_real_particles);
+    particle_for(execution::ParallelPolicy(), total_real_particles,
+                 [&](size_t s)
+                 {
+                     size_t index = sorted_particle_index_[s];
+                     sorted_particle_position_[s] = pos[index];
+                     sorted_particle_volume_[s] = Vol[index];
+                 });
+}
+//=================================================================================================//
+void CellLinkedList::updateCellOffsets(size_t total_particles)
+{
+    size_t total_cells = all_cells_.cast<size_t>().prod();
+    cell_offsets_.resize(total_cells + 1);
+    // a particle starting a cell gives the offsets of this cell
+    // and of the empty cells between this and the previous occupied cell
+    parallel_for(
+        IndexRange(0, total_particles + 1),
+        [&](const IndexRange &r)
+        {
+            for (size_t s = r.begin(); s != r.end(); ++s)
+            {
+                size_t first_cell = s == 0 ? 0 : particle_cell_keys_[s - 1] + 1;
+                size_t last_cell = s == total_particles ? total_cells : particle_cell_keys_[s];
+                for (size_t cell = first_cell; cell <= last_cell; ++cell)
+                    cell_offsets_[cell] = s;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+BoundingBox CellLinkedList::findParticleBounds(BaseParticles &base_particles)
+{
+    StdLargeVec<Vecd> &pos = base_particles.pos_;
+    return parallel_reduce(
+        IndexRange(0, base_particles.total_real_particles_),
+        BoundingBox(MaxReal * Vecd::Ones(), -MaxReal * Vecd::Ones()),
+        [&](const IndexRange &r, BoundingBox bounds) -> BoundingBox
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                bounds.first_ = bounds.first_.cwiseMin(pos[i]);
+                bounds.second_ = bounds.second_.cwiseMax(pos[i]);
+            }
+            return bounds;
+        },
+        [](const BoundingBox &x, const BoundingBox &y) -> BoundingBox
+        { return BoundingBox(x.first_.cwiseMin(y.first_), x.second_.cwiseMax(y.second_)); });
+}
+//=================================================================================================//
+void CellLinkedList::adaptMeshBounds(BaseParticles &base_particles)
+{
+    if (!use_adaptive_bounds_ || adaptive_bounds_limited_ || base_particles.total_real_particles_ == 0)
+        return;
+
+    if (cell_index_lists_required_)
+    {
+        std::cout << "\n Warning: the cell lists are referred by body parts or domain bounding, "
+                  << "the adaptive bounds of " << real_body_.getName() << " are not used!" << std::endl;
+        adaptive_bounds_limited_ = true;
+        return;
+    }
+
+    BoundingBox particle_bounds = findParticleBounds(base_particles);
+    if (!particle_bounds.first_.allFinite() || !particle_bounds.second_.allFinite())
+        return;
+
+    Vecd mesh_upper_bound = mesh_lower_bound_ + all_cells_.cast<Real>().matrix() * grid_spacing_;
+    auto is_below = particle_bounds.first_.array() < mesh_lower_bound_.array();
+    auto is_above = particle_bounds.second_.array() >= mesh_upper_bound.array();
+    if (!is_below.any() && !is_above.any())
+        return;
+
+    // grow by whole cells with a margin proportional to the particle extent to amortize the reallocation
+    Vecd margin = Real(buffer_width_) * grid_spacing_ * Vecd::Ones() +
+                  0.25 * (particle_bounds.second_ - particle_bounds.first_);
+    Vecd cells_below = is_below.select(
+        ceil((mesh_lower_bound_ - particle_bounds.first_ + margin).array() / grid_spacing_), 0.0);
+    Vecd cells_above = is_above.select(
+        ceil((particle_bounds.second_ + margin - mesh_upper_bound).array() / grid_spacing_), 0.0);
+    Vecd new_cells = all_cells_.cast<Real>().matrix() + cells_below + cells_above;
+    if (new_cells.prod() > Real(max_adaptive_cells_))
+    {
+        std::cout << "\n Warning: the particles of " << real_body_.getName()
+                  << " are too far out of the cell linked list, the adaptive bounds are not used anymore!" << std::endl;
+        adaptive_bounds_limited_ = true;
+        return;
+    }
+
+    if (has_dense_cell_lists_)
+        deleteMeshDataMatrix();
+    mesh_lower_bound_ -= cells_below * grid_spacing_;
+    all_cells_ = new_cells.array().cast<int>();
+    all_grid_points_ = AllGridPointsFromAllCells(all_cells_);
+    if (has_dense_cell_lists_)
+        allocateMeshDataMatrix();
+}
+//=================================================================================================//
 StdLargeVec<size_t> &CellLinkedList::computingSequence(BaseParticles &base_particles)
 {
     StdLargeVec<Vecd> &pos = base_particles.pos_;
@@ -62,6 +191,104 @@ StdLargeVec<size_t> &CellLinkedList::computingSequence(BaseParticles &base_parti
     return sequence;
 }
 //=================================================================================================//
+SparseCellLinkedList::SparseCellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
+                                           RealBody &real_body, SPHAdaptation &sph_adaptation)
+    : CellLinkedList(tentative_bounds, grid_spacing, real_body, sph_adaptation, false),
+      total_occupied_cells_(0)
+{
+    occupied_cell_offsets_.push_back(0);
+}
+//=================================================================================================//
+void SparseCellLinkedList::UpdateCellLists(BaseParticles &base_particles)
+{
+    adaptMeshBounds(base_particles);
+    sortParticlesByCells(base_particles);
+    updateOccupiedCells(base_particles.total_real_particles_);
+    sorted_cell_lists_built_ = true;
+
+    if (real_body_.getUseSplitCellLists())
+    {
+        updateSplitCellLists(real_body_.getSplitCellLists());
+    }
+}
+//=================================================================================================//
+void SparseCellLinkedList::updateOccupiedCells(size_t total_particles)
+{
+    occupied_cell_keys_.resize(total_particles + 1);
+    occupied_cell_offsets_.resize(total_particles + 1);
+    // an occupied cell starts where the sorted cell key changes
+    total_occupied_cells_ = parallel_scan(
+        IndexRange(0, total_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t s = r.begin(); s != r.end(); ++s)
+            {
+                if (s == 0 || particle_cell_keys_[s] != particle_cell_keys_[s - 1])
+                {
+                    if (is_final_scan)
+                    {
+                        occupied_cell_keys_[sum] = particle_cell_keys_[s];
+                        occupied_cell_offsets_[sum] = s;
+                    }
+                    ++sum;
+                }
+            }
+            return sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+    occupied_cell_offsets_[total_occupied_cells_] = total_particles;
+}
+//=================================================================================================//
+size_t SparseCellLinkedList::ParticlesInCell(const Arrayi &cell_index)
+{
+    size_t cell_key = transferMeshIndexTo1D(all_cells_, cell_index);
+    return ParticleOffset(cell_key + 1) - ParticleOffset(cell_key);
+}
+//=================================================================================================//
+ListData SparseCellLinkedList::findNearestListDataEntry(const Vecd &position)
+{
+    return findNearestSortedListDataEntry(position, [&](size_t cell_key)
+                                          { return ParticleOffset(cell_key); });
+}
+//=================================================================================================//
+void SparseCellLinkedList::insertParticleIndex(size_t particle_index, const Vecd &particle_position)
+{
+    std::cout << "\n Error: SparseCellLinkedList does not insert single particle index!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void SparseCellLinkedList::InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric)
+{
+    std::cout << "\n Error: SparseCellLinkedList does not insert single list data entry!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void SparseCellLinkedList::
+    tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
+{
+    std::cout << "\n Error: SparseCellLinkedList does not support body part by cell!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void SparseCellLinkedList::
+    tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis)
+{
+    std::cout << "\n Error: SparseCellLinkedList does not support domain bounding by cells!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void SparseCellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
+{
+    std::cout << "\n Error: SparseCellLinkedList does not support split cell lists!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
 MultilevelCellLinkedList::MultilevelCellLinkedList(
     BoundingBox tentative_bounds, Real reference_grid_spacing,
     size_t total_levels, RealBody &real_body, SPHAdaptation &sph_adaptation)
@@ -151,4 +378,12 @@ void MultilevelCellLinkedList::
     }
 }
 //=================================================================================================//
+void MultilevelCellLinkedList::setUseAdaptiveBounds()
+{
+    std::cout << "\n Error: the multi-level cell linked list of " << real_body_.getName()
+              << " does not support adaptive bounds!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
 } // namespace SPH
@@ -34,6 +34,7 @@
 
 #include "base_mesh.h"
 #include "neighborhood.h"
+#include "particle_sorting.h"
 
 namespace SPH
 {
@@ -54,6 +55,7 @@ class BaseCellLinkedList : public BaseMeshField
   protected:
     RealBody &real_body_;
     Kernel &kernel_;
+    Real neighbor_skin_width_; /**< the widest neighbor skin of the relations searching in this cell linked list */
 
     /** clear split cell lists in this mesh*/
     virtual void clearSplitCellLists(SplitCellLists &split_cell_lists);
@@ -80,12 +82,27 @@ class BaseCellLinkedList : public BaseMeshField
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) = 0;
     /** Tag domain bounding cells in an axis direction, called by domain bounding classes */
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) = 0;
+    /** build the cell lists by sorting particles, only effective for single-resolution cell linked list */
+    virtual void setUseSortedCellLists(){};
+    /** grow the mesh bounds when particles leave it, not supported by the multi-level cell linked list */
+    virtual void setUseAdaptiveBounds(){};
+    /** only occupied cells are stored, without the dense cell lists */
+    virtual bool isSparse() { return false; };
+    /** the periodic images are inserted for the particles within the cut-off radius and the skin from the bounds */
+    void setNeighborSkinWidth(Real skin_width) { neighbor_skin_width_ = SMAX(neighbor_skin_width_, skin_width); };
+    Real NeighborSkinWidth() { return neighbor_skin_width_; };
 };
 
 /**
  * @class CellLinkedList
  * @brief Defining a mesh cell linked list for a body.
  * 		  The meshes for all bodies share the same global coordinates.
+ * 		  Optionally, the cell lists are built by sorting particles by their cell keys,
+ * 		  i.e. the 1D cell indexes, without concurrent insertion. The particle indexes, positions and volumes
+ * 		  are then saved contiguously and the particles in a cell are found by a cell-start table.
+ * 		  Optionally, the mesh bounds are adapted to the particles. When particles leave the mesh,
+ * 		  it is grown by whole cells, keeping the global grid alignment, instead of clamping the particles
+ * 		  into the boundary cells, where the neighbor search would otherwise become very slow.
  */
 class CellLinkedList : public BaseCellLinkedList, public Mesh
 {
@@ -97,13 +114,53 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     /** non-concurrent list data rewritten for building neighbor list */
     MeshDataMatrix<ListDataVector> cell_data_lists_;
 
+    bool has_dense_cell_lists_;      /**< the cell lists of all cells are allocated */
+    bool use_sorted_cell_lists_;     /**< build cell lists by sorting particles if possible */
+    bool cell_index_lists_required_; /**< cell index lists are referred by body parts or domain bounding */
+    bool sorted_cell_lists_built_;   /**< the last update built the sorted cell lists */
+    bool use_adaptive_bounds_;       /**< grow the mesh when particles leave it */
+    bool adaptive_bounds_limited_;   /**< growing has been stopped and the particles are clamped again */
+    size_t max_adaptive_cells_;      /**< upper limit of the total number of cells of the grown mesh */
+    RadixSortParticleSequence radix_sort_cell_keys_;
+    StdLargeVec<size_t> particle_cell_keys_;    /**< cell keys of the particles, sorted after update */
+    StdLargeVec<size_t> sorted_particle_index_; /**< particle index at each sorted position */
+    StdLargeVec<Vecd> sorted_particle_position_;
+    StdLargeVec<Real> sorted_particle_volume_;
+    StdLargeVec<size_t> cell_offsets_; /**< offsets of the first sorted particles in all cells and the total number */
+
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
     void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
     virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+    /** number of particles in a cell, used for output */
+    virtual size_t ParticlesInCell(const Arrayi &cell_index);
+    /** sort particles by cell keys and gather their indexes, positions and volumes contiguously */
+    void sortParticlesByCells(BaseParticles &base_particles);
+    void updateCellOffsets(size_t total_particles);
+    /** grow the mesh by whole cells if the particles are out of its bounds */
+    void adaptMeshBounds(BaseParticles &base_particles);
+    /** bounds of the real particles */
+    BoundingBox findParticleBounds(BaseParticles &base_particles);
+    /** apply a function on the sorted particle ranges of the cells, one range for each row of cells */
+    template <typename GetParticleOffset, typename FunctionOnParticleRange>
+    void forEachParticleRange(const Arrayi &lower, const Arrayi &upper,
+                              const GetParticleOffset &get_particle_offset, const FunctionOnParticleRange &function);
+    template <typename GetParticleOffset>
+    ListData findNearestSortedListDataEntry(const Vecd &position, const GetParticleOffset &get_particle_offset);
+    template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation, typename GetParticleOffset>
+    void searchNeighborsInSortedCells(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+                                      GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation,
+                                      const GetParticleOffset &get_particle_offset);
+    /** constructor for derived classes which may not allocate the dense cell lists */
+    CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body,
+                   SPHAdaptation &sph_adaptation, bool has_dense_cell_lists);
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
-    virtual ~CellLinkedList() { deleteMeshDataMatrix(); };
+    virtual ~CellLinkedList()
+    {
+        if (has_dense_cell_lists_)
+            deleteMeshDataMatrix();
+    };
 
     void clearCellLists();
     void UpdateCellListData(BaseParticles &base_particles);
@@ -116,6 +173,10 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return single_cell_linked_list_level_; };
+    virtual void setUseSortedCellLists() override { use_sorted_cell_lists_ = true; };
+    virtual void setUseAdaptiveBounds() override { use_adaptive_bounds_ = true; };
+    /** the offset of the first sorted particle in the cell, only valid for the sorted cell lists */
+    virtual size_t ParticleOffset(size_t cell_key) { return cell_offsets_[cell_key]; };
 
     /** generalized particle search algorithm */
     template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
@@ -123,6 +184,47 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
                                     GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation);
 };
 
+/**
+ * @class SparseCellLinkedList
+ * @brief Cell linked list only storing the occupied cells, for large and mostly empty domains.
+ * 		  The particles are sorted by their cell keys as the sorted cell lists of CellLinkedList.
+ * 		  Instead of a cell-start table for all cells, the occupied cells are given by their sorted keys
+ * 		  and the offsets of their particles. Therefore, the memory and the update time scale with
+ * 		  the number of particles instead of the volume of the domain.
+ * 		  Note that tagging cells for body parts and domain bounding, split cell lists and
+ * 		  inserting single entries, which require the dense cell lists, are not supported.
+ */
+class SparseCellLinkedList : public CellLinkedList
+{
+  protected:
+    size_t total_occupied_cells_;
+    StdLargeVec<size_t> occupied_cell_keys_;    /**< sorted keys of the occupied cells */
+    StdLargeVec<size_t> occupied_cell_offsets_; /**< offsets of the first particles in the occupied cells */
+
+    void updateOccupiedCells(size_t total_particles);
+    virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+    virtual size_t ParticlesInCell(const Arrayi &cell_index) override;
+
+  public:
+    SparseCellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
+    virtual ~SparseCellLinkedList(){};
+
+    /** the offset of the first sorted particle whose cell key is not less than the given key */
+    virtual size_t ParticleOffset(size_t cell_key) override
+    {
+        size_t *keys_begin = occupied_cell_keys_.data();
+        return occupied_cell_offsets_[std::lower_bound(keys_begin, keys_begin + total_occupied_cells_, cell_key) - keys_begin];
+    };
+    virtual void UpdateCellLists(BaseParticles &base_particles) override;
+    void insertParticleIndex(size_t particle_index, const Vecd &particle_position) override;
+    void InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric) override;
+    virtual ListData findNearestListDataEntry(const Vecd &position) override;
+    virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
+    virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) override;
+    virtual void setUseSortedCellLists() override{};
+    virtual bool isSparse() override { return true; };
+};
+
 /**
  * @class MultilevelCellLinkedList
  * @brief Defining a multilevel mesh cell linked list for a body
@@ -150,6 +252,8 @@ class MultilevelCellLinkedList : public MultilevelMesh<BaseCellLinkedList, CellL
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) override{};
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return getMeshLevels(); };
+    /** the mesh levels are not grown, so that the request fails at setup */
+    virtual void setUseAdaptiveBounds() override;
 };
 } // namespace SPH
 #endif // MESH_CELL_LINKED_LIST_H
\ No newline at end of file
@@ -33,6 +33,8 @@
 #include "base_variable.h"
 #include "my_memory_pool.h"
 
+#include "tbb/parallel_sort.h"
+
 #include <algorithm>
 #include <fstream>
 #include <functional>
@@ -112,19 +114,59 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
     static constexpr int pkg_ops_end = PKG_SIZE + pkg_addrs_buffer;
     template <typename DataType>
     using PackageData = PackageDataMatrix<DataType, PKG_SIZE>;
-    template <typename DataType>
-    using PackageDataAddress = PackageDataMatrix<DataType *, pkg_addrs_size>;
     /** Matrix data for temporary usage. Note that it is array with pkg_addrs_size.  */
     template <typename DataType>
     using PackageTemporaryData = PackageDataMatrix<DataType, pkg_addrs_size>;
 
+    /** Table of the package itself and its direct neighbor packages.
+     *  A singular package is its own neighbor in all directions. */
+    using NeighborPackages = PackageDataMatrix<GridDataPackage *, 3>;
+
+    /**
+     * @class PackageDataAccessor
+     * @brief Access the data of a package with address indexes, i.e. including the buffer.
+     * The data in the buffer are found in the neighbor package and the data index in it
+     * by integer arithmetic, rather than saving an address for each data point.
+     * For a singular package, the data index is scaled by zero,
+     * so that its single value, i.e. the first data, is accessed for all address indexes.
+     */
+    template <typename DataType>
+    class PackageDataAccessor
+    {
+        NeighborPackages &neighbor_pkgs_;
+        size_t variable_index_;
+        int data_index_scale_;
+
+        static int NeighborShift(int addrs_index) { return (addrs_index - pkg_addrs_buffer + pkg_size) / pkg_size; };
+        static int DataIndex(int addrs_index) { return addrs_index - pkg_addrs_buffer + pkg_size * (1 - NeighborShift(addrs_index)); };
+
+      public:
+        PackageDataAccessor(NeighborPackages &neighbor_pkgs, size_t variable_index, int data_index_scale)
+            : neighbor_pkgs_(neighbor_pkgs), variable_index_(variable_index), data_index_scale_(data_index_scale){};
+
+        DataType &operator()(int i, int j) const
+        {
+            return neighbor_pkgs_[NeighborShift(i)][NeighborShift(j)]
+                ->template PackageDataByIndex<DataType>(variable_index_)
+                    [data_index_scale_ * DataIndex(i)][data_index_scale_ * DataIndex(j)];
+        };
+
+        DataType &operator()(int i, int j, int k) const
+        {
+            return neighbor_pkgs_[NeighborShift(i)][NeighborShift(j)][NeighborShift(k)]
+                ->template PackageDataByIndex<DataType>(variable_index_)
+                    [data_index_scale_ * DataIndex(i)][data_index_scale_ * DataIndex(j)][data_index_scale_ * DataIndex(k)];
+        };
+    };
+
     /** Default constructor for singular package */
-    GridDataPackage() : BaseDataPackage(), BaseMesh(pkg_addrs_size * Arrayi::Ones()){};
+    GridDataPackage() : BaseDataPackage(), BaseMesh(pkg_addrs_size * Arrayi::Ones()), data_index_scale_(1){};
     /** Constructor for inner package */
     GridDataPackage(const Vecd &container_lower_bound, Real data_spacing)
         : BaseDataPackage(),
           BaseMesh(container_lower_bound - data_spacing * Vecd::Ones() * ((Real)pkg_addrs_buffer - 0.5),
-                   data_spacing, pkg_addrs_size * Arrayi::Ones()){};
+                   data_spacing, pkg_addrs_size * Arrayi::Ones()),
+          data_index_scale_(1){};
     virtual ~GridDataPackage(){};
     Vecd DataPositionFromIndex(const Vecd &data_index) { return DataLowerBound() + data_index * grid_spacing_; };
     /** void (non_value_returning) function iterate on all data points by value,
@@ -142,16 +184,22 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
         constexpr int type_index = DataTypeIndex<DataType>::value;
         return std::get<type_index>(all_pkg_data_)[mesh_variable.IndexInContainer()];
     };
-    /** access specific package data address with mesh variable */
+    /** access specific package data with the index of the variable in its container */
     template <typename DataType>
-    PackageDataAddress<DataType> &getPackageDataAddress(const MeshVariable<DataType> &mesh_variable)
+    PackageData<DataType> &PackageDataByIndex(size_t variable_index)
     {
         constexpr int type_index = DataTypeIndex<DataType>::value;
-        return std::get<type_index>(all_pkg_data_addrs_)[mesh_variable.IndexInContainer()];
+        return std::get<type_index>(all_pkg_data_)[variable_index];
+    };
+    /** access specific package data, including those in the buffer, with mesh variable */
+    template <typename DataType>
+    PackageDataAccessor<DataType> getPackageDataAccessor(const MeshVariable<DataType> &mesh_variable)
+    {
+        return PackageDataAccessor<DataType>(neighbor_pkgs_, mesh_variable.IndexInContainer(), data_index_scale_);
     };
     /** probe by applying bi and tri-linear interpolation within the package. */
     template <typename DataType>
-    DataType probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position);
+    DataType probeDataPackage(const PackageDataAccessor<DataType> &pkg_data_addrs, const Vecd &position);
     /** assign value to data package according to the position of data */
     template <typename DataType, typename FunctionByPosition>
     void assignByPosition(const MeshVariable<DataType> &mesh_variable,
@@ -162,12 +210,13 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
                          const MeshVariable<OutDataType> &out_variable);
     /** obtain averaged value at a corner of a data cell */
     template <typename DataType>
-    DataType CornerAverage(PackageDataAddress<DataType> &pkg_data_addrs,
+    DataType CornerAverage(const PackageDataAccessor<DataType> &pkg_data_addrs,
                            Arrayi addrs_index, Arrayi corner_direction);
 
   protected:
     DataContainerAssemble<PackageData> all_pkg_data_;
-    DataContainerAssemble<PackageDataAddress> all_pkg_data_addrs_;
+    NeighborPackages neighbor_pkgs_;
+    int data_index_scale_; /**< zero for a singular package, whose data are all the same */
 
     /** lower bound coordinate for the data as reference */
     Vecd DataLowerBound() { return mesh_lower_bound_ + grid_spacing_ * Vecd::Ones() * (Real)pkg_addrs_buffer; };
@@ -176,50 +225,24 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
     struct AllVariablesAllocation
     {
         void operator()(DataContainerAssemble<PackageData> &all_pkg_data,
-                        DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs,
                         const MeshVariableAssemble &all_mesh_variables_)
         {
             constexpr int type_index = DataTypeIndex<DataType>::value;
             size_t total_variables = std::get<type_index>(all_mesh_variables_).size();
             std::get<type_index>(all_pkg_data).resize(total_variables);
-            std::get<type_index>(all_pkg_data_addrs).resize(total_variables);
         };
     };
     DataAssembleOperation<AllVariablesAllocation> allocate_all_variables_;
-    /** set the initial package data address for singular data package */
-    template <typename DataType>
-    struct AssignSingularPackageDataAddress
-    {
-        void operator()(DataContainerAssemble<PackageData> &all_pkg_data,
-                        DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs);
-    };
-    DataAssembleOperation<AssignSingularPackageDataAddress> assign_singular_pkg_data_addrs_;
-    /** assign address for all package data when the package is an inner one */
-    template <typename DataType>
-    struct AssignPackageDataAddress
-    {
-        void operator()(DataContainerAssemble<PackageDataAddress> &all_pkg_data_addrs,
-                        const Arrayi &addrs_index,
-                        DataContainerAssemble<PackageData> &all_pkg_data,
-                        const Arrayi &data_index);
-    };
-    DataAssembleOperation<AssignPackageDataAddress> assign_pkg_data_addrs_;
 
   public:
     void allocateAllVariables(const MeshVariableAssemble &all_mesh_variables_)
     {
-        allocate_all_variables_(all_pkg_data_, all_pkg_data_addrs_, all_mesh_variables_);
-    };
-
-    void assignSingularPackageDataAddress()
-    {
-        assign_singular_pkg_data_addrs_(all_pkg_data_, all_pkg_data_addrs_);
-    };
-
-    void assignPackageDataAddress(const Arrayi &addrs_index, GridDataPackage *src_pkg, const Arrayi &data_index)
-    {
-        assign_pkg_data_addrs_(all_pkg_data_addrs_, addrs_index, src_pkg->all_pkg_data_, data_index);
+        allocate_all_variables_(all_pkg_data_, all_mesh_variables_);
     };
+    /** a singular package is its own neighbor in all directions and has a single value */
+    void assignSingularNeighborPackages();
+    /** assign a neighbor package with its shift (-1, 0 or 1 in each direction) from this package */
+    void assignNeighborPackage(const Arrayi &neighbor_shift, GridDataPackage *neighbor_pkg);
 };
 
 /**
@@ -231,10 +254,11 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
  * while the latter is in the inner region of a mesh.
  * In this class, only some inner mesh cells are filled with data packages.
  * Each data package is again a mesh, but grid based, where two sets of data are saved on its grid points.
- * One is the field data of matrices with pkg_size, the other is corresponding address data of matrices with pkg_addrs_size.
+ * One is the field data of matrices with pkg_size, the other is a small table of the neighbor packages,
+ * with which the data in the buffer of size pkg_addrs_size are accessed.
  * For two neighboring data packages, they share the data in the buffer which is in the overlap region.
  * The filling of field data is achieved first by the data matrices by the function initializeDataInACell
- * and then the address matrix by the function initializeAddressesInACell.
+ * and then the neighbor package table by the function initializeAddressesInACell.
  * All these data packages are indexed by a concurrent vector inner_data_pkgs_.
  * Note that a data package should be not near the mesh bound, otherwise one will encounter the error "out of range".
  */
@@ -270,7 +294,6 @@ class MeshWithGridDataPackages : public Mesh
     static constexpr int pkg_ops_end = GridDataPackageType::pkg_ops_end;           /**< the size of operation loops. */
     static constexpr int pkg_addrs_size = GridDataPackageType::pkg_addrs_size;     /**< the size of address matrix in the data packages. */
     const Real data_spacing_;                                                      /**< spacing of data in the data packages*/
-    std::mutex mutex_my_pool;                                                      /**< mutex exclusion for memory pool */
     BaseMesh global_mesh_;                                                         /**< the mesh for the locations of all possible data points. */
 
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
@@ -299,7 +322,7 @@ class MeshWithGridDataPackages : public Mesh
         GridDataPackageType *new_data_pkg = data_pkg_pool_.malloc();
         new_data_pkg->allocateAllVariables(all_mesh_variables_);
         initialize_singular_data(new_data_pkg);
-        new_data_pkg->assignSingularPackageDataAddress();
+        new_data_pkg->assignSingularNeighborPackages();
         singular_data_pkgs_addrs_.push_back(new_data_pkg);
     };
 
@@ -309,11 +332,9 @@ class MeshWithGridDataPackages : public Mesh
         const Arrayi &cell_index,
         const InitializePackageData &initialize_package_data)
     {
-        mutex_my_pool.lock();
         Vecd cell_position = CellPositionFromIndex(cell_index);
         Vecd grid_position = GridPositionFromCellPosition(cell_position);
         GridDataPackageType *new_data_pkg = data_pkg_pool_.malloc(grid_position, data_spacing_);
-        mutex_my_pool.unlock();
         new_data_pkg->allocateAllVariables(all_mesh_variables_);
         initialize_package_data(new_data_pkg);
         new_data_pkg->setCellIndexOnMesh(cell_index);
@@ -322,6 +343,12 @@ class MeshWithGridDataPackages : public Mesh
     };
 
     void assignDataPackageAddress(const Arrayi &cell_index, GridDataPackageType *data_pkg);
+    /** Sort the inner data packages by their addresses in the memory pool,
+     *  so that the iteration on them is linear in memory. */
+    void sortInnerDataPackages()
+    {
+        tbb::parallel_sort(inner_data_pkgs_.begin(), inner_data_pkgs_.end());
+    };
     /** Return data package with given cell index. */
     GridDataPackageType *DataPackageFromCellIndex(const Arrayi &cell_index);
     void initializePackageAddressesInACell(const Arrayi &cell_index);
@@ -24,80 +24,110 @@
  * @file 	my_memory_pool.h
  * @brief 	A class template for scalable memory allocation from memory blocks provided by an underlying allocator.
  * @details A memory_pool allocates and frees memory in a way that scales with the number of processors.
- *			The memory is obtained as big chunks from an underlying allocator specified by the template argument.
- *			The latter must satisfy the subset of the allocator requirements from the [allocator.requirements] ISO C++ Standard section.
- *			A memory_pool meet the Memory Pool named requirement.
+ *			The memory is obtained as slabs of nodes from the standard allocator by each thread,
+ *			so that no lock is required and the nodes from one thread are contiguous.
  * @author	Chi Zhang and Xiangyu Hu
  */
 
 #ifndef MY_MEMORY_POOL_H
 #define MY_MEMORY_POOL_H
 
-#define TBB_PREVIEW_MEMORY_POOL 1
-
 #include "tbb/enumerable_thread_specific.h"
-#include "tbb/memory_pool.h"
 
 #include <list>
+#include <memory>
+#include <vector>
 
 /**
  * @class MyMemoryPool
- * @brief Note that the data package T should has a default constructor.
+ * @brief Memory pool in which each thread allocates nodes from its own slabs,
+ * so that nodes can be allocated concurrently without locking and
+ * the nodes allocated by one thread are contiguous in memory.
+ * Note that a node is constructed in place with the given arguments,
+ * also when it is reused from the free list after being destroyed there.
+ * A node freed by a thread other than the allocating one goes to the free list
+ * of the freeing thread, while it is still held by the slab of the allocating thread.
  */
-template <class T>
+template <class T, size_t SLAB_SIZE = 64>
 class MyMemoryPool
 {
-
-#ifdef __EMSCRIPTEN__
-    std::allocator<T> my_pool; /**< memory pool. */
-    std::list<T> data_list;    /**< list of all nodes allocated. */
-#else
-    tbb::memory_pool<std::allocator<T>> my_pool;            /**< memory pool. */
-    typedef tbb::memory_pool_allocator<T> pool_allocator_t; /**< memory allocator. */
-    std::list<T, pool_allocator_t> data_list;               /**< list of all nodes allocated. */
-#endif
-    std::list<T *> free_list; /**< list of all free nodes. */
+    struct ThreadSlabs
+    {
+        std::vector<T *> slabs_;           /**< slabs of nodes allocated by this thread. */
+        size_t used_in_last_ = SLAB_SIZE;  /**< number of nodes used in the last slab. */
+        std::list<T *> free_list_;         /**< list of all free nodes of this thread. */
+    };
+    std::allocator<T> slab_allocator_;
+    tbb::enumerable_thread_specific<ThreadSlabs> thread_slabs_;
 
   public:
-#ifdef __EMSCRIPTEN__
-    MyMemoryPool() : data_list(my_pool){};
-#else
-    MyMemoryPool() : data_list(pool_allocator_t(my_pool)){};
-#endif
+    MyMemoryPool(){};
+    MyMemoryPool(const MyMemoryPool &) = delete;
+    MyMemoryPool &operator=(const MyMemoryPool &) = delete;
 
-    ~MyMemoryPool(){
-        // my_pool.recycle();
+    ~MyMemoryPool()
+    {
+        for (ThreadSlabs &local : thread_slabs_)
+        {
+            for (size_t l = 0; l != local.slabs_.size(); ++l)
+            {
+                size_t used = l + 1 == local.slabs_.size() ? local.used_in_last_ : SLAB_SIZE;
+                for (size_t n = 0; n != used; ++n)
+                {
+                    local.slabs_[l][n].~T();
+                }
+                slab_allocator_.deallocate(local.slabs_[l], SLAB_SIZE);
+            }
+        }
     };
-    /**  Prepare an available node. */
+    /**  Prepare an available node. Thread safe. */
     template <typename... Args>
     T *malloc(Args &&...args)
     {
-        if (free_list.empty())
+        ThreadSlabs &local = thread_slabs_.local();
+        if (!local.free_list_.empty())
         {
-            data_list.emplace_back(std::forward<Args>(args)...);
-            return (&data_list.back());
+            T *result = local.free_list_.front();
+            local.free_list_.pop_front();
+            result->~T();
+            new (result) T(std::forward<Args>(args)...);
+            return result;
         }
-        else
+
+        if (local.used_in_last_ == SLAB_SIZE)
         {
-            T *result = free_list.front();
-            free_list.pop_front();
-            return result;
+            local.slabs_.push_back(slab_allocator_.allocate(SLAB_SIZE));
+            local.used_in_last_ = 0;
         }
+        T *result = local.slabs_.back() + local.used_in_last_;
+        new (result) T(std::forward<Args>(args)...);
+        local.used_in_last_++;
+        return result;
     };
     /** Relinquish an unused node. */
     void free(T *ptr)
     {
-        free_list.push_back(ptr);
+        thread_slabs_.local().free_list_.push_back(ptr);
     };
-    /** Return the total number of nodes allocated. */
+    /** Return the total number of nodes allocated. Not thread safe. */
     int capacity()
     {
-        return data_list.size();
+        int total = 0;
+        for (ThreadSlabs &local : thread_slabs_)
+        {
+            total += local.slabs_.empty() ? 0 : (local.slabs_.size() - 1) * SLAB_SIZE + local.used_in_last_;
+        }
+        return total;
     };
-    /** Return the number of current available nodes. */
+    /** Return the number of current available nodes. Not thread safe. */
     int available_node()
     {
-        return free_list.size();
+        int total = 0;
+        for (ThreadSlabs &local : thread_slabs_)
+        {
+            total += local.free_list_.size();
+        }
+        return total;
     };
 };
 
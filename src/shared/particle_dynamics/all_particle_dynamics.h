@@ -29,6 +29,7 @@
 #ifndef ALL_PARTICLE_DYNAMICS_H
 #define ALL_PARTICLE_DYNAMICS_H
 
+#include "dynamics_task_graph.h"
 #include "particle_dynamics_algorithms.h"
 
 #endif // ALL_PARTICLE_DYNAMICS_H
\ No newline at end of file
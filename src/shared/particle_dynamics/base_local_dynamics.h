@@ -52,6 +52,7 @@ class Wall;            /**< Interaction with wall boundary */
 class Adaptive;        /**< Interaction with adaptive resolution */
 class Extended;        /**< An extened method of an interaction type */
 class SpatialTemporal; /**< A interaction considering spatial temporal correlations */
+class PairSymmetric;   /**< Each pair is evaluated once with half neighbor lists */
 //----------------------------------------------------------------------
 // Particle group scope functors
 //----------------------------------------------------------------------
@@ -237,7 +238,8 @@ class BaseLocalDynamics
     virtual ~BaseLocalDynamics(){};
     SPHBody &getSPHBody() { return sph_body_; };
     DynamicsIdentifier &getDynamicsIdentifier() { return identifier_; };
-    virtual void setupDynamics(Real dt = 0.0){}; // setup global parameters
+    virtual void setupDynamics(Real dt = 0.0){};  // setup global parameters
+    virtual void finishDynamics(Real dt = 0.0){}; // finish global operations after the particle loop
   protected:
     DynamicsIdentifier &identifier_;
     SPHBody &sph_body_;
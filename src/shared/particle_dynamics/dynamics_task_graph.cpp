@@ -0,0 +1,104 @@
+#include "dynamics_task_graph.h"
+
+namespace SPH
+{
+//=================================================================================================//
+bool DynamicsStage::conflictsWith(const DynamicsStage &earlier_stage) const
+{
+    for (const void *data : earlier_stage.write_set_)
+    {
+        if (read_set_.count(data) != 0 || write_set_.count(data) != 0)
+            return true;
+    }
+    for (const void *data : earlier_stage.read_set_)
+    {
+        if (write_set_.count(data) != 0)
+            return true;
+    }
+    return false;
+}
+//=================================================================================================//
+void DynamicsStage::checkNotFrozen()
+{
+    if (is_frozen_)
+    {
+        std::cout << "\n Error: the data of a dynamics stage can not be changed after the task graph is built!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+DynamicsStage &DynamicsTaskGraph::addStage(BaseDynamics<void> &dynamics)
+{
+    return addStage([&](Real dt)
+                    { dynamics.exec(dt); });
+}
+//=================================================================================================//
+DynamicsStage &DynamicsTaskGraph::addStage(const std::function<void(Real)> &task)
+{
+    if (is_built_)
+    {
+        std::cout << "\n Error: a dynamics stage can not be added after the task graph is built!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    stages_.push_back(stage_ptrs_.createPtr<DynamicsStage>(task));
+    return *stages_.back();
+}
+//=================================================================================================//
+size_t DynamicsTaskGraph::NumberOfDependencies()
+{
+    if (!is_built_)
+        buildGraph();
+    return dependencies_.size();
+}
+//=================================================================================================//
+void DynamicsTaskGraph::buildGraph()
+{
+    flow_graph_ = makeUnique<tbb::flow::graph>();
+    start_node_ = makeUnique<tbb::flow::broadcast_node<tbb::flow::continue_msg>>(*flow_graph_);
+
+    dependencies_.clear();
+    for (size_t k = 0; k != stages_.size(); ++k)
+    {
+        DynamicsStage *stage = stages_[k];
+        stage->freeze();
+        nodes_.push_back(makeUnique<tbb::flow::continue_node<tbb::flow::continue_msg>>(
+            *flow_graph_, [&, stage](const tbb::flow::continue_msg &)
+            {
+                // while waiting for its own loops, the thread does not start another stage,
+                // whose loops would share the affinity partitioner of the thread
+                tbb::this_task_arena::isolate([&]()
+                                              { stage->run(dt_); });
+            }));
+
+        bool is_independent = true;
+        for (size_t l = 0; l != k; ++l)
+        {
+            if (stage->conflictsWith(*stages_[l]))
+            {
+                tbb::flow::make_edge(*nodes_[l], *nodes_[k]);
+                dependencies_.push_back(std::make_pair(l, k));
+                is_independent = false;
+            }
+        }
+        if (is_independent)
+            tbb::flow::make_edge(*start_node_, *nodes_[k]);
+    }
+    is_built_ = true;
+}
+//=================================================================================================//
+void DynamicsTaskGraph::exec(Real dt)
+{
+    if (stages_.empty())
+        return;
+
+    if (!is_built_)
+        buildGraph();
+
+    dt_ = dt;
+    start_node_->try_put(tbb::flow::continue_msg());
+    flow_graph_->wait_for_all();
+}
+//=================================================================================================//
+} // namespace SPH
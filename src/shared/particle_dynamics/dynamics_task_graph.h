@@ -0,0 +1,155 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	dynamics_task_graph.h
+ * @brief 	A dependency-aware scheduler which executes independent dynamics concurrently.
+ * @details Each stage of the graph declares the data it reads and writes.
+ *			Two stages conflict when one of them writes data the other reads or writes.
+ *			Conflicting stages keep the order in which they are added,
+ *			while the others run concurrently on a TBB flow graph.
+ *			As the particle loops inside a stage share the same thread pool,
+ *			small bodies which cannot saturate all cores alone share the machine.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef DYNAMICS_TASK_GRAPH_H
+#define DYNAMICS_TASK_GRAPH_H
+
+#include "base_particle_dynamics.h"
+
+#include "tbb/flow_graph.h"
+#include "tbb/task_arena.h"
+
+#include <functional>
+#include <set>
+
+namespace SPH
+{
+/**
+ * @class DynamicsStage
+ * @brief A stage of the task graph with its read and write sets.
+ *		  Data are identified by their addresses only, e.g. a particle variable,
+ *		  a body, a cell linked list or a body relation.
+ *		  Therefore, the same object should be declared with the same granularity in all stages,
+ *		  as a body and one of its variables are not recognized as the same data.
+ *		  The read and write sets can not be changed once the task graph is built.
+ */
+class DynamicsStage
+{
+  public:
+    explicit DynamicsStage(const std::function<void(Real)> &task) : task_(task), is_frozen_(false){};
+    virtual ~DynamicsStage(){};
+
+    template <class DataType>
+    DynamicsStage &reads(const DataType &data)
+    {
+        static_assert(!std::is_pointer<DataType>::value, "Declare the data itself rather than a pointer to it.");
+        checkNotFrozen();
+        read_set_.insert(&data);
+        return *this;
+    };
+
+    template <class DataType>
+    DynamicsStage &writes(const DataType &data)
+    {
+        static_assert(!std::is_pointer<DataType>::value, "Declare the data itself rather than a pointer to it.");
+        checkNotFrozen();
+        write_set_.insert(&data);
+        return *this;
+    };
+
+    template <typename DataType>
+    DynamicsStage &readsVariable(BaseParticles &particles, const std::string &variable_name)
+    {
+        return reads(*checkVariable(particles.getVariableByName<DataType>(variable_name)));
+    };
+
+    template <typename DataType>
+    DynamicsStage &writesVariable(BaseParticles &particles, const std::string &variable_name)
+    {
+        return writes(*checkVariable(particles.getVariableByName<DataType>(variable_name)));
+    };
+
+    void run(Real dt) { task_(dt); };
+    /** whether this stage must wait for an earlier stage */
+    bool conflictsWith(const DynamicsStage &earlier_stage) const;
+    /** called when the task graph is built */
+    void freeze() { is_frozen_ = true; };
+
+  protected:
+    std::function<void(Real)> task_;
+    std::set<const void *> read_set_;
+    std::set<const void *> write_set_;
+    bool is_frozen_;
+
+    void checkNotFrozen();
+
+    template <typename DataType>
+    StdLargeVec<DataType> *checkVariable(StdLargeVec<DataType> *variable)
+    {
+        if (variable == nullptr)
+        {
+            std::cout << "\n Error: the variable declared for a dynamics stage is not registered!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        return variable;
+    };
+};
+
+/**
+ * @class DynamicsTaskGraph
+ * @brief Executes the stages in an order respecting their data dependence.
+ *		  The graph is built at the first execution, after which no stage can be added or changed,
+ *		  and the same time step size is given to all stages.
+ *		  Reduce dynamics can be added as a task which writes its result, e.g.
+ *		  addStage([&](Real dt) { Dt = get_time_step_size.exec(); }).writes(Dt).
+ */
+class DynamicsTaskGraph
+{
+  public:
+    DynamicsTaskGraph(){};
+    virtual ~DynamicsTaskGraph(){};
+
+    DynamicsStage &addStage(BaseDynamics<void> &dynamics);
+    DynamicsStage &addStage(const std::function<void(Real)> &task);
+    void exec(Real dt = 0.0);
+    size_t NumberOfStages() { return stages_.size(); };
+    size_t NumberOfDependencies();
+
+  protected:
+    UniquePtrsKeeper<DynamicsStage> stage_ptrs_;
+    StdVec<DynamicsStage *> stages_;
+    StdVec<std::pair<size_t, size_t>> dependencies_;
+    Real dt_ = 0.0;
+    bool is_built_ = false;
+
+    /** the nodes are declared after the graph, as they have to be destroyed first */
+    UniquePtr<tbb::flow::graph> flow_graph_;
+    UniquePtr<tbb::flow::broadcast_node<tbb::flow::continue_msg>> start_node_;
+    StdVec<UniquePtr<tbb::flow::continue_node<tbb::flow::continue_msg>>> nodes_;
+
+    void buildGraph();
+};
+} // namespace SPH
+#endif // DYNAMICS_TASK_GRAPH_H
@@ -55,7 +55,7 @@ void EmitterInflowCondition ::update(size_t unsorted_index_i, Real dt)
 EmitterInflowInjection::EmitterInflowInjection(BodyAlignedBoxByParticle &aligned_box_part,
                                                size_t body_buffer_width, int axis)
     : BaseLocalDynamics<BodyPartByParticle>(aligned_box_part), FluidDataSimple(sph_body_),
-      fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
+      buffer_particle_manager_(*particles_), fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
       pos_(particles_->pos_), rho_(particles_->rho_),
       p_(*particles_->getVariableByName<Real>("Pressure")),
       axis_(axis), aligned_box_(aligned_box_part.aligned_box_)
@@ -70,19 +70,9 @@ void EmitterInflowInjection::update(size_t unsorted_index_i, Real dt)
     size_t sorted_index_i = sorted_id_[unsorted_index_i];
     if (aligned_box_.checkUpperBound(axis_, pos_[sorted_index_i]))
     {
-        mutex_switch_to_real_.lock();
-        if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
-        {
-            std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
-                      << "Not enough body buffer particles! Exit the code."
-                      << "\n";
-            exit(0);
-        }
         /** Buffer Particle state copied from real particle. */
-        particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-        /** Realize the buffer particle by increasing the number of real particle in the body.  */
-        particles_->total_real_particles_ += 1;
-        mutex_switch_to_real_.unlock();
+        size_t buffer_index = buffer_particle_manager_.reserveBufferParticle();
+        particles_->copyFromAnotherParticle(buffer_index, sorted_index_i);
         /** Periodic bounding. */
         pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[sorted_index_i]);
         rho_[sorted_index_i] = fluid_.ReferenceDensity();
@@ -90,19 +80,29 @@ void EmitterInflowInjection::update(size_t unsorted_index_i, Real dt)
     }
 }
 //=================================================================================================//
+void EmitterInflowInjection::finishDynamics(Real dt)
+{
+    /** Realize the buffer particles by increasing the number of real particle in the body.  */
+    buffer_particle_manager_.realizeReservedParticles();
+}
+//=================================================================================================//
 DisposerOutflowDeletion::
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part, int axis)
     : BaseLocalDynamics<BodyPartByCell>(aligned_box_part), FluidDataSimple(sph_body_),
-      pos_(particles_->pos_), axis_(axis), aligned_box_(aligned_box_part.aligned_box_) {}
+      buffer_particle_manager_(*particles_), pos_(particles_->pos_),
+      axis_(axis), aligned_box_(aligned_box_part.aligned_box_) {}
 //=================================================================================================//
 void DisposerOutflowDeletion::update(size_t index_i, Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
+    if (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
     {
-        particles_->switchToBufferParticle(index_i);
+        buffer_particle_manager_.addDeletionCandidate(index_i);
     }
-    mutex_switch_to_buffer_.unlock();
+}
+//=================================================================================================//
+void DisposerOutflowDeletion::finishDynamics(Real dt)
+{
+    buffer_particle_manager_.switchCandidatesToBufferParticles();
 }
 } // namespace fluid_dynamics
 } // namespace SPH
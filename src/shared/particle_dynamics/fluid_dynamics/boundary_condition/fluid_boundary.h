@@ -31,7 +31,7 @@
 #define FLUID_BOUNDARY_H
 
 #include "base_fluid_dynamics.h"
-#include <mutex>
+#include "buffer_particle_manager.h"
 
 namespace SPH
 {
@@ -206,6 +206,7 @@ class EmitterInflowCondition : public BaseLocalDynamics<BodyPartByParticle>, pub
 /**
  * @class EmitterInflowInjection
  * @brief Inject particles into the computational domain.
+ * The buffer particles are reserved without locking and realized after the particle loop.
  * Note that the axis is at the local coordinate and upper bound direction is
  * the local positive direction.
  */
@@ -217,9 +218,10 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
     virtual ~EmitterInflowInjection(){};
 
     void update(size_t unsorted_index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
+    BufferParticleManager buffer_particle_manager_;
     Fluid &fluid_;
     StdLargeVec<Vecd> &pos_;
     StdLargeVec<Real> &rho_, &p_;
@@ -230,6 +232,7 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
 /**
  * @class DisposerOutflowDeletion
  * @brief Delete particles who ruing out the computational domain.
+ * The particles are collected in the particle loop and switched to buffer particles in a batch.
  */
 class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public FluidDataSimple
 {
@@ -238,9 +241,10 @@ class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public
     virtual ~DisposerOutflowDeletion(){};
 
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
+    BufferParticleManager buffer_particle_manager_;
     StdLargeVec<Vecd> &pos_;
     const int axis_; /**< the axis direction for bounding*/
     AlignedBoxShape &aligned_box_;
@@ -87,6 +87,28 @@ using Integration1stHalfInnerNoRiemann = Integration1stHalf<Inner<>, NoRiemannSo
 using Integration1stHalfInnerRiemann = Integration1stHalf<Inner<>, AcousticRiemannSolver, NoKernelCorrection>;
 using Integration1stHalfCorrectionInnerRiemann = Integration1stHalf<Inner<>, AcousticRiemannSolver, KernelCorrection>;
 
+/**
+ * @class Integration1stHalf<Inner<PairSymmetric>, RiemannSolverType, KernelCorrectionType>
+ * @brief The pressure force and the density change rate evaluated once for each pair
+ * with HalfInnerRelation and Dynamics1LevelPairSymmetric.
+ * The contributions of a pair are added to both particles,
+ * so that the result is the same as that of Integration1stHalf<Inner<>, ...>.
+ */
+template <class RiemannSolverType, class KernelCorrectionType>
+class Integration1stHalf<Inner<PairSymmetric>, RiemannSolverType, KernelCorrectionType>
+    : public Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>
+{
+  public:
+    explicit Integration1stHalf(HalfInnerRelation &half_inner_relation);
+    virtual ~Integration1stHalf(){};
+    void initialization(size_t index_i, Real dt = 0.0);
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Real> &Vol_;
+};
+using Integration1stHalfPairSymmetricInnerRiemann = Integration1stHalf<Inner<PairSymmetric>, AcousticRiemannSolver, NoKernelCorrection>;
+
 // The following is used to avoid the C3200 error triggered in Visual Studio.
 // Please refer: https://developercommunity.visualstudio.com/t/c-invalid-template-argument-for-template-parameter/831128
 using BaseIntegrationWithWall = InteractionWithWall<BaseIntegration>;
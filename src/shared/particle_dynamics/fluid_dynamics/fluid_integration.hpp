@@ -73,6 +73,49 @@ void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::inter
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType>
+Integration1stHalf<Inner<PairSymmetric>, RiemannSolverType, KernelCorrectionType>::
+    Integration1stHalf(HalfInnerRelation &half_inner_relation)
+    : Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>(half_inner_relation),
+      Vol_(this->particles_->Vol_) {}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<PairSymmetric>, RiemannSolverType, KernelCorrectionType>::
+    initialization(size_t index_i, Real dt)
+{
+    Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::initialization(index_i, dt);
+    // the density change rate is accumulated from the pairs of both particles
+    this->drho_dt_[index_i] = 0.0;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<PairSymmetric>, RiemannSolverType, KernelCorrectionType>::
+    interaction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    Real rho_dissipation(0);
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+        // the kernel gradient weighted by the volume of particle i, as in the neighborhood of particle j
+        Real dW_ijV_i = dW_ijV_j * Vol_[index_i] / Vol_[index_j];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+        Vecd pressure_e_ij = (this->p_[index_i] * this->correction_(index_i) +
+                              this->p_[index_j] * this->correction_(index_j)) *
+                             e_ij;
+        force -= this->mass_[index_i] * pressure_e_ij * dW_ijV_j;
+        this->force_[index_j] += this->mass_[index_j] * pressure_e_ij * dW_ijV_i / this->rho_[index_j];
+        rho_dissipation += this->riemann_solver_.DissipativeUJump(this->p_[index_i] - this->p_[index_j]) * dW_ijV_j;
+        this->drho_dt_[index_j] += this->riemann_solver_.DissipativeUJump(this->p_[index_j] - this->p_[index_i]) *
+                                   dW_ijV_i * this->rho_[index_j];
+    }
+    this->force_[index_i] += force / this->rho_[index_i];
+    this->drho_dt_[index_i] += rho_dissipation * this->rho_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
 Integration1stHalf<Contact<Wall>, RiemannSolverType, KernelCorrectionType>::
     Integration1stHalf(BaseContactRelation &wall_contact_relation)
     : BaseIntegrationWithWall(wall_contact_relation),
@@ -22,6 +22,25 @@ void ViscousAcceleration<Inner<>>::interaction(size_t index_i, Real dt)
     force_prior_[index_i] += force / rho_[index_i];
 }
 //=================================================================================================//
+void ViscousAcceleration<Inner<PairSymmetric>>::interaction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        // the kernel gradient weighted by the volume of particle i, as in the neighborhood of particle j
+        Real dW_ijV_i = inner_neighborhood.dW_ijV_j_[n] * Vol_[index_i] / Vol_[index_j];
+
+        // viscous force
+        Vecd vel_derivative = (vel_[index_i] - vel_[index_j]) / (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+        force += 2.0 * mass_[index_i] * mu_ * vel_derivative * inner_neighborhood.dW_ijV_j_[n];
+        force_prior_[index_j] -= 2.0 * mass_[index_j] * mu_ * vel_derivative * dW_ijV_i / rho_[index_j];
+    }
+
+    force_prior_[index_i] += force / rho_[index_i];
+}
+//=================================================================================================//
 void ViscousAcceleration<AngularConservative<Inner<>>>::interaction(size_t index_i, Real dt)
 {
     Vecd force = Vecd::Zero();
@@ -66,6 +66,25 @@ class ViscousAcceleration<Inner<>> : public ViscousAcceleration<FluidDataInner>
 };
 using ViscousAccelerationInner = ViscousAcceleration<Inner<>>;
 
+/**
+ * @class ViscousAcceleration<Inner<PairSymmetric>>
+ * @brief The viscous force evaluated once for each pair with HalfInnerRelation and InteractionPairSymmetric.
+ * The pair force is added to particle i and the opposite one to particle j,
+ * so that the result is the same as that of ViscousAcceleration<Inner<>>.
+ */
+template <>
+class ViscousAcceleration<Inner<PairSymmetric>> : public ViscousAcceleration<FluidDataInner>
+{
+  public:
+    explicit ViscousAcceleration(HalfInnerRelation &half_inner_relation)
+        : ViscousAcceleration<FluidDataInner>(half_inner_relation), Vol_(particles_->Vol_){};
+    virtual ~ViscousAcceleration(){};
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Real> &Vol_;
+};
+
 template <>
 class ViscousAcceleration<AngularConservative<Inner<>>>
     : public ViscousAcceleration<FluidDataInner>
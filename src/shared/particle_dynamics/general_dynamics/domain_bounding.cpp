@@ -18,7 +18,7 @@ void PeriodicConditionUsingCellLinkedList::
     {
         Vecd particle_position = std::get<1>(cell_list_data[num]);
         if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-            particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+            particle_position[axis_] > (bounding_bounds_.second_[axis_] - image_band_width_))
         {
             Vecd translated_position = particle_position - periodic_translation_;
             /** insert ghost particle to cell linked list */
@@ -37,7 +37,7 @@ void PeriodicConditionUsingCellLinkedList::
     {
         Vecd particle_position = std::get<1>(cell_list_data[num]);
         if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-            particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
+            particle_position[axis_] < (bounding_bounds_.first_[axis_] + image_band_width_))
         {
             Vecd translated_position = particle_position + periodic_translation_;
             /** insert ghost particle to cell linked list */
@@ -49,6 +49,20 @@ void PeriodicConditionUsingCellLinkedList::
     }
 }
 //=================================================================================================//
+void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::setupDynamics(Real dt)
+{
+    Real skin_width = cell_linked_list_.NeighborSkinWidth();
+    // the tagged bounding cells cover two cell layers, i.e. at least twice the cut-off radius
+    if (skin_width > cut_off_radius_max_)
+    {
+        std::cout << "\n Error: the neighbor skin of " << sph_body_.getName()
+                  << " is wider than the cut-off radius, which is not supported by the periodic condition!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    image_band_width_ = cut_off_radius_max_ + skin_width;
+}
+//=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::exec(Real dt)
 {
     setupDynamics(dt);
@@ -70,40 +84,56 @@ void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::setupDyn
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-        particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
+    Real particle_position = pos_[index_i][axis_];
+    if (particle_position > bounding_bounds_.first_[axis_] &&
+        particle_position < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
     {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[0].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position + periodic_translation_;
-        /** insert ghost particle to cell linked list */
-        cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
+        ghost_candidates_[0].push_back(index_i);
     }
 }
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-        particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+    Real particle_position = pos_[index_i][axis_];
+    if (particle_position < bounding_bounds_.second_[axis_] &&
+        particle_position > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+    {
+        ghost_candidates_[1].push_back(index_i);
+    }
+}
+//=================================================================================================//
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::
+    insertGhostParticles(size_t bound_index, const Vecd &translation)
+{
+    IndexVector &ghost_particles = ghost_particles_[bound_index];
+    buffer_particle_manager_.insertGhostParticles(ghost_candidates_[bound_index], ghost_particles);
+    particle_for(execution::ParallelPolicy(), ghost_particles,
+                 [&](size_t i)
+                 { pos_[i] += translation; });
+    /** insert ghost particle to cell linked list */
+    for (size_t ghost_particle_index : ghost_particles)
     {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[1].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position - periodic_translation_;
-        /** insert ghost particle to cell linked list */
         cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
+                                              pos_[ghost_particle_index], Vol_[ghost_particle_index]);
     }
 }
 //=================================================================================================//
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::exec(Real dt)
+{
+    setupDynamics(dt);
+
+    particle_for(execution::ParallelPolicy(), bound_cells_data_[0].first,
+                 [&](size_t i)
+                 { checkLowerBound(i, dt); });
+
+    particle_for(execution::ParallelPolicy(), bound_cells_data_[1].first,
+                 [&](size_t i)
+                 { checkUpperBound(i, dt); });
+
+    insertGhostParticles(0, periodic_translation_);
+    insertGhostParticles(1, -periodic_translation_);
+}
+//=================================================================================================//
 void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 {
     particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
@@ -30,6 +30,7 @@
 #define DOMAIN_BOUNDING_H
 
 #include "base_general_dynamics.h"
+#include "buffer_particle_manager.h"
 
 namespace SPH
 {
@@ -155,6 +156,8 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
         std::mutex mutex_cell_list_entry_; /**< mutex exclusion for memory conflict */
         Vecd &periodic_translation_;
         StdVec<CellLists> &bound_cells_data_;
+        Real image_band_width_; /**< the cut-off radius extended by the neighbor skin */
+        virtual void setupDynamics(Real dt = 0.0) override;
         virtual void checkLowerBound(ListDataVector &cell_list_data, Real dt = 0.0);
         virtual void checkUpperBound(ListDataVector &cell_list_data, Real dt = 0.0);
 
@@ -164,7 +167,7 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
                                RealBody &real_body, BoundingBox bounding_bounds, int axis)
             : BoundingAlongAxis(real_body, bounding_bounds, axis),
               periodic_translation_(periodic_translation),
-              bound_cells_data_(bound_cells_data){};
+              bound_cells_data_(bound_cells_data), image_band_width_(cut_off_radius_max_){};
         ;
         virtual ~PeriodicCellLinkedList(){};
 
@@ -204,12 +207,15 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
     class CreatPeriodicGhostParticles : public PeriodicBounding
     {
       protected:
-        std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
+        BufferParticleManager buffer_particle_manager_;
+        StdVec<ConcurrentIndexVector> ghost_candidates_; /**< real particles to be copied as lower and upper ghosts */
         StdVec<IndexVector> &ghost_particles_;
         StdLargeVec<Real> &Vol_;
         virtual void setupDynamics(Real dt = 0.0) override;
         virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
         virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+        /** add the collected ghost particles in a batch and insert them to cell linked list */
+        void insertGhostParticles(size_t bound_index, const Vecd &translation);
 
       public:
         CreatPeriodicGhostParticles(Vecd &periodic_translation,
@@ -217,8 +223,11 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
                                     StdVec<IndexVector> &ghost_particles,
                                     RealBody &real_body, BoundingBox bounding_bounds, int axis)
             : PeriodicBounding(periodic_translation, bound_cells_data, real_body, bounding_bounds, axis),
+              buffer_particle_manager_(*particles_), ghost_candidates_(2),
               ghost_particles_(ghost_particles), Vol_(particles_->Vol_){};
         virtual ~CreatPeriodicGhostParticles(){};
+
+        virtual void exec(Real dt = 0.0) override;
     };
 
     /**
@@ -29,6 +29,8 @@
  * 			SimpleDynamics is without particle interaction. Particles just update their states;
  *			InteractionDynamics is with particle interaction with its neighbors;
  *			InteractionSplit is InteractionDynamics but using spliting algorithm;
+ *			InteractionPairSymmetric is InteractionDynamics evaluating each pair once with half neighbor lists;
+ *			Dynamics1LevelPairSymmetric is Dynamics1Level with the interaction of InteractionPairSymmetric;
  *			InteractionWithUpdate is with particle interaction with its neighbors and then update their states;
  *			Dynamics1Level is the most complex dynamics, has successive three steps: initialization, interaction and update.
  *			In order to avoid misusing of the above algorithms, type traits are used to make sure that the matching between
@@ -39,6 +41,8 @@
  *			There are 2 classes for the second type.
  *			ReduceDynamics carries out a reduce operation through the particles.
  *			Average further computes average of a ReduceDynamics for summation.
+ *			FusedDynamics carries out the update of a dynamics and a following ReduceDynamics
+ *			in a single traversal of the particles.
  *			Each particle dynamics is templated with a LocalDynamics and a DynamicsRange.
  *			The local dynamics defines the behavior of a single particle or with its neighbors,
  *			and is recognized by particle dynamics with the signature functions, like update, initialization and interaction.
@@ -53,6 +57,7 @@
 #include "base_local_dynamics.h"
 #include "base_particle_dynamics.hpp"
 #include "particle_iterators.h"
+#include "profiling_registry.h"
 
 #include <type_traits>
 
@@ -88,11 +93,32 @@ struct has_update<T, std::void_t<decltype(&T::update)>> : std::true_type
 {
 };
 
+template <class T, class = void>
+struct has_reduce : std::false_type
+{
+};
+
+template <class T>
+struct has_reduce<T, std::void_t<decltype(&T::reduce)>> : std::true_type
+{
+};
+
+/** whether the local dynamics overrides the empty finishDynamics of BaseLocalDynamics */
+template <class T>
+struct has_finish_dynamics
+    : std::integral_constant<
+          bool, !std::is_same<decltype(&T::finishDynamics),
+                              decltype(&BaseLocalDynamics<typename std::remove_reference<
+                                           decltype(std::declval<T &>().getDynamicsIdentifier())>::type>::finishDynamics)>::value>
+{
+};
+
 using namespace execution;
 
 /**
  * @class SimpleDynamics
- * @brief Simple particle dynamics without considering particle interaction
+ * @brief Simple particle dynamics without considering particle interaction.
+ * 		  The global operations after the particle loop, if any, are carried out in finishDynamics.
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
 class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
@@ -109,14 +135,22 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
     };
     virtual ~SimpleDynamics(){};
 
-    virtual void exec(Real dt = 0.0) override
+    /** run all steps before the update step, which is empty for simple dynamics. */
+    void runBeforeUpdate(Real dt)
     {
         this->setUpdated();
         this->setupDynamics(dt);
+    };
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
+        runBeforeUpdate(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
                      { this->update(i, dt); });
+        this->finishDynamics(dt);
     };
 };
 
@@ -144,6 +178,7 @@ class ReduceDynamics : public LocalDynamicsType,
 
     virtual ReturnType exec(Real dt = 0.0) override
     {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
         this->setupDynamics(dt);
         ReturnType temp = particle_reduce(ExecutionPolicy(),
                                           this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
@@ -188,6 +223,7 @@ class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<vo
 
     virtual void exec(Real dt = 0.0) override
     {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
         this->setUpdated();
         this->setupDynamics(dt);
         runInteraction(dt);
@@ -208,11 +244,8 @@ class InteractionSplit : public BaseInteractionDynamics<LocalDynamicsType, Paral
   public:
     template <typename... Args>
     InteractionSplit(Args &&...args)
-        : BaseInteractionDynamics<LocalDynamicsType, ParallelPolicy>(std::forward<Args>(args)...),
-          real_body_(DynamicCast<RealBody>(this, this->getSPHBody())),
-          split_cell_lists_(real_body_.getSplitCellLists())
+        : InteractionSplit(true, std::forward<Args>(args)...)
     {
-        real_body_.setUseSplitCellLists();
         static_assert(!has_initialize<LocalDynamicsType>::value &&
                           !has_update<LocalDynamicsType>::value,
                       "LocalDynamicsType does not fulfill InteractionSplit requirements");
@@ -227,6 +260,16 @@ class InteractionSplit : public BaseInteractionDynamics<LocalDynamicsType, Paral
                      [&](size_t i)
                      { this->interaction(i, dt * 0.5); });
     }
+
+  protected:
+    template <typename... Args>
+    InteractionSplit(bool mostDerived, Args &&...args)
+        : BaseInteractionDynamics<LocalDynamicsType, ParallelPolicy>(std::forward<Args>(args)...),
+          real_body_(DynamicCast<RealBody>(this, this->getSPHBody())),
+          split_cell_lists_(real_body_.getSplitCellLists())
+    {
+        real_body_.setUseSplitCellLists();
+    };
 };
 
 /**
@@ -262,6 +305,77 @@ class InteractionDynamics : public BaseInteractionDynamics<LocalDynamicsType, Ex
         : BaseInteractionDynamics<LocalDynamicsType, ExecutionPolicy>(std::forward<Args>(args)...){};
 };
 
+/**
+ * @class InteractionPairSymmetric
+ * @brief This is for the local dynamics with a half neighbor list, i.e. HalfInnerRelation,
+ * which evaluates each pair once and adds the contribution to both particles.
+ * Different from InteractionSplit, the particles are swept once, color by color,
+ * so that no two particles updated concurrently share a neighbor.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class InteractionPairSymmetric : public InteractionSplit<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    InteractionPairSymmetric(Args &&...args)
+        : InteractionPairSymmetric(true, std::forward<Args>(args)...)
+    {
+        static_assert(!has_initialize<LocalDynamicsType>::value &&
+                          !has_update<LocalDynamicsType>::value,
+                      "LocalDynamicsType does not fulfill InteractionPairSymmetric requirements");
+    };
+    virtual ~InteractionPairSymmetric(){};
+
+    /** run the main interaction step between particles. */
+    virtual void runMainStep(Real dt) override
+    {
+        colored_particle_for(ExecutionPolicy(),
+                             this->split_cell_lists_,
+                             [&](size_t i)
+                             { this->interaction(i, dt); });
+    }
+
+  protected:
+    template <typename... Args>
+    InteractionPairSymmetric(bool mostDerived, Args &&...args)
+        : InteractionSplit<LocalDynamicsType, ExecutionPolicy>(false, std::forward<Args>(args)...){};
+};
+
+/**
+ * @class Dynamics1LevelPairSymmetric
+ * @brief This class includes the initialization, the pair-symmetric interaction and the update steps.
+ * The initialization is done for all particles before the interaction,
+ * as the interaction of a particle also changes its neighbors.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class Dynamics1LevelPairSymmetric : public InteractionPairSymmetric<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    Dynamics1LevelPairSymmetric(Args &&...args)
+        : InteractionPairSymmetric<LocalDynamicsType, ExecutionPolicy>(false, std::forward<Args>(args)...){};
+    virtual ~Dynamics1LevelPairSymmetric(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
+        this->setUpdated();
+        this->setupDynamics(dt);
+
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i)
+                     { this->initialization(i, dt); });
+
+        this->runInteraction(dt);
+
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i)
+                     { this->update(i, dt); });
+    };
+};
+
 /**
  * @class InteractionWithUpdate
  * @brief This class includes an interaction and a update steps
@@ -279,9 +393,18 @@ class InteractionWithUpdate : public InteractionDynamics<LocalDynamicsType, Exec
     }
     virtual ~InteractionWithUpdate(){};
 
+    /** run all steps before the update step. */
+    void runBeforeUpdate(Real dt)
+    {
+        this->setUpdated();
+        this->setupDynamics(dt);
+        this->runInteraction(dt);
+    };
+
     virtual void exec(Real dt = 0.0) override
     {
-        InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
+        runBeforeUpdate(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
@@ -308,11 +431,14 @@ class InteractionWithInitialization : public InteractionDynamics<LocalDynamicsTy
 
     virtual void exec(Real dt = 0.0) override
     {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
                      { this->initialization(i, dt); });
-        InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
+        this->setUpdated();
+        this->setupDynamics(dt);
+        this->runInteraction(dt);
     };
 };
 
@@ -332,7 +458,8 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
               false, std::forward<Args>(args)...) {}
     virtual ~Dynamics1Level(){};
 
-    virtual void exec(Real dt = 0.0) override
+    /** run all steps before the update step, i.e. initialization and interaction. */
+    void runBeforeUpdate(Real dt)
     {
         this->setUpdated();
         this->setupDynamics(dt);
@@ -343,6 +470,12 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
                      { this->initialization(i, dt); });
 
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::runInteraction(dt);
+    };
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        ScopedProfiling profiling(this->identifier_, typeid(LocalDynamicsType));
+        runBeforeUpdate(dt);
 
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
@@ -350,5 +483,69 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
                      { this->update(i, dt); });
     };
 };
+
+/**
+ * @class FusedDynamics
+ * @brief Carries out the update step of a particle dynamics, i.e. SimpleDynamics, InteractionWithUpdate
+ * or Dynamics1Level, and the reduce of a following ReduceDynamics in a single traversal of the particles.
+ * This is possible because both the update and the reduce of a particle only access the data of
+ * the particle itself, so that the reduce of a particle sees exactly the same data as when it is
+ * carried out in a separate loop after the update. Both dynamics should have the same dynamics identifier,
+ * and setupDynamics of the reduce is called before the fused loop.
+ * An update with finishDynamics, e.g. realizing or deleting buffer particles after the loop, is not accepted,
+ * as the reduce would then see the particles before the global operations.
+ * The two dynamics are still usable separately. A typical usage is:
+ * 		FusedDynamics<Dynamics1Level<fluid_dynamics::Integration2ndHalfRiemann>,
+ * 					  ReduceDynamics<fluid_dynamics::AcousticTimeStepSize>>
+ * 			fused_density_relaxation(fluid_density_relaxation, fluid_acoustic_time_step);
+ * 		Real dt = fluid_acoustic_time_step.exec();
+ * 		...
+ * 		fluid_pressure_relaxation.exec(dt);
+ * 		dt = fused_density_relaxation.exec(dt);
+ */
+template <class UpdateDynamicsType, class ReduceDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class FusedDynamics : public BaseDynamics<typename ReduceDynamicsType::ReduceReturnType>
+{
+    using ReturnType = typename ReduceDynamicsType::ReduceReturnType;
+    UpdateDynamicsType &update_dynamics_;
+    ReduceDynamicsType &reduce_dynamics_;
+
+  public:
+    FusedDynamics(UpdateDynamicsType &update_dynamics, ReduceDynamicsType &reduce_dynamics)
+        : BaseDynamics<ReturnType>(update_dynamics.getSPHBody()),
+          update_dynamics_(update_dynamics), reduce_dynamics_(reduce_dynamics)
+    {
+        static_assert(has_update<UpdateDynamicsType>::value && has_reduce<ReduceDynamicsType>::value,
+                      "UpdateDynamicsType or ReduceDynamicsType does not fulfill FusedDynamics requirements");
+        static_assert(!has_finish_dynamics<UpdateDynamicsType>::value,
+                      "FusedDynamics does not support an UpdateDynamicsType with finishDynamics");
+        static_assert(std::is_same<decltype(update_dynamics.getDynamicsIdentifier()),
+                                   decltype(reduce_dynamics.getDynamicsIdentifier())>::value,
+                      "FusedDynamics requires the same type of dynamics identifier");
+        if (&update_dynamics.getDynamicsIdentifier() != &reduce_dynamics.getDynamicsIdentifier())
+        {
+            std::cout << "\n Error: FusedDynamics requires the same dynamics identifier for the fused dynamics!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+    virtual ~FusedDynamics(){};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        ScopedProfiling profiling(update_dynamics_.getDynamicsIdentifier(), typeid(FusedDynamics));
+        update_dynamics_.runBeforeUpdate(dt);
+        reduce_dynamics_.setupDynamics(dt);
+        ReturnType temp = particle_reduce(ExecutionPolicy(),
+                                          reduce_dynamics_.getDynamicsIdentifier().LoopRange(),
+                                          reduce_dynamics_.Reference(), reduce_dynamics_.getOperation(),
+                                          [&](size_t i) -> ReturnType
+                                          {
+                                              update_dynamics_.update(i, dt);
+                                              return reduce_dynamics_.reduce(i, dt);
+                                          });
+        return reduce_dynamics_.outputResult(temp);
+    };
+};
 } // namespace SPH
 #endif // PARTICLE_DYNAMICS_ALGORITHMS_H
@@ -242,6 +242,53 @@ inline void particle_for(const ParallelPolicy &par, const SplitCellLists &split_
     }
 }
 
+/**
+ * Colored iterators on split cell lists with a single forward sweep (for sequential and parallel computing).
+ * As the cells of the same color are separated by two cells of other colors,
+ * a particle may also update its neighbors, which are in the adjacent cells, without data race.
+ */
+template <class LocalDynamicsFunction>
+inline void colored_particle_for(const SequencedPolicy &seq, const SplitCellLists &split_cell_lists,
+                                 const LocalDynamicsFunction &local_dynamics_function)
+{
+    for (size_t k = 0; k != split_cell_lists.size(); ++k)
+    {
+        const ConcurrentCellLists &cell_lists = split_cell_lists[k];
+        for (size_t l = 0; l != cell_lists.size(); ++l)
+        {
+            const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
+            for (size_t i = 0; i != particle_indexes.size(); ++i)
+            {
+                local_dynamics_function(particle_indexes[i]);
+            }
+        }
+    }
+}
+
+template <class LocalDynamicsFunction>
+inline void colored_particle_for(const ParallelPolicy &par, const SplitCellLists &split_cell_lists,
+                                 const LocalDynamicsFunction &local_dynamics_function)
+{
+    for (size_t k = 0; k != split_cell_lists.size(); ++k)
+    {
+        const ConcurrentCellLists &cell_lists = split_cell_lists[k];
+        parallel_for(
+            IndexRange(0, cell_lists.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t l = r.begin(); l < r.end(); ++l)
+                {
+                    const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
+                    for (size_t i = 0; i < particle_indexes.size(); ++i)
+                    {
+                        local_dynamics_function(particle_indexes[i]);
+                    }
+                }
+            },
+            ap);
+    }
+}
+
 template <class ExecutionPolicy, typename DynamicsRange, class ReturnType,
           typename Operation, class LocalDynamicsFunction>
 void particle_reduce(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
@@ -180,6 +180,26 @@ class Integration1stHalf : public BaseIntegration1stHalf
     virtual ~Integration1stHalf(){};
 
     inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        interactionWithDamping(index_i, [&](Real strain_rate)
+                               { return PairNumericalDamping(strain_rate); });
+    };
+
+  protected:
+    StdLargeVec<Matd> stress_PK1_B_;
+    Real numerical_dissipation_factor_;
+    Real inv_W0_ = 1.0 / sph_body_.sph_adaptation_->getKernel()->W0(ZeroVecd);
+
+    /** hidden by the derived classes with a typed material */
+    inline Real PairNumericalDamping(Real strain_rate)
+    {
+        return elastic_solid_.PairNumericalDamping(strain_rate, smoothing_length_);
+    };
+
+    /** the interaction with the pair numerical damping given as a template hook,
+     *  so that the damping of a given material type can be inlined */
+    template <typename PairNumericalDampingFunction>
+    inline void interactionWithDamping(size_t index_i, const PairNumericalDampingFunction &pair_numerical_damping)
     {
         // including gravity and force from fluid
         Vecd force = Vecd::Zero();
@@ -195,7 +215,7 @@ class Integration1stHalf : public BaseIntegration1stHalf
             Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
             Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
             Matd numerical_stress_ij =
-                0.5 * (F_[index_i] + F_[index_j]) * elastic_solid_.PairNumericalDamping(strain_rate, smoothing_length_);
+                0.5 * (F_[index_i] + F_[index_j]) * pair_numerical_damping(strain_rate);
             force += mass_[index_i] * inv_rho0_ * inner_neighborhood.dW_ijV_j_[n] *
                             (stress_PK1_B_[index_i] + stress_PK1_B_[index_j] +
                              numerical_dissipation_factor_ * weight * numerical_stress_ij) *
@@ -204,11 +224,6 @@ class Integration1stHalf : public BaseIntegration1stHalf
 
         force_[index_i] = force;
     };
-
-  protected:
-    StdLargeVec<Matd> stress_PK1_B_;
-    Real numerical_dissipation_factor_;
-    Real inv_W0_ = 1.0 / sph_body_.sph_adaptation_->getKernel()->W0(ZeroVecd);
 };
 
 /**
@@ -223,6 +238,56 @@ class Integration1stHalfPK2 : public Integration1stHalf
     void initialization(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class Integration1stHalfPK2WithMaterial
+ * @brief Using PK2 stress constitute relation with the material type as template parameter,
+ * 		  so that the constitutive law and the pair numerical damping are called
+ * 		  without virtual dispatch and can be inlined into the particle loops.
+ * 		  The material of the body should be of ElasticSolidType or derived from it.
+ * 		  For a derived material, which may override the constitutive law, the virtual functions are called.
+ */
+template <class ElasticSolidType>
+class Integration1stHalfPK2WithMaterial : public Integration1stHalf
+{
+  public:
+    explicit Integration1stHalfPK2WithMaterial(BaseInnerRelation &inner_relation)
+        : Integration1stHalf(inner_relation),
+          typed_material_(DynamicCast<ElasticSolidType>(this, elastic_solid_)),
+          is_exact_material_type_(typeid(elastic_solid_) == typeid(ElasticSolidType)){};
+    virtual ~Integration1stHalfPK2WithMaterial(){};
+
+    inline void initialization(size_t index_i, Real dt = 0.0)
+    {
+        pos_[index_i] += vel_[index_i] * dt * 0.5;
+        F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+        rho_[index_i] = rho0_ / F_[index_i].determinant();
+        stress_PK1_B_[index_i] = F_[index_i] * StressPK2(F_[index_i], index_i) * B_[index_i].transpose();
+    };
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        interactionWithDamping(index_i, [&](Real strain_rate)
+                               { return PairNumericalDamping(strain_rate); });
+    };
+
+  protected:
+    ElasticSolidType &typed_material_;
+    bool is_exact_material_type_;
+
+    inline Matd StressPK2(Matd &F, size_t index_i)
+    {
+        return is_exact_material_type_ ? typed_material_.ElasticSolidType::StressPK2(F, index_i)
+                                       : typed_material_.StressPK2(F, index_i);
+    };
+
+    inline Real PairNumericalDamping(Real strain_rate)
+    {
+        return is_exact_material_type_
+                   ? typed_material_.ElasticSolidType::PairNumericalDamping(strain_rate, smoothing_length_)
+                   : typed_material_.PairNumericalDamping(strain_rate, smoothing_length_);
+    };
+};
+
 /** @class Integration1stHalfCauchy
  * @brief Using Cauchy stress constitute relation
  */
@@ -246,6 +311,63 @@ class Integration1stHalfKirchhoff : public Integration1stHalf
     void initialization(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class Integration1stHalfPairSymmetric
+ * @brief The stress relaxation evaluated once for each pair
+ * with HalfInnerRelation and Dynamics1LevelPairSymmetric.
+ * The stress is computed by the initialization of the given Integration1stHalf type.
+ * The pair force is added to particle i and the opposite one to particle j,
+ * so that the result is the same as that of the given Integration1stHalf type.
+ */
+template <class Integration1stHalfType = Integration1stHalfPK2>
+class Integration1stHalfPairSymmetric : public Integration1stHalfType
+{
+  public:
+    explicit Integration1stHalfPairSymmetric(HalfInnerRelation &half_inner_relation)
+        : Integration1stHalfType(half_inner_relation), Vol_(this->particles_->Vol_){};
+    virtual ~Integration1stHalfPairSymmetric(){};
+
+    inline void initialization(size_t index_i, Real dt = 0.0)
+    {
+        Integration1stHalfType::initialization(index_i, dt);
+        // the force is accumulated from the pairs of both particles
+        this->force_[index_i] = Vecd::Zero();
+    };
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        Vecd force = Vecd::Zero();
+        const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = inner_neighborhood.j_[n];
+            Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+            // the kernel gradient weighted by the volume of particle i, as in the neighborhood of particle j
+            Real dW_ijV_i = dW_ijV_j * Vol_[index_i] / Vol_[index_j];
+            const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+            Real r_ij = inner_neighborhood.r_ij_[n];
+            Real dim_r_ij_1 = Dimensions / r_ij;
+            Vecd pos_jump = this->pos_[index_i] - this->pos_[index_j];
+            Vecd vel_jump = this->vel_[index_i] - this->vel_[index_j];
+            // the strain rate, the weight and the numerical stress are the same for both particles
+            Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
+            Real weight = inner_neighborhood.W_ij_[n] * this->inv_W0_;
+            Matd numerical_stress_ij = 0.5 * (this->F_[index_i] + this->F_[index_j]) *
+                                       Integration1stHalfType::PairNumericalDamping(strain_rate);
+            Vecd stress_e_ij = (this->stress_PK1_B_[index_i] + this->stress_PK1_B_[index_j] +
+                                this->numerical_dissipation_factor_ * weight * numerical_stress_ij) *
+                               e_ij * this->inv_rho0_;
+            force += this->mass_[index_i] * dW_ijV_j * stress_e_ij;
+            this->force_[index_j] -= this->mass_[index_j] * dW_ijV_i * stress_e_ij;
+        }
+
+        this->force_[index_i] += force;
+    };
+
+  protected:
+    StdLargeVec<Real> &Vol_;
+};
+
 /**
  * @class DecomposedIntegration1stHalf
  * @brief Decompose the stress into particle stress includes isotropic stress
@@ -56,8 +56,9 @@ void ObserverParticleGenerator::initializeGeometricVariables()
     }
 }
 //=================================================================================================//
-ParticleGeneratorReload::ParticleGeneratorReload(SPHBody &sph_body, const std::string &reload_body_name)
-    : ParticleGenerator(sph_body)
+ParticleGeneratorReload::ParticleGeneratorReload(SPHBody &sph_body, const std::string &reload_body_name,
+                                                 bool use_binary_format)
+    : ParticleGenerator(sph_body), use_binary_format_(use_binary_format)
 {
     std::string reload_folder = sph_body.getSPHSystem().getIOEnvironment().reload_folder_;
     if (!fs::exists(reload_folder))
@@ -67,12 +68,35 @@ ParticleGeneratorReload::ParticleGeneratorReload(SPHBody &sph_body, const std::s
         exit(1);
     }
 
-    file_path_ = reload_folder + "/" + reload_body_name + "_rld.xml";
+    std::string xml_file_path = reload_folder + "/" + reload_body_name + "_rld.xml";
+    std::string binary_file_path = reload_folder + "/" + reload_body_name + "_rld.bin";
+    file_path_ = use_binary_format_ ? binary_file_path : xml_file_path;
+    if (!fs::exists(file_path_))
+    {
+        std::cout << "\n Error: the particle reload file:" << file_path_ << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    // the reload file of the other format may have been written by a later relaxation
+    std::string other_file_path = use_binary_format_ ? xml_file_path : binary_file_path;
+    if (fs::exists(other_file_path) && fs::last_write_time(other_file_path) > fs::last_write_time(file_path_))
+    {
+        std::cout << "\n Warning: the particle reload file:" << other_file_path
+                  << " is newer than the reloaded file:" << file_path_ << std::endl;
+    }
 }
 //=================================================================================================//
 void ParticleGeneratorReload::initializeGeometricVariables()
 {
-    base_particles_.readFromXmlForReloadParticle(file_path_);
+    if (use_binary_format_)
+    {
+        base_particles_.readFromBinaryForReloadParticle(file_path_);
+    }
+    else
+    {
+        base_particles_.readFromXmlForReloadParticle(file_path_);
+    }
 }
 //=================================================================================================//
 void ParticleGeneratorReload::generateParticlesWithBasicVariables()
@@ -121,13 +121,16 @@ class ObserverParticleGenerator : public ParticleGenerator
 /**
  * @class ParticleGeneratorReload
  * @brief Generate particle by reloading particle position and volume.
+ * The particles are reloaded from the XML file by default,
+ * or from the binary file written by ReloadParticleIO after setUseBinaryFormat.
  */
 class ParticleGeneratorReload : public ParticleGenerator
 {
+    bool use_binary_format_;
     std::string file_path_;
 
   public:
-    ParticleGeneratorReload(SPHBody &sph_body, const std::string &reload_body_name);
+    ParticleGeneratorReload(SPHBody &sph_body, const std::string &reload_body_name, bool use_binary_format = false);
     virtual ~ParticleGeneratorReload(){};
     /** Initialize geometrical variable for reload particles. */
     virtual void initializeGeometricVariables() override;
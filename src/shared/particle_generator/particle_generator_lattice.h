@@ -56,6 +56,11 @@ class BaseParticleGeneratorLattice
     Real lattice_spacing_;      /**< Initial particle spacing. */
     BoundingBox domain_bounds_; /**< Domain bounds. */
     Shape &body_shape_;         /**< Geometry shape for body. */
+
+    /** Find the lattice positions contained by the body shape.
+     *  The lattice is tiled into lines along the last axis, which are checked in parallel.
+     *  The positions are returned in the order of a sequential sweep of the lattice. */
+    void findContainedLatticePositions(StdLargeVec<Vecd> &contained_positions);
 };
 
 /**
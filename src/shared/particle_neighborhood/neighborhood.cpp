@@ -22,6 +22,57 @@ void Neighborhood::removeANeighbor(size_t neighbor_n)
     e_ij_[neighbor_n] = e_ij_[current_size_];
 }
 //=================================================================================================//
+void CompressedNeighborStorage::bindConfiguration(ParticleConfiguration &particle_configuration,
+                                                  size_t total_particles)
+{
+    offsets_.resize(total_particles + 1);
+    offsets_[0] = 0;
+    parallel_scan(
+        IndexRange(0, total_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                sum += particle_configuration[i].current_size_;
+                if (is_final_scan)
+                    offsets_[i + 1] = sum;
+            }
+            return sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+
+    size_t total_neighbors = offsets_[total_particles];
+    if (total_neighbors > j_.size())
+    {
+        size_t new_size = total_neighbors + total_neighbors / 8; // reserved for growing neighbor numbers
+        j_.resize(new_size);
+        W_ij_.resize(new_size);
+        dW_ijV_j_.resize(new_size);
+        r_ij_.resize(new_size);
+        e_ij_.resize(new_size);
+    }
+
+    parallel_for(
+        IndexRange(0, total_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Neighborhood &neighborhood = particle_configuration[i];
+                size_t offset = offsets_[i];
+                neighborhood.j_.bindTo(j_.data() + offset);
+                neighborhood.W_ij_.bindTo(W_ij_.data() + offset);
+                neighborhood.dW_ijV_j_.bindTo(dW_ijV_j_.data() + offset);
+                neighborhood.r_ij_.bindTo(r_ij_.data() + offset);
+                neighborhood.e_ij_.bindTo(e_ij_.data() + offset);
+                neighborhood.allocated_size_ = neighborhood.current_size_;
+                neighborhood.current_size_ = 0;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                      const Vecd &displacement, size_t index_j, const Real &Vol_j)
 {
@@ -78,6 +129,28 @@ Kernel *NeighborBuilder::chooseKernel(SPHBody &body, SPHBody &target_body)
     return kernel->SmoothingLength() > target_kernel->SmoothingLength() ? kernel : target_kernel;
 }
 //=================================================================================================//
+void NeighborBuilderCandidate::operator()(Neighborhood &neighborhood,
+                                          const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    if ((pos_i - std::get<1>(list_data_j)).squaredNorm() < search_radius_sqr_)
+    {
+        size_t index_j = std::get<0>(list_data_j);
+        Vecd shift = std::get<1>(list_data_j) - (*target_pos_)[index_j];
+        if (neighborhood.current_size_ >= neighborhood.allocated_size_)
+        {
+            neighborhood.j_.push_back(index_j);
+            neighborhood.e_ij_.push_back(shift);
+            neighborhood.allocated_size_++;
+        }
+        else
+        {
+            neighborhood.j_[neighborhood.current_size_] = index_j;
+            neighborhood.e_ij_[neighborhood.current_size_] = shift;
+        }
+        neighborhood.current_size_++;
+    }
+};
+//=================================================================================================//
 NeighborBuilderInner::NeighborBuilderInner(SPHBody &body)
     : NeighborBuilder(body.sph_adaptation_->getKernel()) {}
 //=================================================================================================//
@@ -89,10 +162,7 @@ void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
     Real distance_metric = displacement.squaredNorm();
     if (kernel_->checkIfWithinCutOffRadius(displacement) && index_i != index_j)
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j))
-            : initializeNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j));
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j));
     }
 };
 //=================================================================================================//
@@ -112,10 +182,7 @@ operator()(Neighborhood &neighborhood, const Vecd &pos_i, size_t index_i, const
     Real cutoff_radius = kernel_->CutOffRadius(h_ratio_min);
     if (distance < cutoff_radius && index_i != index_j)
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
     }
 };
 //=================================================================================================//
@@ -133,10 +200,7 @@ void NeighborBuilderSelfContact::operator()(Neighborhood &neighborhood,
     Real distance0 = (pos0_[index_i] - pos0_[index_j]).norm();
     if (distance < kernel_->CutOffRadius() && distance0 > kernel_->CutOffRadius())
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
     }
 };
 //=================================================================================================//
@@ -151,10 +215,7 @@ void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
     Real distance = displacement.norm();
     if (distance < kernel_->CutOffRadius())
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
     }
 };
 //=================================================================================================//
@@ -187,10 +248,7 @@ void NeighborBuilderContactBodyPart::operator()(Neighborhood &neighborhood,
     Real distance = displacement.norm();
     if (distance < kernel_->CutOffRadius() && part_indicator_[index_j] == 1)
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
     }
 }
 //=================================================================================================//
@@ -210,12 +268,7 @@ void NeighborBuilderContactAdaptive::operator()(Neighborhood &neighborhood,
     Real h_ratio_min = SMIN(i_h_ratio, relative_h_ref_ * contact_adaptation_.SmoothingLengthRatio(index_j));
     if (distance_metric < kernel_->CutOffRadiusSqr(h_ratio_min))
     {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, std::sqrt(distance_metric),
-                             displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
-            : initializeNeighbor(neighborhood, std::sqrt(distance_metric),
-                                 displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
-        neighborhood.current_size_++;
+        addNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
     }
 }
 //=================================================================================================//
@@ -42,6 +42,74 @@ class SPHBody;
 class BodyPart;
 class SPHAdaptation;
 
+/**
+ * @class NeighborDataArray
+ * @brief The data array of a neighborhood.
+ * @details The array either owns its data, which grows by push_back,
+ * or is bound as a view to a contiguous segment of a compressed neighbor storage.
+ * In both cases, the data is accessed by index in the interaction kernels.
+ */
+template <typename DataType>
+class NeighborDataArray
+{
+    StdLargeVec<DataType> owned_data_; /**< empty when bound as a view */
+    DataType *data_;
+    bool is_view_; /**< bound to a compressed neighbor storage */
+
+  public:
+    NeighborDataArray() : data_(nullptr), is_view_(false){};
+    NeighborDataArray(const NeighborDataArray &other)
+        : owned_data_(other.owned_data_),
+          data_(other.is_view_ ? other.data_ : owned_data_.data()),
+          is_view_(other.is_view_){};
+    NeighborDataArray(NeighborDataArray &&other) noexcept
+        : owned_data_(std::move(other.owned_data_)),
+          data_(other.is_view_ ? other.data_ : owned_data_.data()),
+          is_view_(other.is_view_){};
+    ~NeighborDataArray(){};
+
+    NeighborDataArray &operator=(const NeighborDataArray &other)
+    {
+        owned_data_ = other.owned_data_;
+        is_view_ = other.is_view_;
+        data_ = is_view_ ? other.data_ : owned_data_.data();
+        return *this;
+    };
+
+    NeighborDataArray &operator=(NeighborDataArray &&other) noexcept
+    {
+        DataType *other_data = other.data_;
+        owned_data_ = std::move(other.owned_data_);
+        is_view_ = other.is_view_;
+        data_ = is_view_ ? other_data : owned_data_.data();
+        return *this;
+    };
+
+    DataType &operator[](size_t n) { return data_[n]; };
+    const DataType &operator[](size_t n) const { return data_[n]; };
+    bool isView() const { return is_view_; };
+
+    void push_back(const DataType &value)
+    {
+        if (is_view_)
+        {
+            std::cout << "\n Error: the neighbor data array bound to a compressed storage can not grow!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        owned_data_.push_back(value);
+        data_ = owned_data_.data();
+    };
+
+    /** release the owned data and bind to external data */
+    void bindTo(DataType *external_data)
+    {
+        StdLargeVec<DataType>().swap(owned_data_);
+        data_ = external_data;
+        is_view_ = true;
+    };
+};
+
 /**
  * @class Neighborhood
  * @brief A neighborhood around particle i.
@@ -52,11 +120,12 @@ class Neighborhood
     size_t current_size_;   /**< the current number of neighbors */
     size_t allocated_size_; /**< the limit of neighbors does not require memory allocation  */
 
-    StdLargeVec<size_t> j_;      /**< index of the neighbor particle. */
-    StdLargeVec<Real> W_ij_;     /**< kernel value or particle volume contribution */
-    StdLargeVec<Real> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
-    StdLargeVec<Real> r_ij_;     /**< distance between j and i. */
-    StdLargeVec<Vecd> e_ij_;     /**< unit vector pointing from j to i or inter-particle surface direction */
+    NeighborDataArray<size_t> j_;      /**< index of the neighbor particle. */
+    NeighborDataArray<Real> W_ij_;     /**< kernel value or particle volume contribution */
+    NeighborDataArray<Real> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
+    NeighborDataArray<Real> r_ij_;     /**< distance between j and i. */
+    NeighborDataArray<Vecd> e_ij_;     /**< unit vector pointing from j to i or inter-particle surface direction,
+                                          for a neighbor candidate the shift of its position in the cell linked list */
 
     Neighborhood() : current_size_(0), allocated_size_(0){};
     ~Neighborhood(){};
@@ -65,6 +134,32 @@ class Neighborhood
 };
 using ParticleConfiguration = StdLargeVec<Neighborhood>;
 
+/**
+ * @class CompressedNeighborStorage
+ * @brief Compressed sparse row (CSR) storage of all neighborhoods in a particle configuration.
+ * @details Instead of each neighborhood allocating its own arrays, the neighbor data of all particles
+ * are saved in contiguous arrays and located by the offsets of the particles.
+ * The storage is built by two passes. The first pass only counts the neighbors of each particle.
+ * Then, the offsets are obtained by a prefix sum and the neighborhoods are bound to the storage as views.
+ * Finally, the second pass fills the data.
+ */
+class CompressedNeighborStorage
+{
+  public:
+    StdLargeVec<size_t> offsets_; /**< offsets of the particles, the last one is the total number of neighbors */
+    StdLargeVec<size_t> j_;
+    StdLargeVec<Real> W_ij_;
+    StdLargeVec<Real> dW_ijV_j_;
+    StdLargeVec<Real> r_ij_;
+    StdLargeVec<Vecd> e_ij_;
+
+    CompressedNeighborStorage(){};
+    ~CompressedNeighborStorage(){};
+
+    /** Obtain the offsets from the counted neighbors and bind the neighborhoods to the storage. */
+    void bindConfiguration(ParticleConfiguration &particle_configuration, size_t total_particles);
+};
+
 /**
  * @class NeighborBuilder
  * @brief Base class for building a neighbor particle j around particles i.
@@ -73,6 +168,7 @@ class NeighborBuilder
 {
   protected:
     Kernel *kernel_;
+    bool count_only_; /**< only count the neighbors for compressed storage */
     //----------------------------------------------------------------------
     //	Below are for constant smoothing length.
     //----------------------------------------------------------------------
@@ -89,9 +185,72 @@ class NeighborBuilder
                             const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min);
     Kernel *chooseKernel(SPHBody &body, SPHBody &target_body);
 
+    /** add a neighbor by creating or initializing it, or only counting it */
+    template <typename... Args>
+    void addNeighbor(Neighborhood &neighborhood, const Args &...args)
+    {
+        if (!count_only_)
+        {
+            neighborhood.current_size_ >= neighborhood.allocated_size_
+                ? createNeighbor(neighborhood, args...)
+                : initializeNeighbor(neighborhood, args...);
+        }
+        neighborhood.current_size_++;
+    };
+
+    /** add a neighbor with its data already evaluated, or only count it */
+    void addNeighborData(Neighborhood &neighborhood, size_t j_index, Real W_ij,
+                         Real dW_ijV_j, Real r_ij, const Vecd &e_ij)
+    {
+        if (!count_only_)
+        {
+            if (neighborhood.current_size_ >= neighborhood.allocated_size_)
+            {
+                neighborhood.j_.push_back(j_index);
+                neighborhood.W_ij_.push_back(W_ij);
+                neighborhood.dW_ijV_j_.push_back(dW_ijV_j);
+                neighborhood.r_ij_.push_back(r_ij);
+                neighborhood.e_ij_.push_back(e_ij);
+                neighborhood.allocated_size_++;
+            }
+            else
+            {
+                size_t current_size = neighborhood.current_size_;
+                neighborhood.j_[current_size] = j_index;
+                neighborhood.W_ij_[current_size] = W_ij;
+                neighborhood.dW_ijV_j_[current_size] = dW_ijV_j;
+                neighborhood.r_ij_[current_size] = r_ij;
+                neighborhood.e_ij_[current_size] = e_ij;
+            }
+        }
+        neighborhood.current_size_++;
+    };
+
   public:
-    NeighborBuilder(Kernel *kernel) : kernel_(kernel){};
+    NeighborBuilder(Kernel *kernel) : kernel_(kernel), count_only_(false){};
     virtual ~NeighborBuilder(){};
+    void setCountOnly(bool count_only) { count_only_ = count_only; };
+    Real CutOffRadius() { return kernel_->CutOffRadius(); };
+};
+
+/**
+ * @class NeighborBuilderCandidate
+ * @brief A neighbor builder collecting the neighbor candidates within a search radius,
+ * 		  i.e. the cutoff radius extended by a skin, for a Verlet list.
+ * 		  The indexes of the candidates are saved with the shifts of their positions in the cell linked list
+ * 		  from those of the particles, e.g. for the periodic images, and the other neighbor data are not touched.
+ */
+class NeighborBuilderCandidate
+{
+  protected:
+    Real search_radius_sqr_;
+    StdLargeVec<Vecd> *target_pos_;
+
+  public:
+    NeighborBuilderCandidate(Real search_radius, StdLargeVec<Vecd> &target_pos)
+        : search_radius_sqr_(search_radius * search_radius), target_pos_(&target_pos){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
 /**
@@ -106,6 +265,121 @@ class NeighborBuilderInner : public NeighborBuilder
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
+/**
+ * @class NeighborBuilderInnerHalf
+ * @brief A inner neighbor builder which only takes the neighbors with larger indexes,
+ * 		  so that each pair is saved once, i.e. a half neighbor list.
+ */
+class NeighborBuilderInnerHalf : public NeighborBuilderInner
+{
+  public:
+    explicit NeighborBuilderInnerHalf(SPHBody &body) : NeighborBuilderInner(body){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        if (index_i < std::get<0>(list_data_j))
+            NeighborBuilderInner::operator()(neighborhood, pos_i, index_i, list_data_j);
+    };
+};
+
+/**
+ * @class NeighborBuilderWithKernel
+ * @brief Base class of the neighbor builders with the kernel type as template parameter.
+ * 		  A copy of the kernel is kept with its exact type, so that the kernel values are
+ * 		  evaluated without virtual calls and the dimensional kernel functions can be inlined.
+ * 		  The given kernel should be exactly of the kernel type, not derived from it,
+ * 		  and should not be reset after the builder is constructed.
+ * 		  It is only for isotropic kernels with constant smoothing length,
+ * 		  such as KernelWendlandC2, KernelCubicBSpline and KernelTabulated.
+ */
+template <class KernelType>
+class NeighborBuilderWithKernel : public NeighborBuilder
+{
+  protected:
+    KernelType typed_kernel_;
+
+    KernelType &checkKernelType(Kernel *kernel)
+    {
+        if (typeid(*kernel) != typeid(KernelType))
+        {
+            std::cout << "\n Error: the kernel " << kernel->Name()
+                      << " is not exactly of the type given to the neighbor builder!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        return *static_cast<KernelType *>(kernel);
+    };
+    Real W(const Real &distance, const Vec2d &displacement) const
+    {
+        return typed_kernel_.FactorW2D() * typed_kernel_.W_2D(distance * typed_kernel_.InvSmoothingLength());
+    };
+    Real W(const Real &distance, const Vec3d &displacement) const
+    {
+        return typed_kernel_.FactorW3D() * typed_kernel_.W_3D(distance * typed_kernel_.InvSmoothingLength());
+    };
+    Real dW(const Real &distance, const Vec2d &displacement) const
+    {
+        return typed_kernel_.FactordW2D() * typed_kernel_.dW_2D(distance * typed_kernel_.InvSmoothingLength());
+    };
+    Real dW(const Real &distance, const Vec3d &displacement) const
+    {
+        return typed_kernel_.FactordW3D() * typed_kernel_.dW_3D(distance * typed_kernel_.InvSmoothingLength());
+    };
+    void addNeighborByKernel(Neighborhood &neighborhood, Real distance_metric,
+                             const Vecd &displacement, const ListData &list_data_j)
+    {
+        Real distance = std::sqrt(distance_metric);
+        addNeighborData(neighborhood, std::get<0>(list_data_j), W(distance, displacement),
+                        dW(distance, displacement) * std::get<2>(list_data_j),
+                        distance, displacement / (distance + TinyReal));
+    };
+
+  public:
+    explicit NeighborBuilderWithKernel(Kernel *kernel)
+        : NeighborBuilder(kernel), typed_kernel_(checkKernelType(kernel)){};
+};
+
+/**
+ * @class NeighborBuilderInnerWithKernel
+ * @brief An inner neighbor builder with the kernel type as template parameter.
+ */
+template <class KernelType>
+class NeighborBuilderInnerWithKernel : public NeighborBuilderWithKernel<KernelType>
+{
+  public:
+    explicit NeighborBuilderInnerWithKernel(Kernel *kernel)
+        : NeighborBuilderWithKernel<KernelType>(kernel){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        Vecd displacement = pos_i - std::get<1>(list_data_j);
+        Real distance_metric = displacement.squaredNorm();
+        if (distance_metric < this->typed_kernel_.CutOffRadiusSqr() && index_i != std::get<0>(list_data_j))
+            this->addNeighborByKernel(neighborhood, distance_metric, displacement, list_data_j);
+    };
+};
+
+/**
+ * @class NeighborBuilderContactWithKernel
+ * @brief A contact neighbor builder with the kernel type as template parameter.
+ * 		  The kernel chosen from the two bodies should be of the kernel type.
+ */
+template <class KernelType>
+class NeighborBuilderContactWithKernel : public NeighborBuilderWithKernel<KernelType>
+{
+  public:
+    NeighborBuilderContactWithKernel(SPHBody &body, SPHBody &contact_body)
+        : NeighborBuilderWithKernel<KernelType>(this->chooseKernel(body, contact_body)){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        Vecd displacement = pos_i - std::get<1>(list_data_j);
+        Real distance_metric = displacement.squaredNorm();
+        if (distance_metric < this->typed_kernel_.CutOffRadiusSqr())
+            this->addNeighborByKernel(neighborhood, distance_metric, displacement, list_data_j);
+    };
+};
+
 /**
  * @class NeighborBuilderInnerAdaptive
  * @brief A inner neighbor builder functor when the particles have different smoothing lengths.
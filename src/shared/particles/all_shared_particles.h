@@ -30,6 +30,7 @@
 #define ALL_SHARED_PARTICLES_H
 
 #include "base_particles.hpp"
+#include "buffer_particle_manager.h"
 #include "diffusion_reaction_particles.h"
 #include "observer_particles.h"
 #include "solid_particles.h"
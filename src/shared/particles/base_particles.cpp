@@ -113,6 +113,18 @@ size_t BaseParticles::insertAGhostParticle(size_t index)
     return expected_particle_index;
 }
 //=================================================================================================//
+size_t BaseParticles::addGhostParticles(size_t ghost_size)
+{
+    size_t first_ghost_index = real_particles_bound_ + total_ghost_particles_;
+    total_ghost_particles_ += ghost_size;
+    size_t expected_size = real_particles_bound_ + total_ghost_particles_;
+    while (pos_.size() < expected_size)
+    {
+        addAParticleEntry();
+    }
+    return first_ghost_index;
+}
+//=================================================================================================//
 void BaseParticles::switchToBufferParticle(size_t index)
 {
     size_t last_real_particle_index = total_real_particles_ - 1;
@@ -367,5 +379,56 @@ void BaseParticles::readFromXmlForReloadParticle(std::string &filefullpath)
     loop_variable_namelist(all_particle_data_, variables_to_reload_, read_variable_from_xml);
 }
 //=================================================================================================//
+void BaseParticles::writeParticlesToBinaryForRestart(std::string &filefullpath)
+{
+    BinaryParser binary_parser;
+    binary_parser.resetVariablesToWrite(total_real_particles_);
+    WriteAParticleVariableToBinary write_variable_to_binary(binary_parser);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_restart_, write_variable_to_binary);
+    binary_parser.writeToBinaryFile(filefullpath);
+}
+//=================================================================================================//
+void BaseParticles::readParticleFromBinaryForRestart(std::string &filefullpath)
+{
+    BinaryParser binary_parser;
+    binary_parser.loadBinaryFile(filefullpath);
+    if (binary_parser.TotalParticles() != total_real_particles_)
+    {
+        std::cout << "\n Error: the number of particles in restart file " << filefullpath
+                  << " does not match that of body " << body_name_ << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    ReadAParticleVariableFromBinary read_variable_from_binary(binary_parser, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_restart_, read_variable_from_binary);
+}
+//=================================================================================================//
+void BaseParticles::writeToBinaryForReloadParticle(std::string &filefullpath)
+{
+    BinaryParser binary_parser;
+    binary_parser.resetVariablesToWrite(total_real_particles_);
+    WriteAParticleVariableToBinary write_variable_to_binary(binary_parser);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_reload_, write_variable_to_binary);
+    binary_parser.writeToBinaryFile(filefullpath);
+}
+//=================================================================================================//
+void BaseParticles::readFromBinaryForReloadParticle(std::string &filefullpath)
+{
+    BinaryParser binary_parser;
+    binary_parser.loadBinaryFile(filefullpath);
+    total_real_particles_ = binary_parser.TotalParticles();
+    for (size_t i = 0; i != total_real_particles_; ++i)
+    {
+        unsorted_id_.push_back(i);
+    };
+    resize_particle_data_(all_particle_data_, total_real_particles_);
+    ReadAParticleVariableFromBinary read_variable_from_binary(binary_parser, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_reload_, read_variable_from_binary);
+}
+//=================================================================================================//
 } // namespace SPH
   //=====================================================================================================//
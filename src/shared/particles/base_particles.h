@@ -36,6 +36,7 @@
 #include "base_variable.h"
 #include "particle_sorting.h"
 #include "sph_data_containers.h"
+#include "binary_parser.h"
 #include "xml_parser.h"
 
 #include <fstream>
@@ -120,6 +121,8 @@ class BaseParticles
     void copyFromAnotherParticle(size_t index, size_t another_index);
     void updateFromAnotherParticle(size_t index, size_t another_index);
     size_t insertAGhostParticle(size_t index);
+    /** Add entries for a number of ghost particles behind those in use and return the index of the first one. */
+    size_t addGhostParticles(size_t ghost_size);
     void switchToBufferParticle(size_t index);
     //----------------------------------------------------------------------
     //		Parameterized management on generalized particle data
@@ -149,6 +152,7 @@ class BaseParticles
     void addVariableToList(ParticleVariables &variable_set, const std::string &variable_name);
     template <typename DataType>
     void addVariableToWrite(const std::string &variable_name);
+    inline const ParticleVariables &getVariablesToWrite() const { return variables_to_write_; }
     template <typename DataType>
     void addVariableToRestart(const std::string &variable_name);
     inline const ParticleVariables &getVariablesToRestart() const { return variables_to_restart_; }
@@ -173,9 +177,16 @@ class BaseParticles
     void registerSortableVariable(const std::string &variable_name);
     template <typename SequenceMethod>
     void sortParticles(SequenceMethod &sequence_method);
+    template <typename SequenceMethod>
+    void sortParticlesByPermutation(SequenceMethod &sequence_method);
     //----------------------------------------------------------------------
     //		Particle data ouput functions
     //----------------------------------------------------------------------
+    /** apply the function to each data array written into VTK files, i.e. the particle IDs and the variables
+     * to write, with its name, number of components, component type, i.e. int or Real, given by a value,
+     * and the function writing the components of a particle */
+    template <typename DataArrayFunction>
+    void forEachVtkDataArray(const DataArrayFunction &data_array_function);
     template <typename OutStreamType>
     void writeParticlesToVtk(OutStreamType &output_stream);
     void writeParticlesToPltFile(std::ofstream &output_file);
@@ -185,6 +196,10 @@ class BaseParticles
     void readParticleFromXmlForRestart(std::string &filefullpath);
     void writeToXmlForReloadParticle(std::string &filefullpath);
     void readFromXmlForReloadParticle(std::string &filefullpath);
+    void writeParticlesToBinaryForRestart(std::string &filefullpath);
+    void readParticleFromBinaryForRestart(std::string &filefullpath);
+    void writeToBinaryForReloadParticle(std::string &filefullpath);
+    void readFromBinaryForReloadParticle(std::string &filefullpath);
     XmlParser *getReloadXmlParser() { return &reload_xml_parser_; };
     virtual BaseParticles *ThisObjectPtr() { return this; };
     //----------------------------------------------------------------------
@@ -269,6 +284,41 @@ struct ReadAParticleVariableFromXml
     void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const;
 };
 
+/**
+ * @struct WriteAParticleVariableToBinary
+ * @brief Define a operator for writing particle variable to binary format.
+ */
+struct WriteAParticleVariableToBinary
+{
+    BinaryParser &binary_parser_;
+    explicit WriteAParticleVariableToBinary(BinaryParser &binary_parser)
+        : binary_parser_(binary_parser){};
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const
+    {
+        binary_parser_.addVariableToWrite(variable_name, variable);
+    };
+};
+
+/**
+ * @struct ReadAParticleVariableFromBinary
+ * @brief Define a operator for reading particle variable from binary format.
+ */
+struct ReadAParticleVariableFromBinary
+{
+    BinaryParser &binary_parser_;
+    size_t &total_real_particles_;
+    ReadAParticleVariableFromBinary(BinaryParser &binary_parser, size_t &total_real_particles)
+        : binary_parser_(binary_parser), total_real_particles_(total_real_particles){};
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const
+    {
+        binary_parser_.readVariable(variable_name, variable, total_real_particles_);
+    };
+};
+
 /**
  * @class BaseDerivedVariable
  * @brief computing displacement from current and initial particle position
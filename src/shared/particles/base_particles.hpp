@@ -201,6 +201,13 @@ void BaseParticles::sortParticles(SequenceMethod &sequence_method)
     particle_sorting_.sortingParticleData(sequence.data(), total_real_particles_);
 }
 //=================================================================================================//
+template <typename SequenceMethod>
+void BaseParticles::sortParticlesByPermutation(SequenceMethod &sequence_method)
+{
+    StdLargeVec<size_t> &sequence = sequence_method.computingSequence(*this);
+    particle_sorting_.sortingParticleDataByPermutation(sequence.data(), total_real_particles_);
+}
+//=================================================================================================//
 template <typename DataType>
 void BaseParticles::resizeParticleData<DataType>::
 operator()(ParticleData &particle_data, size_t new_size) const
@@ -232,96 +239,91 @@ operator()(ParticleData &particle_data, size_t index, size_t another_index) cons
             (*std::get<type_index>(particle_data)[i])[another_index];
 }
 //=================================================================================================//
-template <typename StreamType>
-void BaseParticles::writeParticlesToVtk(StreamType &output_stream)
+template <typename DataArrayFunction>
+void BaseParticles::forEachVtkDataArray(const DataArrayFunction &data_array_function)
 {
-    size_t total_real_particles = total_real_particles_;
+    // sorted and unsorted particles ID
+    data_array_function("SortedParticle_ID", 1, int(0),
+                        [&](size_t i, int *components)
+                        { components[0] = int(i); });
+    data_array_function("UnsortedParticle_ID", 1, int(0),
+                        [&](size_t i, int *components)
+                        { components[0] = int(unsorted_id_[i]); });
 
-    // write sorted particles ID
-    output_stream << "    <DataArray Name=\"SortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
-    output_stream << "    ";
-    for (size_t i = 0; i != total_real_particles; ++i)
-    {
-        output_stream << i << " ";
-    }
-    output_stream << std::endl;
-    output_stream << "    </DataArray>\n";
-
-    // write unsorted particles ID
-    output_stream << "    <DataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
-    output_stream << "    ";
-    for (size_t i = 0; i != total_real_particles; ++i)
-    {
-        output_stream << unsorted_id_[i] << " ";
-    }
-    output_stream << std::endl;
-    output_stream << "    </DataArray>\n";
-
-    // write integers
+    // integers
     constexpr int type_index_int = DataTypeIndex<int>::value;
     for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write_))
     {
         StdLargeVec<int> &variable_data = *(std::get<type_index_int>(all_particle_data_)[variable->IndexInContainer()]);
-        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Int32\" Format=\"ascii\">\n";
-        output_stream << "    ";
-        for (size_t i = 0; i != total_real_particles; ++i)
-        {
-            output_stream << std::fixed << std::setprecision(9) << variable_data[i] << " ";
-        }
-        output_stream << std::endl;
-        output_stream << "    </DataArray>\n";
+        data_array_function(variable->Name(), 1, int(0),
+                            [&](size_t i, int *components)
+                            { components[0] = variable_data[i]; });
     }
 
-    // write scalars
+    // scalars
     constexpr int type_index_Real = DataTypeIndex<Real>::value;
     for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write_))
     {
         StdLargeVec<Real> &variable_data = *(std::get<type_index_Real>(all_particle_data_)[variable->IndexInContainer()]);
-        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\" Format=\"ascii\">\n";
-        output_stream << "    ";
-        for (size_t i = 0; i != total_real_particles; ++i)
-        {
-            output_stream << std::fixed << std::setprecision(9) << variable_data[i] << " ";
-        }
-        output_stream << std::endl;
-        output_stream << "    </DataArray>\n";
+        data_array_function(variable->Name(), 1, Real(0),
+                            [&](size_t i, Real *components)
+                            { components[0] = variable_data[i]; });
     }
 
-    // write vectors
+    // vectors
     constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
     for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write_))
     {
         StdLargeVec<Vecd> &variable_data = *(std::get<type_index_Vecd>(all_particle_data_)[variable->IndexInContainer()]);
-        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
-        output_stream << "    ";
-        for (size_t i = 0; i != total_real_particles; ++i)
-        {
-            Vec3d vector_value = upgradeToVec3d(variable_data[i]);
-            output_stream << std::fixed << std::setprecision(9) << vector_value[0] << " " << vector_value[1] << " " << vector_value[2] << " ";
-        }
-        output_stream << std::endl;
-        output_stream << "    </DataArray>\n";
+        data_array_function(variable->Name(), 3, Real(0),
+                            [&](size_t i, Real *components)
+                            {
+                                Vec3d vector_value = upgradeToVec3d(variable_data[i]);
+                                for (int k = 0; k != 3; ++k)
+                                    components[k] = vector_value[k];
+                            });
     }
 
-    // write matrices
+    // matrices, column by column
     constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
     for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write_))
     {
         StdLargeVec<Matd> &variable_data = *(std::get<type_index_Matd>(all_particle_data_)[variable->IndexInContainer()]);
-        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type= \"Float32\"  NumberOfComponents=\"9\" Format=\"ascii\">\n";
-        output_stream << "    ";
-        for (size_t i = 0; i != total_real_particles; ++i)
+        data_array_function(variable->Name(), 9, Real(0),
+                            [&](size_t i, Real *components)
+                            {
+                                Mat3d matrix_value = upgradeToMat3d(variable_data[i]);
+                                for (int k = 0; k != 3; ++k)
+                                    for (int l = 0; l != 3; ++l)
+                                        components[3 * k + l] = matrix_value(l, k);
+                            });
+    }
+}
+//=================================================================================================//
+template <typename StreamType>
+void BaseParticles::writeParticlesToVtk(StreamType &output_stream)
+{
+    size_t total_real_particles = total_real_particles_;
+    forEachVtkDataArray(
+        [&](const std::string &name, int number_of_components, auto component_type, const auto &get_components)
         {
-            Mat3d matrix_value = upgradeToMat3d(variable_data[i]);
-            for (int k = 0; k != 3; ++k)
+            using ComponentType = decltype(component_type);
+            std::string type = std::is_same<ComponentType, int>::value ? "Int32" : "Float32";
+            output_stream << "    <DataArray Name=\"" << name << "\" type=\"" << type << "\"";
+            if (number_of_components != 1)
+                output_stream << " NumberOfComponents=\"" << number_of_components << "\"";
+            output_stream << " Format=\"ascii\">\n";
+            output_stream << "    ";
+            ComponentType components[9];
+            for (size_t i = 0; i != total_real_particles; ++i)
             {
-                Vec3d col_vector = matrix_value.col(k);
-                output_stream << std::fixed << std::setprecision(9) << col_vector[0] << " " << col_vector[1] << " " << col_vector[2] << " ";
+                get_components(i, components);
+                for (int k = 0; k != number_of_components; ++k)
+                    output_stream << std::fixed << std::setprecision(9) << components[k] << " ";
             }
-        }
-        output_stream << std::endl;
-        output_stream << "    </DataArray>\n";
-    }
+            output_stream << std::endl;
+            output_stream << "    </DataArray>\n";
+        });
 }
 //=================================================================================================//
 template <typename DataType>
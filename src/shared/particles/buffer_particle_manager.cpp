@@ -0,0 +1,101 @@
+#include "buffer_particle_manager.h"
+
+#include "base_particle_dynamics.h"
+
+#include "tbb/parallel_sort.h"
+
+namespace SPH
+{
+//=================================================================================================//
+BufferParticleManager::BufferParticleManager(BaseParticles &base_particles)
+    : base_particles_(base_particles), unsorted_id_(base_particles.unsorted_id_),
+      sorted_id_(base_particles.sorted_id_), total_reserved_particles_(0) {}
+//=================================================================================================//
+size_t BufferParticleManager::reserveBufferParticle()
+{
+    size_t buffer_particle_index = base_particles_.total_real_particles_ + total_reserved_particles_++;
+    if (buffer_particle_index >= base_particles_.real_particles_bound_)
+    {
+        std::cout << "\n Error: not enough body buffer particles!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return buffer_particle_index;
+}
+//=================================================================================================//
+void BufferParticleManager::realizeReservedParticles()
+{
+    base_particles_.total_real_particles_ += total_reserved_particles_;
+    total_reserved_particles_ = 0;
+}
+//=================================================================================================//
+void BufferParticleManager::switchCandidatesToBufferParticles()
+{
+    size_t total_deletion = deletion_candidates_.size();
+    if (total_deletion == 0)
+        return;
+
+    IndexVector candidates(deletion_candidates_.begin(), deletion_candidates_.end());
+    deletion_candidates_.clear();
+    tbb::parallel_sort(candidates.begin(), candidates.end());
+
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    size_t new_total_real_particles = total_real_particles - total_deletion;
+    // candidates beyond the new total real particles are switched without moving data,
+    // the other ones are holes to be filled by the remaining particles beyond the new total
+    auto holes_end = std::lower_bound(candidates.begin(), candidates.end(), new_total_real_particles);
+    IndexVector remaining_particles;
+    auto candidate = holes_end;
+    for (size_t i = new_total_real_particles; i != total_real_particles; ++i)
+    {
+        if (candidate != candidates.end() && *candidate == i)
+            ++candidate;
+        else
+            remaining_particles.push_back(i);
+    }
+
+    parallel_for(
+        IndexRange(0, remaining_particles.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t hole_index = candidates[n];
+                size_t remaining_index = remaining_particles[n];
+                base_particles_.updateFromAnotherParticle(hole_index, remaining_index);
+                std::swap(unsorted_id_[hole_index], unsorted_id_[remaining_index]);
+                sorted_id_[unsorted_id_[hole_index]] = hole_index;
+            }
+        },
+        ap);
+
+    base_particles_.total_real_particles_ = new_total_real_particles;
+}
+//=================================================================================================//
+void BufferParticleManager::
+    insertGhostParticles(ConcurrentIndexVector &real_particles, IndexVector &ghost_particles)
+{
+    IndexVector sources(real_particles.begin(), real_particles.end());
+    real_particles.clear();
+    tbb::parallel_sort(sources.begin(), sources.end());
+
+    size_t first_ghost_index = base_particles_.addGhostParticles(sources.size());
+    size_t offset = ghost_particles.size();
+    ghost_particles.resize(offset + sources.size());
+    parallel_for(
+        IndexRange(0, sources.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t ghost_index = first_ghost_index + n;
+                base_particles_.copyFromAnotherParticle(ghost_index, sources[n]);
+                /** For a ghost particle, its sorted id is that of corresponding real particle. */
+                sorted_id_[ghost_index] = sources[n];
+                ghost_particles[offset + n] = ghost_index;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,74 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	buffer_particle_manager.h
+ * @brief 	Batched switching between real, buffer and ghost particles.
+ * @details The candidates are collected in parallel particle loops without locking.
+ * 			Then, the particle data are moved in a single batched parallel pass.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef BUFFER_PARTICLE_MANAGER_H
+#define BUFFER_PARTICLE_MANAGER_H
+
+#include "base_particles.h"
+
+#include <atomic>
+
+namespace SPH
+{
+/**
+ * @class BufferParticleManager
+ * @brief Manages buffer and ghost particles for inflow, outflow and periodic boundaries.
+ * 		  A buffer particle is realized by reserving a slot behind the real particles with an atomic counter.
+ * 		  The reserved particles become real particles by realizeReservedParticles after the particle loop.
+ * 		  Real particles to be deleted are collected as candidates and switched to buffer particles
+ * 		  by a batched compaction, which fills the holes with the remaining particles at the end of the real particles.
+ * 		  Ghost particles are added in a batch for a collected list of real particles.
+ */
+class BufferParticleManager
+{
+  public:
+    explicit BufferParticleManager(BaseParticles &base_particles);
+    virtual ~BufferParticleManager(){};
+
+    /** Reserve the next buffer particle and return its index. Thread safe. */
+    size_t reserveBufferParticle();
+    /** Realize all reserved buffer particles as real particles. */
+    void realizeReservedParticles();
+    /** Add a real particle to be switched to buffer particle. Thread safe. */
+    void addDeletionCandidate(size_t index_i) { deletion_candidates_.push_back(index_i); };
+    /** Switch all deletion candidates to buffer particles. */
+    void switchCandidatesToBufferParticles();
+    /** Add ghost particles copied from the given real particles, whose indices are returned in ghost_particles. */
+    void insertGhostParticles(ConcurrentIndexVector &real_particles, IndexVector &ghost_particles);
+
+  protected:
+    BaseParticles &base_particles_;
+    StdLargeVec<size_t> &unsorted_id_;
+    StdLargeVec<size_t> &sorted_id_;
+    std::atomic<size_t> total_reserved_particles_;
+    ConcurrentIndexVector deletion_candidates_;
+};
+} // namespace SPH
+#endif // BUFFER_PARTICLE_MANAGER_H
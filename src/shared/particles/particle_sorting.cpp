@@ -23,11 +23,136 @@ void SwapSortableParticleData::operator()(size_t *a, size_t *b)
     swap_particle_data_value_(sortable_data_, index_a, index_b);
 }
 //=================================================================================================//
+void RadixSortParticleSequence::sort(size_t *sequence, size_t size, StdLargeVec<size_t> &permutation)
+{
+    permutation.resize(size);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                permutation[i] = i;
+        },
+        ap);
+    if (size < 2)
+        return;
+
+    size_t max_sequence = parallel_reduce(
+        IndexRange(0, size), size_t(0),
+        [&](const IndexRange &r, size_t max_value) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                max_value = SMAX(max_value, sequence[i]);
+            return max_value;
+        },
+        [](size_t x, size_t y) -> size_t
+        { return SMAX(x, y); });
+
+    sequence_buffer_.resize(size);
+    permutation_buffer_.resize(size);
+    size_t number_of_blocks = (size + block_size_ - 1) / block_size_;
+    block_offsets_.resize(number_of_blocks * radix_size_);
+
+    size_t *sequence_in = sequence;
+    size_t *sequence_out = sequence_buffer_.data();
+    size_t *permutation_in = permutation.data();
+    size_t *permutation_out = permutation_buffer_.data();
+    for (size_t shift = 0; shift < 8 * sizeof(size_t) && (max_sequence >> shift) != 0; shift += radix_bits_)
+    {
+        // count the digits in each block
+        parallel_for(
+            IndexRange(0, number_of_blocks),
+            [&](const IndexRange &r)
+            {
+                for (size_t b = r.begin(); b != r.end(); ++b)
+                {
+                    size_t *counts = &block_offsets_[b * radix_size_];
+                    std::fill(counts, counts + radix_size_, 0);
+                    size_t end = SMIN(size, (b + 1) * block_size_);
+                    for (size_t i = b * block_size_; i != end; ++i)
+                        counts[(sequence_in[i] >> shift) & (radix_size_ - 1)]++;
+                }
+            },
+            ap);
+        // exclusive prefix sum in the order of digits and then blocks, which keeps the sorting stable
+        size_t offset = 0;
+        for (size_t d = 0; d != radix_size_; ++d)
+            for (size_t b = 0; b != number_of_blocks; ++b)
+            {
+                size_t count = block_offsets_[b * radix_size_ + d];
+                block_offsets_[b * radix_size_ + d] = offset;
+                offset += count;
+            }
+        // scatter the sequence and permutation
+        parallel_for(
+            IndexRange(0, number_of_blocks),
+            [&](const IndexRange &r)
+            {
+                for (size_t b = r.begin(); b != r.end(); ++b)
+                {
+                    size_t *offsets = &block_offsets_[b * radix_size_];
+                    size_t end = SMIN(size, (b + 1) * block_size_);
+                    for (size_t i = b * block_size_; i != end; ++i)
+                    {
+                        size_t destination = offsets[(sequence_in[i] >> shift) & (radix_size_ - 1)]++;
+                        sequence_out[destination] = sequence_in[i];
+                        permutation_out[destination] = permutation_in[i];
+                    }
+                }
+            },
+            ap);
+        std::swap(sequence_in, sequence_out);
+        std::swap(permutation_in, permutation_out);
+    }
+
+    if (sequence_in != sequence)
+    {
+        parallel_for(
+            IndexRange(0, size),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    sequence[i] = sequence_in[i];
+                    permutation[i] = permutation_in[i];
+                }
+            },
+            ap);
+    }
+}
+//=================================================================================================//
+GatherSortableParticleData::GatherSortableParticleData(BaseParticles &base_particles)
+    : unsorted_id_(base_particles.unsorted_id_),
+      sortable_data_(base_particles.sortable_data_) {}
+//=================================================================================================//
+void GatherSortableParticleData::operator()(const StdLargeVec<size_t> &permutation, size_t size)
+{
+    if (gathered_unsorted_id_.size() < size)
+        gathered_unsorted_id_.resize(size);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                gathered_unsorted_id_[i] = unsorted_id_[permutation[i]];
+        },
+        ap);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                unsorted_id_[i] = gathered_unsorted_id_[i];
+        },
+        ap);
+    gather_particle_data_value_(sortable_data_, permutation, size);
+}
+//=================================================================================================//
 ParticleSorting::ParticleSorting(BaseParticles &base_particles)
     : base_particles_(base_particles),
       swap_sortable_particle_data_(base_particles), compare_(),
       quick_sort_particle_range_(base_particles_.sequence_.data(), 0, compare_, swap_sortable_particle_data_),
-      quick_sort_particle_body_() {}
+      quick_sort_particle_body_(), gather_sortable_particle_data_(base_particles), total_sortings_(0) {}
 //=================================================================================================//
 void ParticleSorting::sortingParticleData(size_t *begin, size_t size)
 {
@@ -35,6 +160,15 @@ void ParticleSorting::sortingParticleData(size_t *begin, size_t size)
     quick_sort_particle_range_.size_ = size;
     parallel_for(quick_sort_particle_range_, quick_sort_particle_body_, ap);
     updateSortedId();
+    total_sortings_++;
+}
+//=================================================================================================//
+void ParticleSorting::sortingParticleDataByPermutation(size_t *begin, size_t size)
+{
+    radix_sort_particle_sequence_.sort(begin, size, permutation_);
+    gather_sortable_particle_data_(permutation_, size);
+    updateSortedId();
+    total_sortings_++;
 }
 //=================================================================================================//
 void ParticleSorting::updateSortedId()
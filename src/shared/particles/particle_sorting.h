@@ -248,6 +248,85 @@ class SwapSortableParticleData
     void operator()(size_t *a, size_t *b);
 };
 
+template <typename VariableType>
+struct gatherParticleDataValue
+{
+    StdLargeVec<VariableType> gathered_; /**< scratch buffer reused for all variables of this type */
+
+    void operator()(ParticleData &particle_data, const StdLargeVec<size_t> &permutation, size_t size)
+    {
+        constexpr int type_index = DataTypeIndex<VariableType>::value;
+
+        StdVec<StdLargeVec<VariableType> *> variables = std::get<type_index>(particle_data);
+        if (gathered_.size() < size)
+            gathered_.resize(size);
+        for (size_t k = 0; k != variables.size(); ++k)
+        {
+            StdLargeVec<VariableType> &variable = *variables[k];
+            parallel_for(
+                IndexRange(0, size),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                        gathered_[i] = variable[permutation[i]];
+                },
+                ap);
+            parallel_for(
+                IndexRange(0, size),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                        variable[i] = gathered_[i];
+                },
+                ap);
+        }
+    };
+};
+
+/**
+ * @class RadixSortParticleSequence
+ * @brief Parallel least-significant-digit radix sort for the particle sequence.
+ * Beside sorting the sequence, it gives the permutation,
+ * i.e. the original particle index at each sorted position.
+ */
+class RadixSortParticleSequence
+{
+  protected:
+    static const size_t radix_bits_ = 8;
+    static const size_t radix_size_ = 1 << radix_bits_;
+    static const size_t block_size_ = 16384;
+    StdLargeVec<size_t> sequence_buffer_;
+    StdLargeVec<size_t> permutation_buffer_;
+    StdVec<size_t> block_offsets_; /**< bucket offsets of all blocks */
+
+  public:
+    RadixSortParticleSequence(){};
+    ~RadixSortParticleSequence(){};
+
+    /** sort the sequence in place and obtain the permutation. */
+    void sort(size_t *sequence, size_t size, StdLargeVec<size_t> &permutation);
+};
+
+/**
+ * @class GatherSortableParticleData
+ * @brief Gather sortable particle data according to a permutation.
+ * Each variable is gathered in one streaming pass into a scratch buffer and copied back.
+ */
+class GatherSortableParticleData
+{
+  protected:
+    StdLargeVec<size_t> &unsorted_id_;
+    ParticleData &sortable_data_;
+    StdLargeVec<size_t> gathered_unsorted_id_;
+    DataAssembleOperation<gatherParticleDataValue> gather_particle_data_value_;
+
+  public:
+    explicit GatherSortableParticleData(BaseParticles &base_particles);
+    ~GatherSortableParticleData(){};
+
+    void operator()(const StdLargeVec<size_t> &permutation, size_t size);
+};
+
 /**
  * @class ParticleSorting
  * @brief The class for sorting particle according a given sequence.
@@ -266,6 +345,11 @@ class ParticleSorting
     tbb::interface9::QuickSortParticleBody<
         size_t *, CompareParticleSequence, SwapSortableParticleData>
         quick_sort_particle_body_;
+    /** for sorting by permutation */
+    RadixSortParticleSequence radix_sort_particle_sequence_;
+    GatherSortableParticleData gather_sortable_particle_data_;
+    StdLargeVec<size_t> permutation_;
+    size_t total_sortings_; /**< number of sortings done, which change the particle indexes */
 
   public:
     // the construction is before particles
@@ -273,8 +357,12 @@ class ParticleSorting
     virtual ~ParticleSorting(){};
     /** sorting particle data according to the cell location of particles */
     virtual void sortingParticleData(size_t *begin, size_t size);
+    /** sorting particle data by radix sorting the sequence once and then gathering the particle data,
+     * which avoids swapping all sortable variables for each exchange of the quick sort */
+    virtual void sortingParticleDataByPermutation(size_t *begin, size_t size);
     /** update the reference of sorted data from unsorted data */
     virtual void updateSortedId();
+    size_t TotalSortings() { return total_sortings_; };
 };
 } // namespace SPH
 #endif // PARTICLE_SORTING_H
\ No newline at end of file
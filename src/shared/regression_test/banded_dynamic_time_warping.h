@@ -0,0 +1,115 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	banded_dynamic_time_warping.h
+ * @brief 	The dynamic time warping distance computed within a band around the diagonal
+ *          with two rolling rows of the band only.
+ * @author	Bo Zhang , Chi Zhang and Xiangyu Hu
+ */
+
+#pragma once
+
+#include "base_data_type.h"
+#include "large_data_containers.h"
+#include "scalar_functions.h"
+
+namespace SPH
+{
+/**
+ * @class BandedDynamicTimeWarping
+ * @brief Locality constrained dynamic time warping between two series.
+ * Only the cells within the window around the diagonal are computed and
+ * only two rows of the window are stored, so that the memory is linear in the window size
+ * instead of the product of the series lengths.
+ * The recurrence is identical to that of the full distance matrix,
+ * in which the cells out of the window, except the first row and column, are zero.
+ * The window of a row extends at least to the diagonal shifted by the length difference,
+ * so that the last row always reaches the end cell.
+ */
+class BandedDynamicTimeWarping
+{
+    int window_size_;
+    StdVec<Real> previous_row_, current_row_;
+    int previous_lower_, previous_upper_; /**< window [lower, upper) of the previous row */
+    Real previous_first_column_;          /**< accumulated distance at the first column of the previous row */
+
+    /** the upper end of the window of a row, not before the end cell for the last row */
+    int windowUpper(int index_i, int window_size, int a_length, int b_length)
+    {
+        return SMIN(b_length, index_i + SMAX(window_size, b_length - a_length + 1));
+    };
+
+    Real previousRowValue(int index_j)
+    {
+        if (index_j >= previous_lower_ && index_j < previous_upper_)
+            return previous_row_[index_j - previous_lower_];
+        return index_j == 0 ? previous_first_column_ : 0.0;
+    };
+
+  public:
+    explicit BandedDynamicTimeWarping(int window_size = 5)
+        : window_size_(window_size), previous_lower_(0), previous_upper_(0), previous_first_column_(0.0){};
+
+    /** the dtw distance between series a and b with a given p-norm of two entries */
+    template <typename VariableType, typename PNormFunction>
+    Real distance(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b,
+                  const PNormFunction &p_norm)
+    {
+        int a_length = series_a.size();
+        int b_length = series_b.size();
+        if (a_length == 0 || b_length == 0)
+            return 0.0;
+
+        int window_size = SMAX(window_size_, ABS(a_length - b_length));
+        previous_row_.resize(2 * window_size + 2);
+        current_row_.resize(2 * window_size + 2);
+
+        /** the first row, only the part read by the window of the second row is required. */
+        previous_lower_ = 0;
+        previous_upper_ = windowUpper(1, window_size, a_length, b_length);
+        previous_row_[0] = p_norm(series_a[0], series_b[0]);
+        for (int index_j = 1; index_j < previous_upper_; ++index_j)
+            previous_row_[index_j] = previous_row_[index_j - 1] + p_norm(series_a[0], series_b[index_j]);
+        previous_first_column_ = previous_row_[0];
+
+        for (int index_i = 1; index_i != a_length; ++index_i)
+        {
+            Real first_column = previous_first_column_ + p_norm(series_a[index_i], series_b[0]);
+            int lower = SMAX(1, index_i - window_size);
+            int upper = windowUpper(index_i, window_size, a_length, b_length);
+            for (int index_j = lower; index_j != upper; ++index_j)
+            {
+                Real left = index_j == lower ? (index_j - 1 == 0 ? first_column : 0.0)
+                                             : current_row_[index_j - 1 - lower];
+                current_row_[index_j - lower] = p_norm(series_a[index_i], series_b[index_j]) +
+                                                SMIN(previousRowValue(index_j), left, previousRowValue(index_j - 1));
+            }
+            previous_row_.swap(current_row_);
+            previous_lower_ = lower;
+            previous_upper_ = upper;
+            previous_first_column_ = first_column;
+        }
+        return previousRowValue(b_length - 1);
+    };
+};
+} // namespace SPH
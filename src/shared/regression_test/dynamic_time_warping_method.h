@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "banded_dynamic_time_warping.h"
 #include "time_average_method.hpp"
 
 namespace SPH
@@ -61,8 +62,9 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
         return (variable_a - variable_b).norm();
     };
 
-    /** the local constrained method used for calculating the dtw distance between two lines. */
-    StdVec<Real> calculateDTWDistance(BiVector<VariableType> dataset_a_, BiVector<VariableType> dataset_b_);
+    /** the local constrained method used for calculating the dtw distance between two lines.
+     * The observations are evaluated in parallel with the banded dynamic time warping. */
+    StdVec<Real> calculateDTWDistance(const BiVector<VariableType> &dataset_a_, const BiVector<VariableType> &dataset_b_);
 
   public:
     template <typename... Args>
@@ -84,8 +86,8 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
     /** the interface for generating the priori converged result with DTW */
     void generateDataBase(Real threshold_value, std::string filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->flushCurrentResult();
+        this->readCurrentResult();
         this->transposeTheIndex();
         if (this->converged == "false")
         {
@@ -110,8 +112,8 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
     /** the interface for generating the priori converged result with DTW. */
     void testResult(std::string filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->flushCurrentResult();
+        this->readCurrentResult();
         this->transposeTheIndex();
         setupTheTest();
         if (filter == "true")
@@ -14,39 +14,35 @@ namespace SPH
 {
 //=================================================================================================//
 template <class ObserveMethodType>
-StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateDTWDistance(BiVector<VariableType> dataset_a_, BiVector<VariableType> dataset_b_)
+StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::
+    calculateDTWDistance(const BiVector<VariableType> &dataset_a_, const BiVector<VariableType> &dataset_b_)
 {
-    /* define the container to hold the dtw distance.*/
-    StdVec<Real> dtw_distance;
     for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
     {
-        int window_size_ = 5;
         int a_length = dataset_a_[observation_index].size();
         int b_length = dataset_b_[observation_index].size();
-
         if (b_length > 1.1 * a_length || b_length < 0.9 * a_length)
         {
             std::cout << "\n Error: please check the time step change, because the data length changed a lot !" << std::endl;
             std::cout << __FILE__ << ':' << __LINE__ << std::endl;
             exit(1);
         }
-
-        /** create a 2D vector with [a_length, b_length] to contain the local DTW distance value. */
-        BiVector<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
-        local_dtw_distance[0][0] = calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][0]);
-        for (int index_i = 1; index_i < a_length; ++index_i)
-            local_dtw_distance[index_i][0] = local_dtw_distance[index_i - 1][0] + calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][0]);
-        for (int index_j = 1; index_j < b_length; ++index_j)
-            local_dtw_distance[0][index_j] = local_dtw_distance[0][index_j - 1] + calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][index_j]);
-
-        /** add locality constraint */
-        window_size_ = SMAX(window_size_, ABS(a_length - b_length));
-        for (int index_i = 1; index_i != a_length; ++index_i)
-            for (int index_j = SMAX(1, index_i - window_size_); index_j != SMIN(b_length, index_i + window_size_); ++index_j)
-                local_dtw_distance[index_i][index_j] = calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][index_j]) +
-                                                       SMIN(local_dtw_distance[index_i - 1][index_j], local_dtw_distance[index_i][index_j - 1], local_dtw_distance[index_i - 1][index_j - 1]);
-        dtw_distance.push_back(local_dtw_distance[a_length - 1][b_length - 1]);
     }
+
+    /* define the container to hold the dtw distance.*/
+    StdVec<Real> dtw_distance(this->observation_, 0);
+    parallel_for(
+        IndexRange(0, this->observation_),
+        [&](const IndexRange &r)
+        {
+            BandedDynamicTimeWarping banded_dtw(5);
+            for (size_t observation_index = r.begin(); observation_index != r.end(); ++observation_index)
+                dtw_distance[observation_index] = banded_dtw.distance(
+                    dataset_a_[observation_index], dataset_b_[observation_index],
+                    [&](const VariableType &variable_a, const VariableType &variable_b)
+                    { return calculatePNorm(variable_a, variable_b); });
+        },
+        ap);
     return dtw_distance;
 };
 //=================================================================================================//
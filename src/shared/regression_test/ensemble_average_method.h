@@ -79,8 +79,8 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
     /* the interface for generating the priori converged result with M&V. */
     void generateDataBase(VariableType threshold_mean, VariableType threshold_variance, std::string filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->flushCurrentResult();
+        this->readCurrentResult();
         this->initializeThreshold(threshold_mean, threshold_variance);
         if (this->converged == "false")
         {
@@ -101,8 +101,8 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
     /** the interface for testing new result. */
     void testResult(std::string filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->flushCurrentResult();
+        this->readCurrentResult();
         setupAndCorrection();
         if (filter == "true")
             this->filterExtremeValues();
@@ -48,22 +48,20 @@ class RegressionTestBase : public ObserveMethodType
     using VariableType = decltype(ObserveMethodType::type_indicator_);
 
   protected:
-    std::string input_folder_path_;      /*< the folder path for the input folder. (folder) */
-    std::string in_output_filefullpath_; /*< the file path for current result from xml memory to xml file. */
-    std::string result_filefullpath_;    /*< the file path for all run results. (.xml)*/
-    std::string runtimes_filefullpath_;  /*< the file path for run times information. (.dat)*/
-    std::string converged;               /*< the tag for result converged, default false. */
+    std::string input_folder_path_;     /*< the folder path for the input folder. (folder) */
+    std::string result_filefullpath_;   /*< the file path for all run results. (.xml)*/
+    std::string runtimes_filefullpath_; /*< the file path for run times information. (.dat)*/
+    std::string converged;              /*< the tag for result converged, default false. */
 
     XmlMemoryIO xmlmemory_io_; /*< xml memory in_output operator, which has defined several
                                                                               methods to read and write data from and into xml memory,
                                                                                   including one by one, or all result in the same time. */
 
-    XmlEngine observe_xml_engine_;    /*< xml engine for current result io_environment. */
     XmlEngine result_xml_engine_in_;  /*< xml engine for input result. */
     XmlEngine result_xml_engine_out_; /*< xml engine for output result. */
                                       /*< the XmlEngine can operate the node name and elements in xml memory. */
 
-    StdVec<std::string> element_tag_;             /*< the container of the tag of current result. */
+    StdVec<std::string> element_tag_;             /*< the container of the tag of current result, one for each recorded snapshot. */
     BiVector<VariableType> current_result_;       /*< the container of current run result stored as snapshot * observation. */
     BiVector<VariableType> current_result_trans_; /*< the container of current run result with snapshot & observations transposed,
                                                                                                because this data structure is required in TA and DTW method. */
@@ -83,12 +81,10 @@ class RegressionTestBase : public ObserveMethodType
     template <typename... Args>
     explicit RegressionTestBase(Args &&...args) 
     : ObserveMethodType(std::forward<Args>(args)...), xmlmemory_io_(),
-                                                             observe_xml_engine_("xml_observe_reduce", this->quantity_name_),
                                                              result_xml_engine_in_("result_xml_engine_in", "result"),
                                                              result_xml_engine_out_("result_xml_engine_out", "result")
     {
         input_folder_path_ = this->io_environment_.input_folder_;
-        in_output_filefullpath_ = input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ + ".xml";
         result_filefullpath_ = input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ + "_result.xml";
         runtimes_filefullpath_ = input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ + "_runtimes.dat";
 
@@ -109,39 +105,36 @@ class RegressionTestBase : public ObserveMethodType
     };
     virtual ~RegressionTestBase();
 
-    void writeToXml(ObservedQuantityRecording<VariableType> *observe_method, size_t iteration = 0);
-    template <typename ReduceType>
-    void writeToXml(ReducedQuantityRecording<ReduceType> *reduce_method, size_t iteration = 0);
-    /* read current result from xml file into xml memory. */
-    void readFromXml(ObservedQuantityRecording<VariableType> *observe_method);
-    template <typename ReduceType>
-    void readFromXml(ReducedQuantityRecording<ReduceType> *reduce_method);
-
     void transposeTheIndex();                  /** transpose the current result (from snapshot*observation to observation*snapshot). */
     void readResultFromXml();                  /** read the result from the .xml file. (all result) */
     void writeResultToXml();                   /** write the result to the .xml file. (all result) */
     void readResultFromXml(int index_of_run_); /* read the result from the .xml file with the specified index. (DTW method, TA method) */
     void writeResultToXml(int index_of_run_);  /* write the result to the .xml file with the specified index. (DTW method, TA method) */
 
-    /** the interface to write observed quantity into xml memory. */
+    /** the interface to record the observed quantity, which is also the current result. */
     void writeToFile(size_t iteration = 0) override
     {
-        ObserveMethodType::writeToFile(iteration); /* used for visualization (.dat)*/
-        writeToXml(this, iteration);               /* used for regression test. (.xml) */
+        ObserveMethodType::writeToFile(iteration); /* recorded in the binary time series. */
+        element_tag_.push_back("Snapshot_" + std::to_string(iteration));
     };
 
-    /*The new run result is stored in the xml memory, and can't be copied and used directly
-     *so they should be output as .xml file and reloaded from .xml file into the memory.*/
-    /** the interface to write xml memory into Xml file. */
-    void writeXmlToXmlFile()
+    /** the interface to write the buffered records into the time series file. */
+    void flushCurrentResult()
     {
-        observe_xml_engine_.writeToXmlFile(in_output_filefullpath_); /* two method are same.*/
+        this->time_series_.flush();
     };
 
-    /** read current result from Xml file into Xml memory. */
-    void readXmlFromXmlFile()
+    /** read current result (snapshot * observation) directly from the time series file. */
+    void readCurrentResult()
     {
-        readFromXml(this);
+        StdVec<Real> snapshot_times;
+        this->time_series_.readAll(snapshot_times, current_result_);
+        if (current_result_.size() != element_tag_.size())
+        {
+            std::cout << "\n Error: the recorded snapshots of " << this->quantity_name_ << " do not match the current result!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
     };
 };
 }; // namespace SPH
\ No newline at end of file
@@ -103,8 +103,8 @@ class RegressionTestTimeAverage : public RegressionTestBase<ObserveMethodType>
     /* the interface for generating the priori converged result with time-averaged meanvalue and variance. */
     void generateDataBase(VariableType threshold_mean, VariableType threshold_variance, std::string filter = "false")
     {
-        this->writeXmlToXmlFile();  /* currently defined in in_output. */
-        this->readXmlFromXmlFile(); /* currently defined in in_output. */
+        this->flushCurrentResult();
+        this->readCurrentResult();
         initializeThreshold(threshold_mean, threshold_variance);
         if (this->converged == "false")
         {
@@ -126,8 +126,8 @@ class RegressionTestTimeAverage : public RegressionTestBase<ObserveMethodType>
     /** the interface for testing new result. */
     void testResult(std::string filter = "false")
     {
-        this->writeXmlToXmlFile();  /* currently defined in in_output. */
-        this->readXmlFromXmlFile(); /* currently defined in in_output. */
+        this->flushCurrentResult();
+        this->readCurrentResult();
         setupTheTest();
         if (filter == "true")
             filterExtremeValues();
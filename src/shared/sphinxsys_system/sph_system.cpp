@@ -71,6 +71,7 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
         desc.add_options()("regression", po::value<bool>(), "Regression test.");
         desc.add_options()("state_recording", po::value<bool>(), "State recording in output folder.");
         desc.add_options()("restart_step", po::value<int>(), "Run form a restart file.");
+        desc.add_options()("profiling", po::value<bool>(), "Profiling of dynamics, relations and outputs.");
 
         po::variables_map vm;
         po::store(po::parse_command_line(ac, av, desc), vm);
@@ -141,6 +142,13 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
             std::cout << "Restart inactivated, i.e. restart_step ("
                       << restart_step_ << ").\n";
         }
+
+        if (vm.count("profiling"))
+        {
+            setProfiling(vm["profiling"].as<bool>());
+            std::cout << "Profiling was set to "
+                      << vm["profiling"].as<bool>() << ".\n";
+        }
     }
     catch (std::exception &e)
     {
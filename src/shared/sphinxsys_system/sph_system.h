@@ -39,6 +39,7 @@ namespace po = boost::program_options;
 
 #include "base_data_package.h"
 #include "io_environment.h"
+#include "profiling_registry.h"
 #include "sph_data_containers.h"
 
 #include <filesystem>
@@ -90,6 +91,8 @@ class SPHSystem
     void setStateRecording(bool state_recording) { state_recording_ = state_recording; };
     void setRestartStep(size_t restart_step) { restart_step_ = restart_step; };
     size_t RestartStep() { return restart_step_; };
+    /** collect timing and counters of dynamics, relations and outputs, written at exit */
+    void setProfiling(bool profiling) { ProfilingRegistry::setEnabled(profiling); };
     /** Initialize cell linked list for the SPH system. */
     void initializeSystemCellLinkedLists();
     /** Initialize particle configuration for the SPH system. */
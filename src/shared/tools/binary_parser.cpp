@@ -0,0 +1,200 @@
+#include "binary_parser.h"
+
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=================================================================================================//
+namespace
+{
+constexpr char binary_file_magic[8] = {'S', 'P', 'H', 'B', 'I', 'N', '0', '1'};
+constexpr size_t binary_data_alignment = 64;
+} // namespace
+//=================================================================================================//
+void BinaryParser::resetVariablesToWrite(size_t total_particles)
+{
+    total_particles_to_write_ = total_particles;
+    variables_to_write_.clear();
+}
+//=================================================================================================//
+void BinaryParser::writeToBinaryFile(const std::string &filefullpath)
+{
+    size_t total_variables = variables_to_write_.size();
+    size_t offset = sizeof(BinaryFileHeader) + total_variables * sizeof(BinaryVariableEntry);
+    for (VariableToWrite &variable_to_write : variables_to_write_)
+    {
+        offset = (offset + binary_data_alignment - 1) / binary_data_alignment * binary_data_alignment;
+        variable_to_write.entry_.offset_ = offset;
+        offset += variable_to_write.entry_.bytes_per_particle_ * total_particles_to_write_;
+    }
+    size_t file_size = offset;
+
+    char *file_data = nullptr;
+#ifndef _WIN32
+    int file_descriptor = open(filefullpath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_descriptor == -1 || ftruncate(file_descriptor, file_size) != 0)
+    {
+        std::cout << "\n Error: the binary file " << filefullpath << " can not be created!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    void *mapped_file = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    if (mapped_file == MAP_FAILED)
+    {
+        std::cout << "\n Error: the binary file " << filefullpath << " can not be mapped!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    file_data = static_cast<char *>(mapped_file);
+#else
+    StdVec<char> write_buffer(file_size, 0);
+    file_data = write_buffer.data();
+#endif
+
+    BinaryFileHeader header;
+    std::memset(&header, 0, sizeof(BinaryFileHeader));
+    std::memcpy(header.magic_, binary_file_magic, sizeof(binary_file_magic));
+    header.total_particles_ = total_particles_to_write_;
+    header.total_variables_ = total_variables;
+    std::memcpy(file_data, &header, sizeof(BinaryFileHeader));
+    for (size_t k = 0; k != total_variables; ++k)
+    {
+        std::memcpy(file_data + sizeof(BinaryFileHeader) + k * sizeof(BinaryVariableEntry),
+                    &variables_to_write_[k].entry_, sizeof(BinaryVariableEntry));
+    }
+
+    for (VariableToWrite &variable_to_write : variables_to_write_)
+    {
+        copyBytesInParallel(file_data + variable_to_write.entry_.offset_, variable_to_write.data_,
+                            variable_to_write.entry_.bytes_per_particle_, total_particles_to_write_);
+    }
+
+#ifndef _WIN32
+    munmap(mapped_file, file_size);
+    close(file_descriptor);
+#else
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    out_file.write(write_buffer.data(), file_size);
+    out_file.close();
+#endif
+    variables_to_write_.clear();
+}
+//=================================================================================================//
+void BinaryParser::loadBinaryFile(const std::string &filefullpath)
+{
+    closeBinaryFile();
+    size_t file_size = fs::file_size(filefullpath);
+    if (file_size < sizeof(BinaryFileHeader))
+    {
+        std::cout << "\n Error: the binary file " << filefullpath << " is too short!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+#ifndef _WIN32
+    int file_descriptor = open(filefullpath.c_str(), O_RDONLY);
+    void *mapped_file = file_descriptor == -1
+                            ? MAP_FAILED
+                            : mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (file_descriptor != -1)
+        close(file_descriptor); // the mapping is kept after closing
+    if (mapped_file == MAP_FAILED)
+    {
+        std::cout << "\n Error: the binary file " << filefullpath << " can not be mapped!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    mapped_data_ = static_cast<const char *>(mapped_file);
+#else
+    file_buffer_.resize(file_size);
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    in_file.read(file_buffer_.data(), file_size);
+    mapped_data_ = file_buffer_.data();
+#endif
+    mapped_size_ = file_size;
+    loaded_file_path_ = filefullpath;
+
+    const BinaryFileHeader &header = LoadedHeader();
+    size_t table_end = sizeof(BinaryFileHeader) + header.total_variables_ * sizeof(BinaryVariableEntry);
+    if (std::memcmp(header.magic_, binary_file_magic, sizeof(binary_file_magic)) != 0 || table_end > mapped_size_)
+    {
+        std::cout << "\n Error: the file " << filefullpath << " is not a valid binary particle file!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    for (size_t k = 0; k != header.total_variables_; ++k)
+    {
+        const BinaryVariableEntry *entry = reinterpret_cast<const BinaryVariableEntry *>(
+                                               mapped_data_ + sizeof(BinaryFileHeader)) +
+                                           k;
+        if (entry->offset_ + entry->bytes_per_particle_ * header.total_particles_ > mapped_size_)
+        {
+            std::cout << "\n Error: the binary file " << filefullpath << " is truncated!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+}
+//=================================================================================================//
+void BinaryParser::closeBinaryFile()
+{
+    if (mapped_data_ != nullptr)
+    {
+#ifndef _WIN32
+        munmap(const_cast<char *>(mapped_data_), mapped_size_);
+#else
+        StdVec<char>().swap(file_buffer_);
+#endif
+        mapped_data_ = nullptr;
+        mapped_size_ = 0;
+    }
+}
+//=================================================================================================//
+size_t BinaryParser::TotalParticles()
+{
+    if (mapped_data_ == nullptr)
+    {
+        std::cout << "\n Error: no binary file is loaded!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return LoadedHeader().total_particles_;
+}
+//=================================================================================================//
+const BinaryVariableEntry *BinaryParser::findVariableEntry(const std::string &variable_name)
+{
+    const BinaryVariableEntry *entries =
+        reinterpret_cast<const BinaryVariableEntry *>(mapped_data_ + sizeof(BinaryFileHeader));
+    for (size_t k = 0; k != LoadedHeader().total_variables_; ++k)
+    {
+        if (std::strncmp(entries[k].name_, variable_name.c_str(), sizeof(BinaryVariableEntry::name_)) == 0)
+            return entries + k;
+    }
+    return nullptr;
+}
+//=================================================================================================//
+void BinaryParser::copyBytesInParallel(char *destination, const char *source,
+                                       size_t bytes_per_particle, size_t total_particles)
+{
+    parallel_for(
+        IndexRange(0, total_particles),
+        [&](const IndexRange &r)
+        {
+            std::memcpy(destination + r.begin() * bytes_per_particle,
+                        source + r.begin() * bytes_per_particle,
+                        (r.end() - r.begin()) * bytes_per_particle);
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
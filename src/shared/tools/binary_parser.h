@@ -0,0 +1,159 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    binary_parser.h
+ * @brief   Binary files of particle variables for restart and reload.
+ * @details The file has a header, a variable table and the raw contiguous arrays
+ *          of the variables. The file is written and read through memory mapping
+ *          so that the arrays are copied in parallel without conversion to text.
+ *          On platforms without mmap, the file is buffered in memory instead.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @struct BinaryFileHeader
+ * @brief The header at the beginning of a binary particle file.
+ */
+struct BinaryFileHeader
+{
+    char magic_[8];
+    uint64_t total_particles_;
+    uint64_t total_variables_;
+    uint64_t reserved_;
+};
+
+/**
+ * @struct BinaryVariableEntry
+ * @brief An entry of the variable table, which follows the file header.
+ */
+struct BinaryVariableEntry
+{
+    char name_[64];
+    uint64_t type_index_;
+    uint64_t bytes_per_particle_;
+    uint64_t offset_; /**< from the beginning of the file */
+    uint64_t reserved_;
+};
+
+/**
+ * @class BinaryParser
+ * @brief Write and read particle variables to and from a binary file.
+ */
+class BinaryParser
+{
+  public:
+    BinaryParser() : total_particles_to_write_(0), mapped_data_(nullptr), mapped_size_(0){};
+    ~BinaryParser() { closeBinaryFile(); };
+
+    /** the variables to be written are given after resetting */
+    void resetVariablesToWrite(size_t total_particles);
+    template <typename DataType>
+    void addVariableToWrite(const std::string &variable_name, StdLargeVec<DataType> &variable);
+    void writeToBinaryFile(const std::string &filefullpath);
+
+    void loadBinaryFile(const std::string &filefullpath);
+    void closeBinaryFile();
+    size_t TotalParticles();
+    template <typename DataType>
+    void readVariable(const std::string &variable_name, StdLargeVec<DataType> &variable, size_t total_particles);
+
+  protected:
+    struct VariableToWrite
+    {
+        BinaryVariableEntry entry_;
+        const char *data_;
+    };
+    size_t total_particles_to_write_;
+    StdVec<VariableToWrite> variables_to_write_;
+
+    std::string loaded_file_path_;
+    const char *mapped_data_;
+    size_t mapped_size_;
+    StdVec<char> file_buffer_; /**< used when mmap is not available */
+
+    const BinaryFileHeader &LoadedHeader() { return *reinterpret_cast<const BinaryFileHeader *>(mapped_data_); };
+    const BinaryVariableEntry *findVariableEntry(const std::string &variable_name);
+    void copyBytesInParallel(char *destination, const char *source, size_t bytes_per_particle, size_t total_particles);
+};
+//=================================================================================================//
+template <typename DataType>
+void BinaryParser::addVariableToWrite(const std::string &variable_name, StdLargeVec<DataType> &variable)
+{
+    if (variable_name.size() >= sizeof(BinaryVariableEntry::name_))
+    {
+        std::cout << "\n Error: the variable name '" << variable_name << "' is too long for binary file!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    VariableToWrite variable_to_write;
+    std::memset(&variable_to_write.entry_, 0, sizeof(BinaryVariableEntry));
+    std::memcpy(variable_to_write.entry_.name_, variable_name.c_str(), variable_name.size());
+    variable_to_write.entry_.type_index_ = DataTypeIndex<DataType>::value;
+    variable_to_write.entry_.bytes_per_particle_ = sizeof(DataType);
+    variable_to_write.data_ = reinterpret_cast<const char *>(variable.data());
+    variables_to_write_.push_back(variable_to_write);
+}
+//=================================================================================================//
+template <typename DataType>
+void BinaryParser::readVariable(const std::string &variable_name, StdLargeVec<DataType> &variable, size_t total_particles)
+{
+    const BinaryVariableEntry *entry = findVariableEntry(variable_name);
+    if (entry == nullptr)
+    {
+        std::cout << "\n Error: the variable '" << variable_name << "' is not found in "
+                  << loaded_file_path_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    if (entry->type_index_ != uint64_t(DataTypeIndex<DataType>::value) ||
+        entry->bytes_per_particle_ != sizeof(DataType))
+    {
+        std::cout << "\n Error: the data type of variable '" << variable_name << "' does not match in "
+                  << loaded_file_path_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    if (total_particles > TotalParticles() || variable.size() < total_particles)
+    {
+        std::cout << "\n Error: the number of particles does not match for variable '" << variable_name
+                  << "' in " << loaded_file_path_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    copyBytesInParallel(reinterpret_cast<char *>(variable.data()), mapped_data_ + entry->offset_,
+                        sizeof(DataType), total_particles);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -220,6 +220,45 @@ int main(int ac, char *av[])
     Real dt = 0.0;
     Real total_time = 0.0;
     Real relax_time = 1.0;
+    //----------------------------------------------------------------------
+    //	Configuration updates of the bodies. Stages without data dependence run concurrently,
+    //	i.e. the cell linked lists of the bodies and then the relations using them.
+    //	The particles and the cell linked list of a body are declared separately.
+    //----------------------------------------------------------------------
+    DynamicsTaskGraph update_configurations;
+    update_configurations.addStage([&](Real dt)
+                                   { water_block.updateCellLinkedListWithParticleSort(100); })
+        .writes(water_block)
+        .writes(water_block.getCellLinkedList());
+    update_configurations.addStage([&](Real dt)
+                                   { wall_boundary.updateCellLinkedList(); })
+        .writes(wall_boundary)
+        .writes(wall_boundary.getCellLinkedList());
+    update_configurations.addStage([&](Real dt)
+                                   { flap.updateCellLinkedList(); })
+        .writes(flap)
+        .writes(flap.getCellLinkedList());
+    update_configurations.addStage([&](Real dt)
+                                   { water_block_complex.updateConfiguration(); })
+        .reads(water_block)
+        .reads(water_block.getCellLinkedList())
+        .reads(wall_boundary)
+        .reads(wall_boundary.getCellLinkedList())
+        .reads(flap)
+        .reads(flap.getCellLinkedList())
+        .writes(water_block_complex);
+    update_configurations.addStage([&](Real dt)
+                                   { flap_contact.updateConfiguration(); })
+        .reads(flap)
+        .reads(water_block)
+        .reads(water_block.getCellLinkedList())
+        .writes(flap_contact);
+    update_configurations.addStage([&](Real dt)
+                                   { observer_contact_with_water.updateConfiguration(); })
+        .reads(observer)
+        .reads(water_block)
+        .reads(water_block.getCellLinkedList())
+        .writes(observer_contact_with_water);
     /** statistics for computing time. */
     TickCount t1 = TickCount::now();
     TimeInterval interval;
@@ -275,12 +314,7 @@ int main(int ac, char *av[])
             }
             number_of_iterations++;
             damping_wave.exec(Dt);
-            water_block.updateCellLinkedListWithParticleSort(100);
-            wall_boundary.updateCellLinkedList();
-            flap.updateCellLinkedList();
-            water_block_complex.updateConfiguration();
-            flap_contact.updateConfiguration();
-            observer_contact_with_water.updateConfiguration();
+            update_configurations.exec();
             if (total_time >= relax_time)
             {
                 write_total_force_on_flap.writeToFile(number_of_iterations);
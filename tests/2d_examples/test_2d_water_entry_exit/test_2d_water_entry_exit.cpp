@@ -222,6 +222,7 @@ int main(int ac, char *av[])
     FluidBody water_block(sph_system, makeShared<WettingFluidBody>("WaterBody"));
     water_block.defineParticlesAndMaterial<DiffusionFluidParticles, WettingFluidBodyMaterial>();
     water_block.generateParticles<ParticleGeneratorLattice>();
+    water_block.getCellLinkedList().setUseAdaptiveBounds();
 
     SolidBody wall_boundary(sph_system, makeShared<WettingWallBody>("WallBoundary"));
     wall_boundary.defineParticlesAndMaterial<DiffusionWallParticles, WettingWallBodyMaterial>();
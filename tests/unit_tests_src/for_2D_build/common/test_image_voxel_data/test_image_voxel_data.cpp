@@ -0,0 +1,115 @@
+/**
+ * @file 	test_image_voxel_data.cpp
+ * @brief 	Test of the voxel data decoded brick by brick from a compressed file.
+ * @details The voxels read concurrently through the brick cache, also while the whole volume
+ *			is decoded, are compared with the original ones. The least recently used brick is
+ *			checked to be evicted and an evicted brick to be released, though it was the last one
+ *			used by a thread.
+ * @author 	Yijin Mao and Xiangyu Hu
+ */
+#include "image_volume_data.h"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <thread>
+
+using namespace SPH;
+
+size_t total_voxels = 1 << 20;
+size_t voxels_in_brick = 1 << 12;
+std::string compressed_file = "./image_voxel_data_test.zraw";
+
+/** Exposes the bricks for testing. */
+class ImageVoxelDataForTest : public ImageVoxelData<float>
+{
+  public:
+    using ImageVoxelData<float>::Brick;
+    using ImageVoxelData<float>::findBrick;
+};
+
+void writeCompressedFile()
+{
+    StdVec<float> voxels(total_voxels);
+    for (size_t i = 0; i != total_voxels; ++i)
+        voxels[i] = float(i);
+    StdVec<char> compressed;
+    ASSERT_TRUE(IndexedZlibStream::compress(reinterpret_cast<const char *>(voxels.data()),
+                                            total_voxels * sizeof(float), compressed));
+    std::ofstream out_file(compressed_file.c_str(), std::ios::binary);
+    out_file.write(compressed.data(), compressed.size());
+}
+
+void loadCompressedFile(ImageVoxelData<float> &voxel_data)
+{
+    size_t decoded_voxels = 0;
+    voxel_data.loadCompressedFile(compressed_file, 0, total_voxels, voxels_in_brick,
+                                  [&](const float &voxel)
+                                  { EXPECT_EQ(voxel, float(decoded_voxels++)); });
+    EXPECT_EQ(decoded_voxels, total_voxels);
+}
+
+TEST(ImageVoxelData, ConcurrentReadAndDecode)
+{
+#ifndef ZLIB_AVAILABLE
+    GTEST_SKIP() << "compressed voxel data requires zlib";
+#endif
+    writeCompressedFile();
+    ImageVoxelData<float> voxel_data;
+    loadCompressedFile(voxel_data);
+    voxel_data.setMaxCachedBricks(4);
+
+    std::atomic<size_t> wrong_values(0);
+    auto read_voxels = [&](size_t begin, size_t stride)
+    {
+        for (size_t n = begin; n < total_voxels; n += stride)
+        {
+            size_t index = (n * 7919) % total_voxels;
+            if (voxel_data.getValue(index) != float(index))
+                wrong_values++;
+        }
+    };
+    StdVec<std::thread> threads;
+    for (size_t t = 0; t != 4; ++t)
+        threads.push_back(std::thread(read_voxels, t, 4 * 16));
+    // the whole volume is decoded while the bricks are read
+    const float *data = voxel_data.data();
+    for (std::thread &thread : threads)
+        thread.join();
+    EXPECT_EQ(wrong_values, size_t(0));
+
+    ASSERT_NE(data, nullptr);
+    for (size_t i = 0; i != total_voxels; ++i)
+    {
+        ASSERT_EQ(data[i], float(i));
+        ASSERT_EQ(voxel_data.getValue(i), float(i));
+    }
+}
+
+TEST(ImageVoxelData, LeastRecentlyUsedEviction)
+{
+#ifndef ZLIB_AVAILABLE
+    GTEST_SKIP() << "compressed voxel data requires zlib";
+#endif
+    writeCompressedFile();
+    ImageVoxelDataForTest voxel_data;
+    loadCompressedFile(voxel_data);
+    voxel_data.setMaxCachedBricks(2);
+
+    std::weak_ptr<const StdVec<float>> brick_0 = voxel_data.findBrick(0);
+    std::weak_ptr<const StdVec<float>> brick_1 = voxel_data.findBrick(1);
+    EXPECT_EQ((*brick_0.lock())[1], float(1));
+    EXPECT_EQ((*brick_1.lock())[1], float(voxels_in_brick + 1));
+    voxel_data.findBrick(0);
+    voxel_data.findBrick(2); // evicts brick 1, the least recently used one
+    EXPECT_FALSE(brick_0.expired());
+    EXPECT_TRUE(brick_1.expired());
+
+    // the last brick used by this thread is evicted by another thread
+    std::weak_ptr<const StdVec<float>> brick_3 = voxel_data.findBrick(3);
+    std::thread other_thread([&]()
+                             { voxel_data.findBrick(4);
+                               voxel_data.findBrick(5); });
+    other_thread.join();
+    EXPECT_TRUE(brick_3.expired());
+    EXPECT_EQ(voxel_data.getValue(3 * voxels_in_brick + 1), float(3 * voxels_in_brick + 1));
+}
@@ -0,0 +1,81 @@
+/**
+ * @file 	test_profiling_registry.cpp
+ * @brief 	Test of the opt-in profiling of particle dynamics and relations.
+ * @details Nothing is recorded when profiling is disabled. When it is enabled,
+ *			the calls, particles and neighbor pairs of a dynamics and a relation are checked.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+/** the JSON line of the record whose name contains the given string */
+std::string findRecord(const std::string &name)
+{
+    std::ostringstream json_stream;
+    ProfilingRegistry::getRegistry().writeJson(json_stream);
+    std::istringstream records(json_stream.str());
+    std::string line;
+    while (std::getline(records, line))
+    {
+        if (line.find(name) != std::string::npos)
+            return line;
+    }
+    return "";
+}
+
+size_t recordCounter(const std::string &record, const std::string &counter)
+{
+    size_t position = record.find("\"" + counter + "\": ");
+    return position == std::string::npos ? 0 : std::stoul(record.substr(position + counter.size() + 4));
+}
+
+TEST(ProfilingRegistry, RecordsOnlyWhenEnabled)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation water_block_inner(water_block);
+    SimpleDynamics<TimeStepInitialization> time_step_initialization(water_block);
+    size_t total_real_particles = water_block.getBaseParticles().total_real_particles_;
+
+    ProfilingRegistry::getRegistry().clear();
+    ProfilingRegistry::setEnabled(false);
+    water_block.updateCellLinkedList();
+    water_block_inner.updateConfiguration();
+    time_step_initialization.exec();
+    EXPECT_EQ(findRecord("WaterBody::"), "");
+
+    ProfilingRegistry::setEnabled(true);
+    for (size_t step = 0; step != 3; ++step)
+    {
+        water_block.updateCellLinkedList();
+        water_block_inner.updateConfiguration();
+        time_step_initialization.exec();
+    }
+    ProfilingRegistry::setEnabled(false);
+
+    std::string relation_record = findRecord("WaterBody::InnerRelation");
+    ASSERT_NE(relation_record, "");
+    EXPECT_EQ(recordCounter(relation_record, "calls"), 3);
+    size_t neighbor_pairs = 0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        neighbor_pairs += water_block_inner.inner_configuration_[i].current_size_;
+    EXPECT_EQ(recordCounter(relation_record, "neighbor_pairs"), 3 * neighbor_pairs);
+
+    std::string dynamics_record = findRecord("TimeStepInitialization");
+    ASSERT_NE(dynamics_record, "");
+    EXPECT_EQ(recordCounter(dynamics_record, "calls"), 3);
+    EXPECT_EQ(recordCounter(dynamics_record, "particles"), 3 * total_real_particles);
+    ProfilingRegistry::getRegistry().clear();
+}
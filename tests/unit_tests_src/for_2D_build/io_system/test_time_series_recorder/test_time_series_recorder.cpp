@@ -0,0 +1,112 @@
+/**
+ * @file 	test_time_series_recorder.cpp
+ * @brief 	Test of the time series recorder with buffered binary and text output.
+ * @details The rows are checked to be written to the text file with the flushed blocks
+ *			and to be read back from the binary file after the buffered blocks are flushed.
+ *			Both files are checked to be truncated by a new recorder,
+ *			and to be continued by a recorder after a restart.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "io_time_series.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+std::string binary_file = "./time_series_recorder_test.bin";
+std::string text_file = "./time_series_recorder_test.dat";
+size_t number_of_columns = 3;
+size_t rows_in_block = 4;
+
+size_t countTextRows(const std::string &filefullpath)
+{
+    std::ifstream in_file(filefullpath.c_str());
+    size_t rows = 0;
+    std::string line;
+    while (std::getline(in_file, line))
+        rows++;
+    return rows;
+}
+
+Vec2d recordedValue(size_t row, size_t column)
+{
+    return Vec2d(Real(row), Real(column) + 0.5);
+}
+
+void recordRows(TimeSeriesRecorder<Vec2d> &time_series, size_t number_of_rows)
+{
+    for (size_t row = 0; row != number_of_rows; ++row)
+    {
+        StdVec<Vec2d> values;
+        for (size_t column = 0; column != number_of_columns; ++column)
+            values.push_back(recordedValue(row, column));
+        time_series.recordRow(0.1 * Real(row), values);
+        // the header and the rows of the flushed blocks
+        size_t recorded_rows = row + 1;
+        EXPECT_EQ(countTextRows(text_file), 1 + recorded_rows - recorded_rows % rows_in_block);
+    }
+}
+
+void checkRecordedRows(TimeSeriesRecorder<Vec2d> &time_series, size_t number_of_rows)
+{
+    StdVec<Real> times;
+    BiVector<Vec2d> values;
+    time_series.readAll(times, values);
+    ASSERT_EQ(times.size(), number_of_rows);
+    EXPECT_EQ(countTextRows(text_file), number_of_rows + 1);
+    for (size_t row = 0; row != number_of_rows; ++row)
+    {
+        EXPECT_EQ(times[row], 0.1 * Real(row));
+        ASSERT_EQ(values[row].size(), number_of_columns);
+        for (size_t column = 0; column != number_of_columns; ++column)
+            EXPECT_EQ(values[row][column], recordedValue(row, column));
+    }
+}
+
+TEST(TimeSeriesRecorder, BufferedTextAndBinary)
+{
+    {
+        TimeSeriesRecorder<Vec2d> time_series(binary_file, number_of_columns, rows_in_block);
+        time_series.setTextExport(text_file);
+        std::ofstream(text_file.c_str(), std::ios::app) << "run_time   values\n";
+        recordRows(time_series, 10);
+        checkRecordedRows(time_series, 10);
+    }
+
+    // a new recorder starts both files again
+    TimeSeriesRecorder<Vec2d> time_series(binary_file, number_of_columns, rows_in_block);
+    time_series.setTextExport(text_file);
+    EXPECT_EQ(countTextRows(text_file), size_t(0));
+    std::ofstream(text_file.c_str(), std::ios::app) << "run_time   values\n";
+    recordRows(time_series, 3);
+    checkRecordedRows(time_series, 3);
+}
+
+TEST(TimeSeriesRecorder, ContinuedAfterRestart)
+{
+    {
+        TimeSeriesRecorder<Vec2d> time_series(binary_file, number_of_columns, rows_in_block);
+        time_series.setTextExport(text_file);
+        std::ofstream(text_file.c_str(), std::ios::app) << "run_time   values\n";
+        recordRows(time_series, 10);
+    }
+
+    // the rows recorded after the restart time are dropped from the binary file only
+    TimeSeriesRecorder<Vec2d> time_series(binary_file, number_of_columns, rows_in_block);
+    time_series.continueAfterRestart(0.45);
+    time_series.setTextExport(text_file);
+    EXPECT_EQ(countTextRows(text_file), size_t(11));
+    StdVec<Real> times;
+    BiVector<Vec2d> values;
+    time_series.readAll(times, values);
+    ASSERT_EQ(times.size(), size_t(5));
+    for (size_t row = 0; row != times.size(); ++row)
+        EXPECT_EQ(times[row], 0.1 * Real(row));
+
+    StdVec<Vec2d> restarted_values(number_of_columns, Vec2d::Zero());
+    time_series.recordRow(0.5, restarted_values);
+    time_series.readAll(times, values);
+    ASSERT_EQ(times.size(), size_t(6));
+    EXPECT_EQ(times.back(), 0.5);
+    EXPECT_EQ(values.back()[0], Vec2d::Zero());
+    EXPECT_EQ(countTextRows(text_file), size_t(12));
+}
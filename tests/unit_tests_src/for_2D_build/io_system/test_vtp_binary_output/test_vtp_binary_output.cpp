@@ -0,0 +1,255 @@
+/**
+ * @file 	test_vtp_binary_output.cpp
+ * @brief 	Test of the VTP output with raw binary appended data written by a background thread.
+ * @details The data arrays of a binary VTP file are decoded and compared with those of the ASCII VTP file,
+ *			the zlib compressed blocks are decoded and compared with the raw data arrays,
+ *			and the exceptions of background writing tasks are checked to be rethrown to the caller.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#ifdef ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+std::string readFile(const std::string &filefullpath)
+{
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>());
+}
+
+std::string attributeValue(const std::string &line, const std::string &attribute)
+{
+    size_t begin = line.find(attribute + "=\"");
+    if (begin == std::string::npos)
+        return "";
+    begin += attribute.size() + 2;
+    return line.substr(begin, line.find('"', begin) - begin);
+}
+
+/** the data arrays of an ASCII VTP file, with the values in the line after the header */
+std::map<std::string, StdVec<double>> readAsciiDataArrays(const std::string &content)
+{
+    std::map<std::string, StdVec<double>> data_arrays;
+    std::istringstream stream(content);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (line.find("<DataArray") == std::string::npos)
+            continue;
+        std::string values_line;
+        std::getline(stream, values_line);
+        std::istringstream values_stream(values_line);
+        StdVec<double> &values = data_arrays[attributeValue(line, "Name")];
+        double value;
+        while (values_stream >> value)
+            values.push_back(value);
+    }
+    return data_arrays;
+}
+
+/** the values of a raw data array of Float32 or Int32 type */
+StdVec<double> decodeValues(const char *raw_data, size_t number_of_bytes, bool is_int)
+{
+    StdVec<double> values;
+    for (size_t i = 0; i != number_of_bytes / 4; ++i)
+    {
+        if (is_int)
+        {
+            int32_t value;
+            std::memcpy(&value, raw_data + 4 * i, 4);
+            values.push_back(value);
+        }
+        else
+        {
+            float value;
+            std::memcpy(&value, raw_data + 4 * i, 4);
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+/** the headers of the data arrays and the position of the appended data */
+StdVec<std::string> readDataArrayHeaders(const std::string &content, size_t &appended_begin)
+{
+    StdVec<std::string> headers;
+    appended_begin = content.find('_', content.find("<AppendedData")) + 1;
+    std::istringstream stream(content.substr(0, appended_begin));
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (line.find("<DataArray") != std::string::npos)
+            headers.push_back(line);
+    }
+    return headers;
+}
+
+/** the data arrays of a VTP file with uncompressed raw appended data with UInt64 headers */
+std::map<std::string, StdVec<double>> readBinaryDataArrays(const std::string &content)
+{
+    std::map<std::string, StdVec<double>> data_arrays;
+    size_t appended_begin;
+    for (const std::string &line : readDataArrayHeaders(content, appended_begin))
+    {
+        size_t offset = appended_begin + std::stoul(attributeValue(line, "offset"));
+        uint64_t number_of_bytes;
+        std::memcpy(&number_of_bytes, content.data() + offset, sizeof(uint64_t));
+        data_arrays[attributeValue(line, "Name")] =
+            decodeValues(content.data() + offset + sizeof(uint64_t), number_of_bytes,
+                         attributeValue(line, "type") == "Int32");
+    }
+    return data_arrays;
+}
+
+#ifdef ZLIB_AVAILABLE
+/** the data arrays of a VTP file with zlib compressed appended data in single blocks */
+std::map<std::string, StdVec<double>> readCompressedDataArrays(const std::string &content)
+{
+    std::map<std::string, StdVec<double>> data_arrays;
+    size_t appended_begin;
+    StdVec<std::string> headers = readDataArrayHeaders(content, appended_begin);
+    size_t appended_end = content.find("\n </AppendedData>");
+    for (size_t k = 0; k != headers.size(); ++k)
+    {
+        size_t offset = appended_begin + std::stoul(attributeValue(headers[k], "offset"));
+        // number of blocks, size of a block, size of the last partial block and compressed size of the block
+        uint64_t block_header[4];
+        std::memcpy(block_header, content.data() + offset, sizeof(block_header));
+        EXPECT_EQ(block_header[0], uint64_t(1));
+        EXPECT_EQ(block_header[2], uint64_t(0));
+        // the compressed block fills the data up to the next array
+        size_t next_offset = k + 1 != headers.size()
+                                 ? appended_begin + std::stoul(attributeValue(headers[k + 1], "offset"))
+                                 : appended_end;
+        EXPECT_EQ(offset + sizeof(block_header) + block_header[3], next_offset);
+
+        StdVec<char> raw_data(block_header[1]);
+        uLongf raw_size = uLongf(raw_data.size());
+        EXPECT_EQ(uncompress(reinterpret_cast<Bytef *>(raw_data.data()), &raw_size,
+                             reinterpret_cast<const Bytef *>(content.data() + offset + sizeof(block_header)),
+                             uLong(block_header[3])),
+                  Z_OK);
+        EXPECT_EQ(raw_size, raw_data.size());
+        data_arrays[attributeValue(headers[k], "Name")] =
+            decodeValues(raw_data.data(), raw_data.size(), attributeValue(headers[k], "type") == "Int32");
+    }
+    return data_arrays;
+}
+#endif
+
+TEST(BodyStatesRecordingToVtpBinary, SameDataAsAsciiOutput)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+    particles.addVariableToWrite<Real>("Density");
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        particles.vel_[i] = Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        particles.rho_[i] = rand_uniform(0.9, 1.1);
+    }
+
+    BodyStatesRecordingToVtp ascii_recording(water_block);
+    ascii_recording.writeToFile(0);
+    water_block.setNewlyUpdated();
+    BodyStatesRecordingToVtpBinary binary_recording(water_block);
+    binary_recording.writeToFile(1);
+    binary_recording.waitForWriting();
+
+    std::string output_folder = sph_system.getIOEnvironment().output_folder_;
+    std::map<std::string, StdVec<double>> ascii_data_arrays =
+        readAsciiDataArrays(readFile(output_folder + "/WaterBody_0000000000.vtp"));
+    std::map<std::string, StdVec<double>> binary_data_arrays =
+        readBinaryDataArrays(readFile(output_folder + "/WaterBody_0000000001.vtp"));
+    ASSERT_EQ(ascii_data_arrays.size(), binary_data_arrays.size());
+    EXPECT_EQ(binary_data_arrays["Velocity"].size(), 3 * particles.total_real_particles_);
+    for (auto &ascii_data_array : ascii_data_arrays)
+    {
+        StdVec<double> &ascii_values = ascii_data_array.second;
+        StdVec<double> &binary_values = binary_data_arrays[ascii_data_array.first];
+        ASSERT_EQ(ascii_values.size(), binary_values.size()) << ascii_data_array.first;
+        for (size_t i = 0; i != ascii_values.size(); ++i)
+            EXPECT_NEAR(ascii_values[i], binary_values[i], 1.0e-5 * (1.0 + std::abs(ascii_values[i])));
+    }
+}
+
+#ifdef ZLIB_AVAILABLE
+TEST(BodyStatesRecordingToVtpBinary, CompressedSameAsRaw)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        particles.vel_[i] = Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+
+    BodyStatesRecordingToVtpBinary raw_recording(water_block);
+    raw_recording.writeToFile(2);
+    raw_recording.waitForWriting();
+    water_block.setNewlyUpdated();
+    BodyStatesRecordingToVtpBinary compressed_recording(water_block, true);
+    compressed_recording.writeToFile(3);
+    compressed_recording.waitForWriting();
+
+    std::string output_folder = sph_system.getIOEnvironment().output_folder_;
+    std::string compressed_content = readFile(output_folder + "/WaterBody_0000000003.vtp");
+    EXPECT_NE(compressed_content.find("compressor=\"vtkZLibDataCompressor\""), std::string::npos);
+    std::map<std::string, StdVec<double>> raw_data_arrays =
+        readBinaryDataArrays(readFile(output_folder + "/WaterBody_0000000002.vtp"));
+    std::map<std::string, StdVec<double>> compressed_data_arrays = readCompressedDataArrays(compressed_content);
+    EXPECT_EQ(compressed_data_arrays["Velocity"].size(), 3 * particles.total_real_particles_);
+    EXPECT_EQ(raw_data_arrays, compressed_data_arrays);
+}
+#endif
+
+TEST(BackgroundFileWriter, TaskExceptionRethrown)
+{
+    BackgroundFileWriter background_writer;
+    size_t finished_tasks = 0;
+    background_writer.addTask([&]()
+                              { throw std::runtime_error("failed writing"); });
+    EXPECT_THROW(background_writer.waitForAllTasks(), std::runtime_error);
+
+    // the writer continues with the later tasks
+    background_writer.addTask([&]()
+                              { finished_tasks++; });
+    EXPECT_NO_THROW(background_writer.waitForAllTasks());
+    EXPECT_EQ(finished_tasks, 1);
+
+    background_writer.addTask([&]()
+                              { throw std::runtime_error("failed writing"); });
+    while (true)
+    {
+        try
+        {
+            background_writer.addTask([&]()
+                                      { finished_tasks++; });
+        }
+        catch (const std::runtime_error &)
+        {
+            break;
+        }
+    }
+    background_writer.waitForAllTasks();
+    EXPECT_GE(finished_tasks, 1);
+}
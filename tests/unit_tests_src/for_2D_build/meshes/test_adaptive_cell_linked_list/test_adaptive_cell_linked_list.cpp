@@ -0,0 +1,118 @@
+/**
+ * @file 	test_adaptive_cell_linked_list.cpp
+ * @brief 	Test of the cell linked list growing its bounds when particles leave the mesh.
+ * @details The neighbors found after the particles left the small domain of a body with adaptive bounds
+ *			are compared with those of the same particles in a large domain,
+ *			the bounds are checked not to grow when cell lists are referred by body parts,
+ *			and adaptive bounds are checked to fail at setup for the multi-level cell linked list.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Domain length. */
+Real DH = 1.0;              /**< Domain height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.2, 0.1);
+Vec2d block_translation = Vec2d(0.5, 0.5);
+Vec2d block_displacement = Vec2d(0.8, -0.6);
+BoundingBox small_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+BoundingBox large_domain_bounds(Vec2d(-1.0, -1.0), Vec2d(2.0, 2.0));
+
+StdVec<size_t> sortedNeighbors(const Neighborhood &neighborhood)
+{
+    StdVec<size_t> neighbors;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        neighbors.push_back(neighborhood.j_[n]);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+void moveParticles(SPHBody &sph_body, const Vecd &displacement)
+{
+    BaseParticles &particles = sph_body.getBaseParticles();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        particles.pos_[i] += displacement;
+}
+
+TEST(CellLinkedList, AdaptiveBoundsSameNeighbors)
+{
+    SPHSystem small_system(small_domain_bounds, resolution_ref);
+    FluidBody adaptive_block(small_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                               Transform(block_translation), block_halfsize, "AdaptiveBlock"));
+    adaptive_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    adaptive_block.generateParticles<ParticleGeneratorLattice>();
+    adaptive_block.getCellLinkedList().setUseAdaptiveBounds();
+    InnerRelation adaptive_block_inner(adaptive_block);
+
+    SPHSystem large_system(large_domain_bounds, resolution_ref);
+    FluidBody reference_block(large_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                                Transform(block_translation), block_halfsize, "ReferenceBlock"));
+    reference_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    reference_block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation reference_block_inner(reference_block);
+
+    CellLinkedList &cell_linked_list = DynamicCast<CellLinkedList>(this, adaptive_block.getCellLinkedList());
+    Arrayi initial_cells = cell_linked_list.AllCells();
+    Vecd initial_lower_bound = cell_linked_list.MeshLowerBound();
+
+    moveParticles(adaptive_block, block_displacement);
+    moveParticles(reference_block, block_displacement);
+    adaptive_block.updateCellLinkedList();
+    reference_block.updateCellLinkedList();
+    adaptive_block_inner.updateConfiguration();
+    reference_block_inner.updateConfiguration();
+
+    // grown on the right and at the bottom only, with the grid alignment kept
+    Arrayi grown_cells = cell_linked_list.AllCells();
+    Vecd grown_lower_bound = cell_linked_list.MeshLowerBound();
+    EXPECT_GT(grown_cells[0], initial_cells[0]);
+    EXPECT_GT(grown_cells[1], initial_cells[1]);
+    EXPECT_EQ(grown_lower_bound[0], initial_lower_bound[0]);
+    EXPECT_LT(grown_lower_bound[1], initial_lower_bound[1]);
+    Real shifted_cells = (initial_lower_bound[1] - grown_lower_bound[1]) / cell_linked_list.GridSpacing();
+    EXPECT_NEAR(shifted_cells, std::round(shifted_cells), 1.0e-8);
+
+    BaseParticles &particles = adaptive_block.getBaseParticles();
+    ASSERT_EQ(particles.total_real_particles_, reference_block.getBaseParticles().total_real_particles_);
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Arrayi cell_index = cell_linked_list.CellIndexFromPosition(particles.pos_[i]);
+        EXPECT_TRUE((cell_index >= Arrayi::Zero()).all() && (cell_index < grown_cells).all());
+        EXPECT_EQ(sortedNeighbors(adaptive_block_inner.inner_configuration_[i]),
+                  sortedNeighbors(reference_block_inner.inner_configuration_[i]));
+    }
+}
+
+TEST(CellLinkedList, AdaptiveBoundsNotUsedWithBodyParts)
+{
+    SPHSystem small_system(small_domain_bounds, resolution_ref);
+    FluidBody adaptive_block(small_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                               Transform(block_translation), block_halfsize, "AdaptiveBlock"));
+    adaptive_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    adaptive_block.generateParticles<ParticleGeneratorLattice>();
+    adaptive_block.getCellLinkedList().setUseAdaptiveBounds();
+    BodyRegionByCell block_region(adaptive_block, makeShared<TransformShape<GeometricShapeBox>>(
+                                                      Transform(block_translation), block_halfsize, "Region"));
+
+    CellLinkedList &cell_linked_list = DynamicCast<CellLinkedList>(this, adaptive_block.getCellLinkedList());
+    Arrayi initial_cells = cell_linked_list.AllCells();
+    moveParticles(adaptive_block, block_displacement);
+    adaptive_block.updateCellLinkedList();
+
+    EXPECT_TRUE((cell_linked_list.AllCells() == initial_cells).all());
+}
+
+TEST(CellLinkedList, AdaptiveBoundsFailForMultilevel)
+{
+    SPHSystem small_system(small_domain_bounds, resolution_ref);
+    FluidBody refined_block(small_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                              Transform(block_translation), block_halfsize, "RefinedBlock"));
+    refined_block.defineAdaptation<ParticleSplitAndMerge>(1.3, 1.0, 1);
+    refined_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    refined_block.generateParticles<ParticleGeneratorLattice>();
+
+    EXPECT_EXIT(refined_block.getCellLinkedList().setUseAdaptiveBounds(), ::testing::ExitedWithCode(1), "");
+}
@@ -0,0 +1,63 @@
+/**
+ * @file 	test_my_memory_pool.cpp
+ * @brief 	Test of the memory pool with thread-local slabs.
+ * @details Nodes are allocated and freed concurrently, and the reused nodes
+ *			are checked to be constructed again with the given arguments.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+struct TestNode
+{
+    size_t value_;
+    StdVec<size_t> data_;
+    explicit TestNode(size_t value) : value_(value), data_(1, value){};
+};
+
+void checkDistinctNodes(StdVec<TestNode *> nodes)
+{
+    std::sort(nodes.begin(), nodes.end());
+    EXPECT_TRUE(std::adjacent_find(nodes.begin(), nodes.end()) == nodes.end());
+}
+
+TEST(MyMemoryPool, ConcurrentMallocAndFree)
+{
+    size_t number_of_nodes = 10000;
+    MyMemoryPool<TestNode> pool;
+    StdVec<TestNode *> nodes(number_of_nodes, nullptr);
+    parallel_for(IndexRange(0, number_of_nodes),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t i = r.begin(); i != r.end(); ++i)
+                         nodes[i] = pool.malloc(i);
+                 });
+    checkDistinctNodes(nodes);
+    EXPECT_EQ(size_t(pool.capacity()), number_of_nodes);
+    EXPECT_EQ(pool.available_node(), 0);
+
+    parallel_for(IndexRange(0, number_of_nodes),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t i = r.begin(); i != r.end(); ++i)
+                         pool.free(nodes[i]);
+                 });
+    EXPECT_EQ(size_t(pool.available_node()), number_of_nodes);
+
+    // the nodes freed by one thread may be reused by another thread or not at all
+    parallel_for(IndexRange(0, number_of_nodes),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t i = r.begin(); i != r.end(); ++i)
+                         nodes[i] = pool.malloc(i + number_of_nodes);
+                 });
+    checkDistinctNodes(nodes);
+    for (size_t i = 0; i != number_of_nodes; ++i)
+    {
+        EXPECT_EQ(nodes[i]->value_, i + number_of_nodes);
+        EXPECT_EQ(nodes[i]->data_, StdVec<size_t>(1, i + number_of_nodes));
+    }
+    EXPECT_EQ(size_t(pool.capacity() - pool.available_node()), number_of_nodes);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file 	test_package_data_accessor.cpp
+ * @brief 	Test of the access of the package data including those in the buffer.
+ * @details The data in the buffer of a package are accessed in its neighbor packages,
+ *			and all data of a singular package are accessed by its first data.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+using TestPackage = GridDataPackage<4, 1>;
+
+Real testValue(int package_id, int i, int j)
+{
+    return Real(100 * package_id + 10 * i + j);
+}
+
+class PackageDataAccessorTest : public ::testing::Test
+{
+  protected:
+    MeshVariable<Real> phi_{"Phi", 0};
+    MeshVariableAssemble all_mesh_variables_;
+
+    void SetUp() override
+    {
+        std::get<DataTypeIndex<Real>::value>(all_mesh_variables_).push_back(&phi_);
+    };
+};
+
+TEST_F(PackageDataAccessorTest, BufferDataInNeighborPackages)
+{
+    StdVec<UniquePtr<TestPackage>> packages;
+    for (int l = 0; l != 3; ++l)
+        for (int m = 0; m != 3; ++m)
+        {
+            packages.push_back(makeUnique<TestPackage>(Vec2d(Real(l), Real(m)), 0.25));
+            TestPackage &package = *packages.back();
+            package.allocateAllVariables(all_mesh_variables_);
+            auto &phi = package.getPackageData(phi_);
+            int package_id = 3 * l + m;
+            package.for_each_data([&](int i, int j)
+                                  { phi[i][j] = testValue(package_id, i, j); });
+        }
+    TestPackage &center_package = *packages[4];
+    for (int l = 0; l != 3; ++l)
+        for (int m = 0; m != 3; ++m)
+            center_package.assignNeighborPackage(Arrayi(l - 1, m - 1), packages[3 * l + m].get());
+
+    TestPackage::PackageDataAccessor<Real> phi_addrs = center_package.getPackageDataAccessor(phi_);
+    int pkg_size = TestPackage::pkg_size;
+    for (int i = 0; i != TestPackage::pkg_addrs_size; ++i)
+        for (int j = 0; j != TestPackage::pkg_addrs_size; ++j)
+        {
+            // the address index is shifted by the buffer width from the data index
+            int data_i = i - TestPackage::pkg_addrs_buffer;
+            int data_j = j - TestPackage::pkg_addrs_buffer;
+            int l = data_i < 0 ? 0 : (data_i < pkg_size ? 1 : 2);
+            int m = data_j < 0 ? 0 : (data_j < pkg_size ? 1 : 2);
+            EXPECT_EQ(phi_addrs(i, j), testValue(3 * l + m, (data_i + pkg_size) % pkg_size,
+                                                 (data_j + pkg_size) % pkg_size));
+        }
+}
+
+TEST_F(PackageDataAccessorTest, SingularPackage)
+{
+    TestPackage singular_package;
+    singular_package.allocateAllVariables(all_mesh_variables_);
+    auto &phi = singular_package.getPackageData(phi_);
+    singular_package.for_each_data([&](int i, int j)
+                                   { phi[i][j] = testValue(0, i, j); });
+    singular_package.assignSingularNeighborPackages();
+
+    TestPackage::PackageDataAccessor<Real> phi_addrs = singular_package.getPackageDataAccessor(phi_);
+    for (int i = 0; i != TestPackage::pkg_addrs_size; ++i)
+        for (int j = 0; j != TestPackage::pkg_addrs_size; ++j)
+        {
+            EXPECT_EQ(phi_addrs(i, j), phi[0][0]);
+        }
+}
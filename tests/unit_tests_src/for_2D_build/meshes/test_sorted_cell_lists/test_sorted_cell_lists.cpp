@@ -0,0 +1,72 @@
+/**
+ * @file 	test_sorted_cell_lists.cpp
+ * @brief 	Test of the cell lists built by sorting particles into contiguous arrays.
+ * @details The inner and contact neighbors found with the sorted cell lists are compared with
+ *			those found with the concurrent cell lists for randomly perturbed particles.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+StdVec<size_t> sortedNeighbors(const Neighborhood &neighborhood)
+{
+    StdVec<size_t> neighbors;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        neighbors.push_back(neighborhood.j_[n]);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+TEST(SortedCellLists, SameNeighborsAsConcurrentCellLists)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody concurrent_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "ConcurrentBlock"));
+    concurrent_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    concurrent_block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody sorted_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "SortedBlock"));
+    sorted_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    sorted_block.generateParticles<ParticleGeneratorLattice>();
+    sorted_block.getCellLinkedList().setUseSortedCellLists();
+
+    InnerRelation concurrent_inner(concurrent_block);
+    InnerRelation sorted_inner(sorted_block);
+    ContactRelation to_concurrent_contact(concurrent_block, {&concurrent_block});
+    ContactRelation to_sorted_contact(concurrent_block, {&sorted_block});
+
+    BaseParticles &concurrent_particles = concurrent_block.getBaseParticles();
+    BaseParticles &sorted_particles = sorted_block.getBaseParticles();
+    size_t total_real_particles = concurrent_particles.total_real_particles_;
+    ASSERT_EQ(total_real_particles, sorted_particles.total_real_particles_);
+    for (size_t step = 0; step != 3; ++step)
+    {
+        // the same random perturbation for both bodies, so that particles move across cells
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Vecd perturbation = 0.4 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+            concurrent_particles.pos_[i] += perturbation;
+            sorted_particles.pos_[i] += perturbation;
+        }
+        sph_system.initializeSystemCellLinkedLists();
+        sph_system.initializeSystemConfigurations();
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            EXPECT_EQ(sortedNeighbors(concurrent_inner.inner_configuration_[i]),
+                      sortedNeighbors(sorted_inner.inner_configuration_[i]));
+            EXPECT_EQ(sortedNeighbors(to_concurrent_contact.contact_configuration_[0][i]),
+                      sortedNeighbors(to_sorted_contact.contact_configuration_[0][i]));
+        }
+    }
+}
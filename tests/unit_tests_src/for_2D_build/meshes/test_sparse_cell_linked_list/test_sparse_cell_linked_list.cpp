@@ -0,0 +1,81 @@
+/**
+ * @file 	test_sparse_cell_linked_list.cpp
+ * @brief 	Test of the sparse cell linked list storing only occupied cells.
+ * @details The neighbors found with the sparse cell linked list are compared with
+ *			those found with the dense one in a large and mostly empty domain,
+ *			and the features requiring dense cell lists are checked to fail at setup.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 10.0;             /**< Domain length. */
+Real DH = 10.0;             /**< Domain height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5, 0.25);
+Vec2d block_translation = Vec2d(2.0, 3.0);
+BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+
+StdVec<size_t> sortedNeighbors(const Neighborhood &neighborhood)
+{
+    StdVec<size_t> neighbors;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        neighbors.push_back(neighborhood.j_[n]);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+TEST(SparseCellLinkedList, SameNeighborsAsDense)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody dense_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                          Transform(block_translation), block_halfsize, "DenseBlock"));
+    dense_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    dense_block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody sparse_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                           Transform(block_translation), block_halfsize, "SparseBlock"));
+    sparse_block.sph_adaptation_->setUseSparseCellLinkedList();
+    sparse_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    sparse_block.generateParticles<ParticleGeneratorLattice>();
+    EXPECT_FALSE(dense_block.getCellLinkedList().isSparse());
+    EXPECT_TRUE(sparse_block.getCellLinkedList().isSparse());
+
+    InnerRelation dense_block_inner(dense_block);
+    InnerRelation sparse_block_inner(sparse_block);
+    ContactRelation dense_sparse_contact(dense_block, {&sparse_block});
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    BaseParticles &dense_particles = dense_block.getBaseParticles();
+    BaseParticles &sparse_particles = sparse_block.getBaseParticles();
+    ASSERT_EQ(dense_particles.total_real_particles_, sparse_particles.total_real_particles_);
+    for (size_t i = 0; i != dense_particles.total_real_particles_; ++i)
+    {
+        // the two bodies are generated in the same way and not sorted
+        EXPECT_EQ(sortedNeighbors(dense_block_inner.inner_configuration_[i]),
+                  sortedNeighbors(sparse_block_inner.inner_configuration_[i]));
+        // the overlapping particle of the sparse body is a contact neighbor too
+        StdVec<size_t> expected_contact_neighbors = sortedNeighbors(dense_block_inner.inner_configuration_[i]);
+        expected_contact_neighbors.push_back(i);
+        std::sort(expected_contact_neighbors.begin(), expected_contact_neighbors.end());
+        EXPECT_EQ(sortedNeighbors(dense_sparse_contact.contact_configuration_[0][i]), expected_contact_neighbors);
+    }
+}
+
+TEST(SparseCellLinkedList, DenseFeaturesFailAtSetup)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody sparse_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                           Transform(block_translation), block_halfsize, "SparseBlock"));
+    sparse_block.sph_adaptation_->setUseSparseCellLinkedList();
+    sparse_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    sparse_block.generateParticles<ParticleGeneratorLattice>();
+    ASSERT_TRUE(sparse_block.getCellLinkedList().isSparse());
+
+    EXPECT_EXIT(sparse_block.setUseSplitCellLists(), ::testing::ExitedWithCode(1), "");
+    EXPECT_EXIT(BodyRegionByCell(sparse_block, makeShared<TransformShape<GeometricShapeBox>>(
+                                                   Transform(block_translation), block_halfsize, "Region")),
+                ::testing::ExitedWithCode(1), "");
+}
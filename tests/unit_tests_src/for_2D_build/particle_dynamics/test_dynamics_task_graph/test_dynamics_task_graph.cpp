@@ -0,0 +1,164 @@
+/**
+ * @file 	test_dynamics_task_graph.cpp
+ * @brief 	Test of the task graph running dynamics stages with respect to their data dependence.
+ * @details The dependencies derived from the read and write sets and the execution order of
+ *			conflicting stages are checked, independent stages are checked to run concurrently,
+ *			the updates of separate bodies are checked to be independent,
+ *			and adding or changing stages after the graph is built is checked to fail.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include "tbb/global_control.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace SPH;
+
+TEST(DynamicsTaskGraph, ConflictingStagesInOrder)
+{
+    Real x = 0.0, y = 0.0, z = 0.0;
+    StdVec<int> execution_order;
+    std::mutex order_mutex;
+    auto record = [&](int stage)
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        execution_order.push_back(stage);
+    };
+
+    DynamicsTaskGraph task_graph;
+    task_graph.addStage([&](Real dt)
+                        { x = dt; record(0); })
+        .writes(x);
+    task_graph.addStage([&](Real dt)
+                        { y = 2.0 * dt; record(1); })
+        .writes(y);
+    // reads the results of the previous stages
+    task_graph.addStage([&](Real dt)
+                        { z = x + y; record(2); })
+        .reads(x)
+        .reads(y)
+        .writes(z);
+    // must not overwrite x before it is read
+    task_graph.addStage([&](Real dt)
+                        { x = -1.0; record(3); })
+        .writes(x);
+
+    EXPECT_EQ(task_graph.NumberOfStages(), size_t(4));
+    // 0->2, 1->2, 0->3 and 2->3
+    EXPECT_EQ(task_graph.NumberOfDependencies(), size_t(4));
+
+    for (int n = 0; n != 10; ++n)
+    {
+        execution_order.clear();
+        task_graph.exec(0.5);
+        EXPECT_EQ(z, 1.5);
+        EXPECT_EQ(x, -1.0);
+        ASSERT_EQ(execution_order.size(), size_t(4));
+        EXPECT_EQ(execution_order[2], 2);
+        EXPECT_EQ(execution_order[3], 3);
+    }
+}
+
+TEST(DynamicsTaskGraph, IndependentStagesOverlap)
+{
+    // the stages run in an arena of two threads, which are allowed even on a single core
+    tbb::global_control two_threads(tbb::global_control::max_allowed_parallelism, 2);
+    tbb::task_arena arena(2);
+
+    // each stage waits for the other one to start, which only succeeds if they run concurrently
+    std::atomic<int> started_stages(0);
+    std::atomic<int> overlapped_stages(0);
+    auto wait_for_other_stage = [&](Real dt)
+    {
+        started_stages++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (started_stages.load() < 2 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        if (started_stages.load() == 2)
+            overlapped_stages++;
+    };
+
+    Real x = 0.0, y = 0.0;
+    DynamicsTaskGraph task_graph;
+    task_graph.addStage(wait_for_other_stage).writes(x);
+    task_graph.addStage(wait_for_other_stage).writes(y);
+    // the flow graph runs in the arena where it is built
+    arena.execute([&]()
+                  {
+                      EXPECT_EQ(task_graph.NumberOfDependencies(), size_t(0));
+                      task_graph.exec();
+                  });
+    EXPECT_EQ(started_stages.load(), 2);
+    EXPECT_EQ(overlapped_stages.load(), 2);
+}
+
+TEST(DynamicsTaskGraph, SeparateBodiesIndependent)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(2.0, 1.0));
+    SPHSystem sph_system(system_domain_bounds, 0.05);
+    FluidBody left_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                         Transform(Vec2d(0.5, 0.5)), Vec2d(0.5, 0.5), "LeftBlock"));
+    left_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    left_block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody right_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                          Transform(Vec2d(1.5, 0.5)), Vec2d(0.5, 0.5), "RightBlock"));
+    right_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    right_block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation left_block_inner(left_block);
+    ContactRelation left_block_contact(left_block, {&right_block});
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    size_t left_inner_neighbors = left_block_inner.inner_configuration_[0].current_size_;
+    size_t left_contact_neighbors = left_block_contact.contact_configuration_[0][0].current_size_;
+    ASSERT_GT(left_inner_neighbors, size_t(0));
+
+    DynamicsTaskGraph update_configurations;
+    update_configurations.addStage([&](Real dt)
+                                   { left_block.updateCellLinkedList(); })
+        .writes(left_block)
+        .writes(left_block.getCellLinkedList());
+    update_configurations.addStage([&](Real dt)
+                                   { right_block.updateCellLinkedList(); })
+        .writes(right_block)
+        .writes(right_block.getCellLinkedList());
+    update_configurations.addStage([&](Real dt)
+                                   { left_block_inner.updateConfiguration(); })
+        .reads(left_block)
+        .reads(left_block.getCellLinkedList())
+        .writes(left_block_inner);
+    update_configurations.addStage([&](Real dt)
+                                   { left_block_contact.updateConfiguration(); })
+        .reads(left_block)
+        .reads(right_block)
+        .reads(right_block.getCellLinkedList())
+        .writes(left_block_contact);
+
+    // 0->2, 0->3 and 1->3, the cell linked lists and the relations are not chained
+    EXPECT_EQ(update_configurations.NumberOfDependencies(), size_t(3));
+    update_configurations.exec();
+    EXPECT_EQ(left_block_inner.inner_configuration_[0].current_size_, left_inner_neighbors);
+    EXPECT_EQ(left_block_contact.contact_configuration_[0][0].current_size_, left_contact_neighbors);
+}
+
+TEST(DynamicsTaskGraph, NoChangeAfterBuilt)
+{
+    Real x = 0.0, y = 0.0;
+    DynamicsTaskGraph task_graph;
+    DynamicsStage &stage = task_graph.addStage([&](Real dt)
+                                               { x = dt; })
+                               .writes(x);
+    task_graph.exec(1.0);
+    EXPECT_EQ(x, 1.0);
+
+    EXPECT_EXIT(task_graph.addStage([&](Real dt)
+                                    { y = dt; }),
+                ::testing::ExitedWithCode(1), "");
+    EXPECT_EXIT(stage.reads(y), ::testing::ExitedWithCode(1), "");
+    EXPECT_EXIT(stage.writes(y), ::testing::ExitedWithCode(1), "");
+}
@@ -0,0 +1,109 @@
+/**
+ * @file 	test_elastic_material_template.cpp
+ * @brief 	Test of the stress relaxation with the material type as template parameter.
+ * @details Two identical plates with the same random velocities and deformation gradients are
+ *			relaxed by the first half of the stress relaxation, with the virtual material calls
+ *			for the first plate and with the template material type for the second.
+ *			The material of a plate is either exactly the template material type or derived from it.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real PL = 0.2;              /**< Plate length. */
+Real PH = 0.05;             /**< Plate height. */
+Real resolution_ref = PH / 10.0;
+Real rho0_s = 1100.0; /**< Reference density. */
+Real poisson = 0.45;  /**< Poisson ratio. */
+Real Youngs_modulus = 1.7e7;
+Vec2d plate_halfsize = Vec2d(0.5 * PL, 0.5 * PH);
+BoundingBox system_domain_bounds(Vec2d(-PL, -PL), Vec2d(2.0 * PL, 2.0 * PL));
+/** parameters of the muscle, derived from the neo-Hookean solid */
+Real a0[4] = {Real(496.0), Real(15196.0), Real(3283.0), Real(662.0)};
+Real b0[4] = {Real(7.209), Real(20.417), Real(11.176), Real(9.466)};
+Vec2d fiber_direction(1.0, 0.0);
+Vec2d sheet_direction(0.0, 1.0);
+Real bulk_modulus = 1.0e6;
+
+void perturbPlates(BaseParticles &virtual_particles, BaseParticles &template_particles)
+{
+    StdLargeVec<Matd> &virtual_F = *virtual_particles.getVariableByName<Matd>("DeformationGradient");
+    StdLargeVec<Matd> &template_F = *template_particles.getVariableByName<Matd>("DeformationGradient");
+    for (size_t i = 0; i != virtual_particles.total_real_particles_; ++i)
+    {
+        Vecd velocity = Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        virtual_particles.vel_[i] = velocity;
+        template_particles.vel_[i] = velocity;
+        Matd deformation = Matd::Identity();
+        deformation(0, 0) += 0.01 * rand_uniform(-1.0, 1.0);
+        deformation(0, 1) += 0.01 * rand_uniform(-1.0, 1.0);
+        virtual_F[i] = deformation;
+        template_F[i] = deformation;
+    }
+}
+
+template <class ElasticSolidType, class BodyMaterialType, typename... Args>
+void expectSameStressRelaxation(Args &&...args)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody virtual_plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                            Transform(plate_halfsize), plate_halfsize, "VirtualPlate"));
+    virtual_plate.defineParticlesAndMaterial<ElasticSolidParticles, BodyMaterialType>(args...);
+    virtual_plate.generateParticles<ParticleGeneratorLattice>();
+    SolidBody template_plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                             Transform(plate_halfsize), plate_halfsize, "TemplatePlate"));
+    template_plate.defineParticlesAndMaterial<ElasticSolidParticles, BodyMaterialType>(args...);
+    template_plate.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation virtual_plate_inner(virtual_plate);
+    InnerRelation template_plate_inner(template_plate);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> virtual_stress_relaxation(virtual_plate_inner);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2WithMaterial<ElasticSolidType>>
+        template_stress_relaxation(template_plate_inner);
+    BaseParticles &virtual_particles = virtual_plate.getBaseParticles();
+    BaseParticles &template_particles = template_plate.getBaseParticles();
+    ASSERT_EQ(virtual_particles.total_real_particles_, template_particles.total_real_particles_);
+    perturbPlates(virtual_particles, template_particles);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    Real dt = 1.0e-6;
+    virtual_stress_relaxation.exec(dt);
+    template_stress_relaxation.exec(dt);
+
+    Real maximum_force = 0.0;
+    for (size_t i = 0; i != virtual_particles.total_real_particles_; ++i)
+        maximum_force = SMAX(maximum_force, virtual_particles.force_[i].norm());
+    ASSERT_GT(maximum_force, 0.0);
+    for (size_t i = 0; i != virtual_particles.total_real_particles_; ++i)
+    {
+        EXPECT_LT((virtual_particles.force_[i] - template_particles.force_[i]).norm(), 1.0e-12 * maximum_force);
+        EXPECT_LT((virtual_particles.vel_[i] - template_particles.vel_[i]).norm(), 1.0e-12);
+    }
+}
+
+TEST(Integration1stHalfPK2WithMaterial, SameAsVirtualMaterial)
+{
+    expectSameStressRelaxation<SaintVenantKirchhoffSolid, SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    expectSameStressRelaxation<NeoHookeanSolid, NeoHookeanSolid>(rho0_s, Youngs_modulus, poisson);
+}
+
+TEST(Integration1stHalfPK2WithMaterial, DerivedMaterial)
+{
+    // the muscle overrides the constitutive law of the neo-Hookean solid
+    expectSameStressRelaxation<NeoHookeanSolid, Muscle>(rho0_s, bulk_modulus, fiber_direction, sheet_direction, a0, b0);
+}
+
+TEST(Integration1stHalfPK2WithMaterial, FailForUnrelatedMaterial)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(plate_halfsize), plate_halfsize, "Plate"));
+    plate.defineParticlesAndMaterial<ElasticSolidParticles, NeoHookeanSolid>(rho0_s, Youngs_modulus, poisson);
+    plate.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation plate_inner(plate);
+    EXPECT_EXIT(solid_dynamics::Integration1stHalfPK2WithMaterial<SaintVenantKirchhoffSolid> stress_relaxation(plate_inner),
+                ::testing::ExitedWithCode(1), "");
+}
@@ -0,0 +1,83 @@
+/**
+ * @file 	test_fused_dynamics.cpp
+ * @brief 	Test of the fused update and reduce of particle dynamics.
+ * @details Two identical water blocks are relaxed by the same pressure and density relaxation.
+ *			The density relaxation and the acoustic time step size are carried out one after another
+ *			for the first block and fused into one particle loop for the second.
+ *			The particle data and the time step sizes should be the same.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Real rho0_f = 1.0;          /**< Reference density of fluid. */
+Real c_f = 10.0;            /**< Reference sound speed. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+TEST(FusedDynamics, SameAsSeparateDynamics)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody separate_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "SeparateBlock"));
+    separate_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+    separate_block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody fused_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "FusedBlock"));
+    fused_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+    fused_block.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation separate_block_inner(separate_block);
+    InnerRelation fused_block_inner(fused_block);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> separate_pressure_relaxation(separate_block_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> separate_density_relaxation(separate_block_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> separate_acoustic_time_step(separate_block);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> fused_pressure_relaxation(fused_block_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> fused_density_relaxation(fused_block_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> fused_acoustic_time_step(fused_block);
+    FusedDynamics<Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann>,
+                  ReduceDynamics<fluid_dynamics::AcousticTimeStepSize>>
+        fused_density_relaxation_and_time_step(fused_density_relaxation, fused_acoustic_time_step);
+
+    BaseParticles &separate_particles = separate_block.getBaseParticles();
+    BaseParticles &fused_particles = fused_block.getBaseParticles();
+    size_t total_real_particles = separate_particles.total_real_particles_;
+    ASSERT_EQ(total_real_particles, fused_particles.total_real_particles_);
+    // the same random velocities for both blocks, so that the density and pressure change
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vecd velocity = 0.1 * c_f * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        separate_particles.vel_[i] = velocity;
+        fused_particles.vel_[i] = velocity;
+    }
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    Real separate_dt = separate_acoustic_time_step.exec();
+    Real fused_dt = fused_acoustic_time_step.exec();
+    for (size_t step = 0; step != 5; ++step)
+    {
+        ASSERT_EQ(separate_dt, fused_dt);
+        separate_pressure_relaxation.exec(separate_dt);
+        separate_density_relaxation.exec(separate_dt);
+        separate_dt = separate_acoustic_time_step.exec();
+
+        fused_pressure_relaxation.exec(fused_dt);
+        fused_dt = fused_density_relaxation_and_time_step.exec(fused_dt);
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            EXPECT_EQ(separate_particles.rho_[i], fused_particles.rho_[i]);
+            EXPECT_EQ(separate_particles.vel_[i], fused_particles.vel_[i]);
+            EXPECT_EQ(separate_particles.pos_[i], fused_particles.pos_[i]);
+        }
+    }
+    EXPECT_EQ(separate_dt, fused_dt);
+}
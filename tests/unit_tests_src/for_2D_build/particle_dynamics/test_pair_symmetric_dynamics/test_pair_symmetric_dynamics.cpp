@@ -0,0 +1,166 @@
+/**
+ * @file 	test_pair_symmetric_dynamics.cpp
+ * @brief 	Test of the pair-symmetric dynamics with half neighbor lists.
+ * @details Two identical water blocks with the same random velocities and densities are
+ *			computed by the viscous force and the pressure relaxation, with the full neighbor lists
+ *			for the first block and with the half neighbor lists for the second.
+ *			Similarly, two identical solid blocks with the same random velocities and deformation gradients
+ *			are computed by the stress relaxation.
+ *			The particle data should be the same up to round-off errors.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Real rho0_f = 1.0;          /**< Reference density of fluid. */
+Real c_f = 10.0;            /**< Reference sound speed. */
+Real mu_f = 0.1;            /**< Dynamics viscosity. */
+Real rho0_s = 1.0;          /**< Reference density of solid. */
+Real Youngs_modulus = 1.0e3;
+Real poisson = 0.45;
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+Real dataNorm(const Real &data) { return ABS(data); }
+Real dataNorm(const Vecd &data) { return data.norm(); }
+
+template <typename DataType>
+void expectSameData(const StdLargeVec<DataType> &full, const StdLargeVec<DataType> &half, size_t total_real_particles)
+{
+    Real maximum = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        maximum = SMAX(maximum, dataNorm(full[i]));
+    Real tolerance = 1.0e-10 * maximum + TinyReal;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_LT(dataNorm(DataType(full[i] - half[i])), tolerance);
+    }
+}
+
+class PairSymmetricDynamicsTest : public ::testing::Test
+{
+  protected:
+    SPHSystem sph_system_{BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref};
+    FluidBody full_block_{sph_system_, makeShared<TransformShape<GeometricShapeBox>>(
+                                           Transform(water_block_halfsize), water_block_halfsize, "FullBlock")};
+    FluidBody half_block_{sph_system_, makeShared<TransformShape<GeometricShapeBox>>(
+                                           Transform(water_block_halfsize), water_block_halfsize, "HalfBlock")};
+
+    void SetUp() override
+    {
+        full_block_.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f, mu_f);
+        full_block_.generateParticles<ParticleGeneratorLattice>();
+        half_block_.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f, mu_f);
+        half_block_.generateParticles<ParticleGeneratorLattice>();
+
+        BaseParticles &full_particles = full_block_.getBaseParticles();
+        BaseParticles &half_particles = half_block_.getBaseParticles();
+        ASSERT_EQ(full_particles.total_real_particles_, half_particles.total_real_particles_);
+        // the same random positions, velocities and densities for both blocks
+        for (size_t i = 0; i != full_particles.total_real_particles_; ++i)
+        {
+            Vecd displacement = 0.1 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+            full_particles.pos_[i] += displacement;
+            half_particles.pos_[i] += displacement;
+            Vecd velocity = 0.1 * c_f * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+            full_particles.vel_[i] = velocity;
+            half_particles.vel_[i] = velocity;
+            Real density = rho0_f * (1.0 + 0.01 * rand_uniform(-1.0, 1.0));
+            full_particles.rho_[i] = density;
+            half_particles.rho_[i] = density;
+        }
+    };
+};
+
+TEST_F(PairSymmetricDynamicsTest, ViscousAcceleration)
+{
+    InnerRelation full_block_inner(full_block_);
+    HalfInnerRelation half_block_inner(half_block_);
+    InteractionDynamics<fluid_dynamics::ViscousAccelerationInner> full_viscous_acceleration(full_block_inner);
+    InteractionPairSymmetric<fluid_dynamics::ViscousAcceleration<Inner<PairSymmetric>>>
+        half_viscous_acceleration(half_block_inner);
+    sph_system_.initializeSystemCellLinkedLists();
+    sph_system_.initializeSystemConfigurations();
+    EXPECT_EQ(2 * half_block_inner.TotalNeighborPairs(), full_block_inner.TotalNeighborPairs());
+
+    full_viscous_acceleration.exec();
+    half_viscous_acceleration.exec();
+
+    expectSameData(full_block_.getBaseParticles().force_prior_, half_block_.getBaseParticles().force_prior_,
+                   full_block_.getBaseParticles().total_real_particles_);
+}
+
+TEST_F(PairSymmetricDynamicsTest, PressureRelaxation)
+{
+    InnerRelation full_block_inner(full_block_);
+    HalfInnerRelation half_block_inner(half_block_);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> full_pressure_relaxation(full_block_inner);
+    Dynamics1LevelPairSymmetric<fluid_dynamics::Integration1stHalfPairSymmetricInnerRiemann>
+        half_pressure_relaxation(half_block_inner);
+    sph_system_.initializeSystemCellLinkedLists();
+    sph_system_.initializeSystemConfigurations();
+
+    Real dt = 0.1 * resolution_ref / c_f;
+    full_pressure_relaxation.exec(dt);
+    half_pressure_relaxation.exec(dt);
+
+    BaseParticles &full_particles = full_block_.getBaseParticles();
+    BaseParticles &half_particles = half_block_.getBaseParticles();
+    size_t total_real_particles = full_particles.total_real_particles_;
+    expectSameData(full_particles.force_, half_particles.force_, total_real_particles);
+    expectSameData(full_particles.vel_, half_particles.vel_, total_real_particles);
+    expectSameData(*full_particles.getVariableByName<Real>("DensityChangeRate"),
+                   *half_particles.getVariableByName<Real>("DensityChangeRate"), total_real_particles);
+}
+
+TEST(PairSymmetricSolidDynamics, StressRelaxation)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref);
+    SolidBody full_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                         Transform(water_block_halfsize), water_block_halfsize, "FullSolidBlock"));
+    full_block.defineParticlesAndMaterial<ElasticSolidParticles, SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    full_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody half_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                         Transform(water_block_halfsize), water_block_halfsize, "HalfSolidBlock"));
+    half_block.defineParticlesAndMaterial<ElasticSolidParticles, SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    half_block.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation full_block_inner(full_block);
+    HalfInnerRelation half_block_inner(half_block);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> full_stress_relaxation(full_block_inner);
+    Dynamics1LevelPairSymmetric<solid_dynamics::Integration1stHalfPairSymmetric<solid_dynamics::Integration1stHalfPK2>>
+        half_stress_relaxation(half_block_inner);
+
+    BaseParticles &full_particles = full_block.getBaseParticles();
+    BaseParticles &half_particles = half_block.getBaseParticles();
+    size_t total_real_particles = full_particles.total_real_particles_;
+    ASSERT_EQ(total_real_particles, half_particles.total_real_particles_);
+    // the same random velocities and deformation gradients for both blocks
+    StdLargeVec<Matd> &full_F = *full_particles.getVariableByName<Matd>("DeformationGradient");
+    StdLargeVec<Matd> &half_F = *half_particles.getVariableByName<Matd>("DeformationGradient");
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vecd velocity = Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        full_particles.vel_[i] = velocity;
+        half_particles.vel_[i] = velocity;
+        Matd deformation = Matd::Identity();
+        deformation(0, 0) += 0.01 * rand_uniform(-1.0, 1.0);
+        deformation(0, 1) += 0.01 * rand_uniform(-1.0, 1.0);
+        full_F[i] = deformation;
+        half_F[i] = deformation;
+    }
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    EXPECT_EQ(2 * half_block_inner.TotalNeighborPairs(), full_block_inner.TotalNeighborPairs());
+
+    Real dt = 1.0e-4 * resolution_ref;
+    full_stress_relaxation.exec(dt);
+    half_stress_relaxation.exec(dt);
+
+    expectSameData(full_particles.force_, half_particles.force_, total_real_particles);
+    expectSameData(full_particles.vel_, half_particles.vel_, total_real_particles);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file 	test_lattice_generation.cpp
+ * @brief 	Test of the parallel lattice particle generation with batched containment.
+ * @details The batched containment of the shapes is compared with the point-wise one,
+ *			and the particles generated in parallel tiles are compared with
+ *			those from a sequential sweep over the lattice.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;              /**< Domain length. */
+Real DH = 1.0;              /**< Domain height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d hole_center = Vec2d(0.7, 0.4);
+Real hole_radius = 0.25;
+BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+
+class BlockWithHole : public ComplexShape
+{
+  public:
+    explicit BlockWithHole(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(block_halfsize), block_halfsize);
+        subtract<GeometricShapeBall>(hole_center, hole_radius);
+    }
+};
+
+void checkBatchSameAsPointwise(Shape &shape)
+{
+    StdVec<Vecd> probe_points;
+    for (size_t n = 0; n != 1000; ++n)
+        probe_points.push_back(Vecd(rand_uniform(-0.2, DL + 0.2), rand_uniform(-0.2, DH + 0.2)));
+    StdVec<int> is_contained;
+    shape.checkContainBatch(probe_points, is_contained);
+    ASSERT_EQ(is_contained.size(), probe_points.size());
+    for (size_t n = 0; n != probe_points.size(); ++n)
+    {
+        EXPECT_EQ(bool(is_contained[n]), shape.checkContain(probe_points[n]));
+    }
+}
+
+TEST(ShapeContainment, BatchSameAsPointwise)
+{
+    GeometricShapeBox box(block_halfsize);
+    checkBatchSameAsPointwise(box);
+    GeometricShapeBall ball(hole_center, hole_radius);
+    checkBatchSameAsPointwise(ball);
+    TransformShape<GeometricShapeBox> translated_box(Transform(hole_center), block_halfsize * 0.5);
+    checkBatchSameAsPointwise(translated_box);
+    BlockWithHole block_with_hole("BlockWithHole");
+    checkBatchSameAsPointwise(block_with_hole);
+    TransformShape<BlockWithHole> translated_block_with_hole(Transform(Vec2d(0.1, 0.1)), "TranslatedBlockWithHole");
+    checkBatchSameAsPointwise(translated_block_with_hole);
+}
+
+TEST(ParticleGeneratorLattice, SameAsSequentialSweep)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(sph_system, makeShared<BlockWithHole>("WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+
+    StdVec<Vecd> expected_positions;
+    BaseMesh mesh(system_domain_bounds, resolution_ref, 0);
+    Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
+    for (int i = 0; i < number_of_lattices[0]; ++i)
+        for (int j = 0; j < number_of_lattices[1]; ++j)
+        {
+            Vecd particle_position = mesh.CellPositionFromIndex(Arrayi(i, j));
+            if (water_block.body_shape_->checkContain(particle_position))
+                expected_positions.push_back(particle_position);
+        }
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    ASSERT_EQ(particles.total_real_particles_, expected_positions.size());
+    for (size_t i = 0; i != expected_positions.size(); ++i)
+    {
+        EXPECT_EQ(particles.pos_[i], expected_positions[i]);
+        EXPECT_EQ(particles.unsorted_id_[i], i);
+        EXPECT_DOUBLE_EQ(particles.Vol_[i], resolution_ref * resolution_ref);
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * @file 	test_particle_reload.cpp
+ * @brief 	Test of reloading particles from XML or binary reload files.
+ * @details The reload files of both formats are written for different particle positions.
+ *			The XML file is reloaded by default and the binary file only when it is chosen explicitly.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+TEST(ParticleGeneratorReload, ExplicitBinaryFormat)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody water_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                          Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+
+    StdLargeVec<Vecd> binary_pos = particles.pos_;
+    ReloadParticleIO write_binary_reload(water_block);
+    write_binary_reload.setUseBinaryFormat();
+    write_binary_reload.writeToFile(0);
+    // the XML file is written for other positions
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        particles.pos_[i] += 0.1 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+    StdLargeVec<Vecd> xml_pos = particles.pos_;
+    ReloadParticleIO write_xml_reload(water_block);
+    write_xml_reload.writeToFile(0);
+
+    FluidBody xml_reloaded_block(sph_system, makeShared<DefaultShape>("XmlReloadedBlock"));
+    xml_reloaded_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    xml_reloaded_block.generateParticles<ParticleGeneratorReload>(water_block.getName());
+    FluidBody binary_reloaded_block(sph_system, makeShared<DefaultShape>("BinaryReloadedBlock"));
+    binary_reloaded_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    binary_reloaded_block.generateParticles<ParticleGeneratorReload>(water_block.getName(), true);
+
+    BaseParticles &xml_particles = xml_reloaded_block.getBaseParticles();
+    BaseParticles &binary_particles = binary_reloaded_block.getBaseParticles();
+    ASSERT_EQ(xml_particles.total_real_particles_, particles.total_real_particles_);
+    ASSERT_EQ(binary_particles.total_real_particles_, particles.total_real_particles_);
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        EXPECT_LT((xml_particles.pos_[i] - xml_pos[i]).norm(), 1.0e-6);
+        EXPECT_EQ(binary_particles.pos_[i], binary_pos[i]);
+    }
+}
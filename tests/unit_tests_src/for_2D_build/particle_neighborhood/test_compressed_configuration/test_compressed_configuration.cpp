@@ -0,0 +1,98 @@
+/**
+ * @file 	test_compressed_configuration.cpp
+ * @brief 	Test of the compressed sparse row storage of particle configurations.
+ * @details The configurations built in compressed storage are compared with
+ *			those saved in each neighborhood, for inner and contact relations.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;                      /**< Water block length. */
+Real DH = 1.0;                      /**< Water block height. */
+Real resolution_ref = 0.05;         /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;       /**< Thickness of the wall. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d outer_wall_halfsize = Vec2d(0.5 * DL + BW, 0.5 * DH + BW);
+
+class WallBoundary : public ComplexShape
+{
+  public:
+    explicit WallBoundary(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), outer_wall_halfsize);
+        subtract<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), water_block_halfsize);
+    }
+};
+
+void expectSameNeighborhood(const Neighborhood &expected, const Neighborhood &compressed)
+{
+    ASSERT_EQ(expected.current_size_, compressed.current_size_);
+    for (size_t n = 0; n != expected.current_size_; ++n)
+    {
+        size_t m = 0;
+        while (m != compressed.current_size_ && compressed.j_[m] != expected.j_[n])
+            ++m;
+        ASSERT_NE(m, compressed.current_size_);
+        EXPECT_EQ(expected.W_ij_[n], compressed.W_ij_[m]);
+        EXPECT_EQ(expected.dW_ijV_j_[n], compressed.dW_ijV_j_[m]);
+        EXPECT_EQ(expected.r_ij_[n], compressed.r_ij_[m]);
+        EXPECT_EQ(expected.e_ij_[n], compressed.e_ij_[m]);
+    }
+}
+
+TEST(CompressedConfiguration, InnerAndContactRelations)
+{
+    BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_boundary.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation water_block_inner(water_block);
+    InnerRelation water_block_inner_compressed(water_block);
+    water_block_inner_compressed.setUseCompressedConfiguration();
+    ContactRelation water_wall_contact(water_block, {&wall_boundary});
+    ContactRelation water_wall_contact_compressed(water_block, {&wall_boundary});
+    water_wall_contact_compressed.setUseCompressedConfiguration();
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    for (size_t step = 0; step != 2; ++step)
+    {
+        // the second step perturbs the particles so that the numbers of neighbors change
+        if (step == 1)
+        {
+            for (size_t i = 0; i != particles.total_real_particles_; ++i)
+                particles.pos_[i] += 0.3 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        }
+        sph_system.initializeSystemCellLinkedLists();
+        sph_system.initializeSystemConfigurations();
+
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            EXPECT_TRUE(water_block_inner_compressed.inner_configuration_[i].j_.isView());
+            expectSameNeighborhood(water_block_inner.inner_configuration_[i],
+                                   water_block_inner_compressed.inner_configuration_[i]);
+            expectSameNeighborhood(water_wall_contact.contact_configuration_[0][i],
+                                   water_wall_contact_compressed.contact_configuration_[0][i]);
+        }
+    }
+}
+
+TEST(CompressedConfiguration, BoundArrayCanNotGrow)
+{
+    StdLargeVec<Real> storage(4, 0.0);
+    NeighborDataArray<Real> data_array;
+    data_array.push_back(1.0);
+    EXPECT_FALSE(data_array.isView());
+    data_array.bindTo(storage.data());
+    EXPECT_TRUE(data_array.isView());
+    EXPECT_EXIT(data_array.push_back(1.0), ::testing::ExitedWithCode(1), "");
+}
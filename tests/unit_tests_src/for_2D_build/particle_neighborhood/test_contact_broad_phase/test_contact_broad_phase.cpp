@@ -0,0 +1,90 @@
+/**
+ * @file 	test_contact_broad_phase.cpp
+ * @brief 	Test of the bounding-box broad phase of contact relations.
+ * @details The contact neighbors found with the broad phase are compared with
+ *			those found without it, for a contact body next to the searching body
+ *			and one far away, which is moved next to the searching body later.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 4.0;              /**< Domain length. */
+Real DH = 4.0;              /**< Domain height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5, 0.5);
+
+StdVec<size_t> sortedNeighbors(const Neighborhood &neighborhood)
+{
+    StdVec<size_t> neighbors;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        neighbors.push_back(neighborhood.j_[n]);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+size_t totalNeighbors(const ParticleConfiguration &configuration, size_t total_real_particles)
+{
+    size_t total = 0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        total += configuration[i].current_size_;
+    return total;
+}
+
+TEST(ContactBroadPhase, SameNeighborsAsWithoutBroadPhase)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                          Transform(Vec2d(1.0, 1.0)), block_halfsize, "WaterBlock"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody near_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                         Transform(Vec2d(2.0, 1.0)), block_halfsize, "NearBlock"));
+    near_block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    near_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody far_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                        Transform(Vec2d(3.0, 3.0)), block_halfsize, "FarBlock"));
+    far_block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    far_block.generateParticles<ParticleGeneratorLattice>();
+
+    ContactRelation water_contact(water_block, {&near_block, &far_block});
+    ContactRelation water_contact_broad_phase(water_block, {&near_block, &far_block});
+    water_contact_broad_phase.setUseBroadPhase();
+
+    BaseParticles &water_particles = water_block.getBaseParticles();
+    BaseParticles &far_particles = far_block.getBaseParticles();
+    for (size_t step = 0; step != 2; ++step)
+    {
+        // the far block is moved to touch the top of the water block in the second step
+        if (step != 0)
+        {
+            for (size_t i = 0; i != far_particles.total_real_particles_; ++i)
+                far_particles.pos_[i] -= Vec2d(2.0, 1.0);
+        }
+        water_block.updateCellLinkedList();
+        near_block.updateCellLinkedList();
+        far_block.updateCellLinkedList();
+        water_contact.updateConfiguration();
+        water_contact_broad_phase.updateConfiguration();
+
+        size_t total_real_particles = water_particles.total_real_particles_;
+        EXPECT_GT(totalNeighbors(water_contact.contact_configuration_[0], total_real_particles), 0);
+        if (step == 0)
+        {
+            EXPECT_EQ(totalNeighbors(water_contact.contact_configuration_[1], total_real_particles), 0);
+        }
+        else
+        {
+            EXPECT_GT(totalNeighbors(water_contact.contact_configuration_[1], total_real_particles), 0);
+        }
+        for (size_t k = 0; k != 2; ++k)
+            for (size_t i = 0; i != total_real_particles; ++i)
+            {
+                EXPECT_EQ(sortedNeighbors(water_contact.contact_configuration_[k][i]),
+                          sortedNeighbors(water_contact_broad_phase.contact_configuration_[k][i]));
+            }
+    }
+}
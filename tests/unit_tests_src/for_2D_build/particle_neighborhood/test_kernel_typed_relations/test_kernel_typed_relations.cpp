@@ -0,0 +1,89 @@
+/**
+ * @file 	test_kernel_typed_relations.cpp
+ * @brief 	Test of the relations with the kernel type as template parameter.
+ * @details The neighbor data built by the typed inner and contact relations are compared with
+ *			those built with virtual kernel calls, and a kernel of another type is checked to be rejected.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;                      /**< Water block length. */
+Real DH = 1.0;                      /**< Water block height. */
+Real resolution_ref = 0.05;         /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;       /**< Thickness of the wall. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d outer_wall_halfsize = Vec2d(0.5 * DL + BW, 0.5 * DH + BW);
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+
+class WallBoundary : public ComplexShape
+{
+  public:
+    explicit WallBoundary(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), outer_wall_halfsize);
+        subtract<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), water_block_halfsize);
+    }
+};
+
+void expectSameNeighborhood(const Neighborhood &expected, const Neighborhood &typed)
+{
+    ASSERT_EQ(expected.current_size_, typed.current_size_);
+    for (size_t n = 0; n != expected.current_size_; ++n)
+    {
+        size_t m = 0;
+        while (m != typed.current_size_ && typed.j_[m] != expected.j_[n])
+            ++m;
+        ASSERT_NE(m, typed.current_size_);
+        EXPECT_NEAR(expected.W_ij_[n], typed.W_ij_[m], 1.0e-12 * expected.W_ij_[0]);
+        EXPECT_NEAR(expected.dW_ijV_j_[n], typed.dW_ijV_j_[m], 1.0e-12 * std::abs(expected.dW_ijV_j_[0]) + TinyReal);
+        EXPECT_NEAR(expected.r_ij_[n], typed.r_ij_[m], 1.0e-12);
+    }
+}
+
+TEST(KernelTypedRelations, SameNeighborsAsVirtualKernelCalls)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.sph_adaptation_->resetKernel<KernelCubicBSpline>();
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.sph_adaptation_->resetKernel<KernelCubicBSpline>();
+    wall_boundary.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_boundary.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation water_block_inner(water_block);
+    InnerRelationWithKernel<KernelCubicBSpline> water_block_inner_typed(water_block);
+    ContactRelation water_wall_contact(water_block, {&wall_boundary});
+    ContactRelationWithKernel<KernelCubicBSpline> water_wall_contact_typed(water_block, {&wall_boundary});
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        expectSameNeighborhood(water_block_inner.inner_configuration_[i],
+                               water_block_inner_typed.inner_configuration_[i]);
+        expectSameNeighborhood(water_wall_contact.contact_configuration_[0][i],
+                               water_wall_contact_typed.contact_configuration_[0][i]);
+    }
+}
+
+TEST(KernelTypedRelations, OtherKernelTypeRejected)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+
+    // the default kernel is KernelWendlandC2
+    EXPECT_EXIT(InnerRelationWithKernel<KernelCubicBSpline> water_block_inner_typed(water_block),
+                ::testing::ExitedWithCode(1), "");
+}
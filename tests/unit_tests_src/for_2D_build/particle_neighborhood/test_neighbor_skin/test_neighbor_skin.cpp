@@ -0,0 +1,151 @@
+/**
+ * @file 	test_neighbor_skin.cpp
+ * @brief 	Test of the Verlet lists for inner and contact relations.
+ * @details The neighbors built from the candidates within the cutoff radius extended by the skin
+ *			are compared with those searched in the cell linked list at every update,
+ *			while the particles move by small steps, so that the candidates are reused
+ *			for some updates and searched again for others.
+ *			In a periodic channel, the candidates found as periodic images are reused with their shifts.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;                      /**< Water block length. */
+Real DH = 1.0;                      /**< Water block height. */
+Real resolution_ref = 0.05;         /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;       /**< Thickness of the wall. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d outer_wall_halfsize = Vec2d(0.5 * DL + BW, 0.5 * DH + BW);
+
+class WallBoundary : public ComplexShape
+{
+  public:
+    explicit WallBoundary(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), outer_wall_halfsize);
+        subtract<TransformShape<GeometricShapeBox>>(Transform(water_block_halfsize), water_block_halfsize);
+    }
+};
+
+void expectSameNeighborhood(const Neighborhood &expected, const Neighborhood &verlet, Real tolerance = 0.0)
+{
+    ASSERT_EQ(expected.current_size_, verlet.current_size_);
+    for (size_t n = 0; n != expected.current_size_; ++n)
+    {
+        size_t m = 0;
+        while (m != verlet.current_size_ && verlet.j_[m] != expected.j_[n])
+            ++m;
+        ASSERT_NE(m, verlet.current_size_);
+        EXPECT_NEAR(expected.W_ij_[n], verlet.W_ij_[m], tolerance);
+        EXPECT_NEAR(expected.dW_ijV_j_[n], verlet.dW_ijV_j_[m], tolerance);
+        EXPECT_NEAR(expected.r_ij_[n], verlet.r_ij_[m], tolerance);
+    }
+}
+
+TEST(NeighborSkin, SameNeighborsAsCellLinkedListSearch)
+{
+    BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+    wall_boundary.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_boundary.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation water_block_inner(water_block);
+    InnerRelation water_block_inner_verlet(water_block);
+    water_block_inner_verlet.setUseNeighborSkin(0.5 * resolution_ref);
+    ContactRelation water_wall_contact(water_block, {&wall_boundary});
+    ContactRelation water_wall_contact_verlet(water_block, {&wall_boundary});
+    water_wall_contact_verlet.setUseNeighborSkin(0.5 * resolution_ref);
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    for (size_t step = 0; step != 10; ++step)
+    {
+        // steps of at most 0.05 resolution, the candidates are reused for several steps before searched again
+        if (step != 0)
+        {
+            for (size_t i = 0; i != particles.total_real_particles_; ++i)
+                particles.pos_[i] += 0.035 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        }
+        water_block.updateCellLinkedList();
+        wall_boundary.updateCellLinkedList();
+        water_block_inner.updateConfiguration();
+        water_block_inner_verlet.updateConfiguration();
+        water_wall_contact.updateConfiguration();
+        water_wall_contact_verlet.updateConfiguration();
+
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            expectSameNeighborhood(water_block_inner.inner_configuration_[i],
+                                   water_block_inner_verlet.inner_configuration_[i]);
+            expectSameNeighborhood(water_wall_contact.contact_configuration_[0][i],
+                                   water_wall_contact_verlet.contact_configuration_[0][i]);
+        }
+    }
+}
+
+TEST(NeighborSkin, SameNeighborsInPeriodicChannel)
+{
+    BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation water_block_inner(water_block);
+    InnerRelation water_block_inner_verlet(water_block);
+    water_block_inner_verlet.setUseNeighborSkin(0.5 * resolution_ref);
+    PeriodicConditionUsingCellLinkedList periodic_condition(water_block, water_block.getBodyShapeBounds(), xAxis);
+
+    BaseParticles &particles = water_block.getBaseParticles();
+    for (size_t step = 0; step != 10; ++step)
+    {
+        // the particles crossing the periodic bounds are moved to the other side and searched again
+        if (step != 0)
+        {
+            for (size_t i = 0; i != particles.total_real_particles_; ++i)
+                particles.pos_[i] += 0.035 * resolution_ref * Vec2d(rand_uniform(-1.0, 1.0), rand_uniform(-1.0, 1.0));
+        }
+        periodic_condition.bounding_.exec();
+        water_block.updateCellLinkedList();
+        periodic_condition.update_cell_linked_list_.exec();
+        water_block_inner.updateConfiguration();
+        water_block_inner_verlet.updateConfiguration();
+
+        // the positions of the reused images are shifted from the particles with round-off errors
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            expectSameNeighborhood(water_block_inner.inner_configuration_[i],
+                                   water_block_inner_verlet.inner_configuration_[i], 1.0e-6);
+        }
+    }
+}
+
+TEST(NeighborSkin, GhostParticlesNotSupported)
+{
+    BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation water_block_inner_verlet(water_block);
+    water_block_inner_verlet.setUseNeighborSkin(0.5 * resolution_ref);
+    PeriodicConditionUsingGhostParticles periodic_condition(water_block, water_block.getBodyShapeBounds(), xAxis);
+
+    periodic_condition.bounding_.exec();
+    water_block.updateCellLinkedList();
+    periodic_condition.ghost_creation_.exec();
+    EXPECT_EXIT(water_block_inner_verlet.updateConfiguration(), ::testing::ExitedWithCode(1), "");
+}
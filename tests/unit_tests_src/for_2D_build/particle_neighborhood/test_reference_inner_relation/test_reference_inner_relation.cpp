@@ -0,0 +1,88 @@
+/**
+ * @file 	test_reference_inner_relation.cpp
+ * @brief 	Test of the inner relation with frozen topology for total Lagrangian solids.
+ * @details The neighbors of the reference configuration are checked to be those of
+ *			the general inner relation sorted by index, to be kept after the particles move,
+ *			and the update after particle sorting is checked to fail.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real PL = 1.0;              /**< Plate length. */
+Real PH = 0.5;              /**< Plate height. */
+Real resolution_ref = 0.05; /**< Initial reference particle spacing. */
+Vec2d plate_halfsize = Vec2d(0.5 * PL, 0.5 * PH);
+BoundingBox system_domain_bounds(Vec2d(-PL, -PL), Vec2d(2.0 * PL, 2.0 * PL));
+
+TEST(ReferenceInnerRelation, SortedAndFrozenNeighbors)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(plate_halfsize), plate_halfsize, "Plate"));
+    plate.defineParticlesAndMaterial<SolidParticles, Solid>();
+    plate.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation plate_inner(plate);
+    ReferenceInnerRelation plate_reference_inner(plate);
+    plate.updateCellLinkedList();
+    plate_inner.updateConfiguration();
+    plate_reference_inner.updateConfiguration();
+
+    BaseParticles &particles = plate.getBaseParticles();
+    size_t total_real_particles = particles.total_real_particles_;
+    StdVec<StdVec<size_t>> reference_neighbors(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        const Neighborhood &expected = plate_inner.inner_configuration_[i];
+        const Neighborhood &reference = plate_reference_inner.inner_configuration_[i];
+        ASSERT_EQ(expected.current_size_, reference.current_size_);
+        for (size_t n = 0; n != reference.current_size_; ++n)
+        {
+            if (n != 0)
+            {
+                EXPECT_LT(reference.j_[n - 1], reference.j_[n]);
+            }
+            size_t m = 0;
+            while (m != expected.current_size_ && expected.j_[m] != reference.j_[n])
+                ++m;
+            ASSERT_NE(m, expected.current_size_);
+            EXPECT_EQ(expected.W_ij_[m], reference.W_ij_[n]);
+            EXPECT_EQ(expected.dW_ijV_j_[m], reference.dW_ijV_j_[n]);
+            EXPECT_EQ(expected.r_ij_[m], reference.r_ij_[n]);
+            EXPECT_EQ(expected.e_ij_[m], reference.e_ij_[n]);
+            reference_neighbors[i].push_back(reference.j_[n]);
+        }
+    }
+
+    // a large deformation changes the current neighbors but not the reference ones
+    for (size_t i = 0; i != total_real_particles; ++i)
+        particles.pos_[i] = 1.5 * particles.pos_[i];
+    plate.updateCellLinkedList();
+    plate_reference_inner.updateConfiguration();
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        const Neighborhood &reference = plate_reference_inner.inner_configuration_[i];
+        ASSERT_EQ(reference.current_size_, reference_neighbors[i].size());
+        for (size_t n = 0; n != reference.current_size_; ++n)
+        {
+            EXPECT_EQ(reference.j_[n], reference_neighbors[i][n]);
+        }
+    }
+}
+
+TEST(ReferenceInnerRelation, FailAfterParticleSorting)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(plate_halfsize), plate_halfsize, "Plate"));
+    plate.defineParticlesAndMaterial<SolidParticles, Solid>();
+    plate.generateParticles<ParticleGeneratorLattice>();
+    ReferenceInnerRelation plate_reference_inner(plate);
+    plate.updateCellLinkedList();
+    plate_reference_inner.updateConfiguration();
+
+    plate.updateCellLinkedListWithParticleSort(1);
+    EXPECT_EXIT(plate_reference_inner.updateConfiguration(), ::testing::ExitedWithCode(1), "");
+}
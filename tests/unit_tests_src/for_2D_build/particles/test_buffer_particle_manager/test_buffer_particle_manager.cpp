@@ -0,0 +1,118 @@
+/**
+ * @file 	test_buffer_particle_manager.cpp
+ * @brief 	Test of the batched switching between real, buffer and ghost particles.
+ * @details Buffer particles are reserved and deletion candidates are collected concurrently.
+ *			The real particles after the batched switching are compared with the expected ones
+ *			by their identities and positions, and the ghost particles with their real particles.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.02; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+size_t buffer_size = 200;
+size_t total_injections = 150;
+
+using IdentityAndPosition = std::pair<size_t, Vec2d>;
+
+StdVec<IdentityAndPosition> realParticles(BaseParticles &particles)
+{
+    StdVec<IdentityAndPosition> real_particles;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        real_particles.push_back(IdentityAndPosition(particles.unsorted_id_[i], particles.pos_[i]));
+    std::sort(real_particles.begin(), real_particles.end(),
+              [](const IdentityAndPosition &a, const IdentityAndPosition &b)
+              { return a.first < b.first; });
+    return real_particles;
+}
+
+TEST(BufferParticleManager, InjectionDeletionAndGhosts)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+    particles.addBufferParticles(buffer_size);
+    BufferParticleManager buffer_particle_manager(particles);
+    size_t total_real_particles = particles.total_real_particles_;
+
+    // injection: each injected particle is copied from a real particle and moved out of the block
+    StdVec<size_t> injected(total_injections);
+    parallel_for(IndexRange(0, total_injections),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t n = r.begin(); n != r.end(); ++n)
+                     {
+                         size_t buffer_index = buffer_particle_manager.reserveBufferParticle();
+                         particles.copyFromAnotherParticle(buffer_index, n);
+                         particles.pos_[buffer_index] = Vec2d(2.0 * DL, Real(n));
+                         injected[n] = buffer_index;
+                     }
+                 });
+    buffer_particle_manager.realizeReservedParticles();
+    ASSERT_EQ(particles.total_real_particles_, total_real_particles + total_injections);
+    std::sort(injected.begin(), injected.end());
+    for (size_t n = 0; n != total_injections; ++n)
+    {
+        EXPECT_EQ(injected[n], total_real_particles + n);
+    }
+
+    // deletion: every third particle, including some of the injected ones at the end
+    StdVec<IdentityAndPosition> expected_real_particles;
+    total_real_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        if (i % 3 != 0)
+            expected_real_particles.push_back(IdentityAndPosition(particles.unsorted_id_[i], particles.pos_[i]));
+    }
+    std::sort(expected_real_particles.begin(), expected_real_particles.end(),
+              [](const IdentityAndPosition &a, const IdentityAndPosition &b)
+              { return a.first < b.first; });
+    parallel_for(IndexRange(0, total_real_particles),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t i = r.begin(); i != r.end(); ++i)
+                         if (i % 3 == 0)
+                             buffer_particle_manager.addDeletionCandidate(i);
+                 });
+    buffer_particle_manager.switchCandidatesToBufferParticles();
+    ASSERT_EQ(particles.total_real_particles_, expected_real_particles.size());
+    EXPECT_EQ(realParticles(particles), expected_real_particles);
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        EXPECT_EQ(particles.sorted_id_[particles.unsorted_id_[i]], i);
+    }
+
+    // ghosts: copied from the real particles near the left boundary
+    ConcurrentIndexVector ghost_sources;
+    parallel_for(IndexRange(0, particles.total_real_particles_),
+                 [&](const IndexRange &r)
+                 {
+                     for (size_t i = r.begin(); i != r.end(); ++i)
+                         if (particles.pos_[i][0] < 2.0 * resolution_ref)
+                             ghost_sources.push_back(i);
+                 });
+    size_t total_ghosts = ghost_sources.size();
+    ASSERT_GT(total_ghosts, 0);
+    IndexVector ghost_particles;
+    buffer_particle_manager.insertGhostParticles(ghost_sources, ghost_particles);
+    ASSERT_EQ(ghost_particles.size(), total_ghosts);
+    EXPECT_EQ(particles.total_ghost_particles_, total_ghosts);
+    for (size_t n = 0; n != total_ghosts; ++n)
+    {
+        size_t ghost_index = ghost_particles[n];
+        EXPECT_EQ(ghost_index, particles.real_particles_bound_ + n);
+        size_t real_index = particles.sorted_id_[ghost_index];
+        EXPECT_LT(real_index, particles.total_real_particles_);
+        EXPECT_EQ(particles.pos_[ghost_index], particles.pos_[real_index]);
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file 	test_particle_sorting.cpp
+ * @brief 	Test of particle sorting by radix sort and permutation gather.
+ * @details The radix sort of the sequence is compared with std::stable_sort, and
+ *			the particle data sorted by permutation are checked with the particle identities.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Water block length. */
+Real DH = 0.5;              /**< Water block height. */
+Real resolution_ref = 0.01; /**< Initial reference particle spacing. */
+Vec2d water_block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+
+TEST(RadixSortParticleSequence, SameAsStableSort)
+{
+    // larger than a block of the radix sort
+    size_t size = 50000;
+    StdLargeVec<size_t> sequence(size);
+    for (size_t i = 0; i != size; ++i)
+        sequence[i] = size_t(rand_uniform(0.0, 1.0) * 1.0e9);
+    StdLargeVec<size_t> original = sequence;
+
+    StdLargeVec<size_t> expected_permutation(size);
+    for (size_t i = 0; i != size; ++i)
+        expected_permutation[i] = i;
+    std::stable_sort(expected_permutation.begin(), expected_permutation.end(),
+                     [&](size_t a, size_t b)
+                     { return original[a] < original[b]; });
+
+    RadixSortParticleSequence radix_sort;
+    StdLargeVec<size_t> permutation;
+    radix_sort.sort(sequence.data(), size, permutation);
+    ASSERT_EQ(permutation.size(), size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        EXPECT_EQ(permutation[i], expected_permutation[i]);
+        EXPECT_EQ(sequence[i], original[permutation[i]]);
+    }
+}
+
+TEST(ParticleSorting, SortingByPermutation)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody water_block(
+        sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                        Transform(water_block_halfsize), water_block_halfsize, "WaterBody"));
+    water_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<ParticleGeneratorLattice>();
+    water_block.setUseSortingByPermutation();
+    BaseParticles &particles = water_block.getBaseParticles();
+    // otherwise registered by the fluid integration dynamics
+    particles.registerSortableVariable<Vecd>("Position");
+    size_t total_real_particles = particles.total_real_particles_;
+
+    // shuffle the positions so that the particles are far from the sorted order
+    StdLargeVec<Vecd> &pos = particles.pos_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        size_t j = size_t(rand_uniform(0.0, 1.0) * Real(total_real_particles - 1));
+        std::swap(pos[i], pos[j]);
+    }
+    StdLargeVec<Vecd> shuffled_pos = pos;
+
+    water_block.updateCellLinkedListWithParticleSort(1);
+
+    StdLargeVec<size_t> &sequence = particles.sequence_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        if (i != 0)
+        {
+            EXPECT_LE(sequence[i - 1], sequence[i]);
+        }
+        EXPECT_EQ(pos[i], shuffled_pos[particles.unsorted_id_[i]]);
+        EXPECT_EQ(particles.sorted_id_[particles.unsorted_id_[i]], i);
+    }
+}
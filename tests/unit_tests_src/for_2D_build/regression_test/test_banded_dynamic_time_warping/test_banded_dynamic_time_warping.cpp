@@ -0,0 +1,73 @@
+/**
+ * @file 	test_banded_dynamic_time_warping.cpp
+ * @brief 	Test of the dynamic time warping distance computed with two rolling rows of the band.
+ * @details The banded distance is compared with that from the full distance matrix
+ *			for series of equal and different lengths.
+ * @author 	Bo Zhang, Chi Zhang and Xiangyu Hu
+ */
+#include "banded_dynamic_time_warping.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+int window_size = 5;
+
+/** The locality constrained distance with the full distance matrix. */
+template <typename VariableType, typename PNormFunction>
+Real fullMatrixDistance(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b,
+                        const PNormFunction &p_norm)
+{
+    int a_length = series_a.size();
+    int b_length = series_b.size();
+    BiVector<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
+    local_dtw_distance[0][0] = p_norm(series_a[0], series_b[0]);
+    for (int index_i = 1; index_i < a_length; ++index_i)
+        local_dtw_distance[index_i][0] = local_dtw_distance[index_i - 1][0] + p_norm(series_a[index_i], series_b[0]);
+    for (int index_j = 1; index_j < b_length; ++index_j)
+        local_dtw_distance[0][index_j] = local_dtw_distance[0][index_j - 1] + p_norm(series_a[0], series_b[index_j]);
+
+    int window = SMAX(window_size, ABS(a_length - b_length));
+    int upper_extent = SMAX(window, b_length - a_length + 1);
+    for (int index_i = 1; index_i != a_length; ++index_i)
+        for (int index_j = SMAX(1, index_i - window); index_j != SMIN(b_length, index_i + upper_extent); ++index_j)
+            local_dtw_distance[index_i][index_j] = p_norm(series_a[index_i], series_b[index_j]) +
+                                                   SMIN(local_dtw_distance[index_i - 1][index_j],
+                                                        local_dtw_distance[index_i][index_j - 1],
+                                                        local_dtw_distance[index_i - 1][index_j - 1]);
+    return local_dtw_distance[a_length - 1][b_length - 1];
+}
+
+TEST(BandedDynamicTimeWarping, SameAsFullMatrix)
+{
+    auto scalar_p_norm = [](const Real &a, const Real &b)
+    { return ABS(a - b); };
+    auto vector_p_norm = [](const Vec2d &a, const Vec2d &b)
+    { return (a - b).norm(); };
+
+    BandedDynamicTimeWarping banded_dtw(window_size);
+    StdVec<std::pair<size_t, size_t>> lengths = {{1, 1}, {3, 2}, {100, 100}, {100, 97}, {97, 100}, {100, 105}, {100, 110}, {130, 100}};
+    for (const auto &length : lengths)
+    {
+        StdVec<Real> scalar_a(length.first), scalar_b(length.second);
+        StdVec<Vec2d> vector_a(length.first), vector_b(length.second);
+        for (size_t i = 0; i != length.first; ++i)
+        {
+            scalar_a[i] = sin(0.1 * Real(i)) + rand_uniform(-0.1, 0.1);
+            vector_a[i] = Vec2d(scalar_a[i], rand_uniform(-1.0, 1.0));
+        }
+        for (size_t i = 0; i != length.second; ++i)
+        {
+            scalar_b[i] = sin(0.1 * Real(i) + 0.2) + rand_uniform(-0.1, 0.1);
+            vector_b[i] = Vec2d(scalar_b[i], rand_uniform(-1.0, 1.0));
+        }
+
+        // the same object is reused for series of different lengths
+        Real scalar_distance = banded_dtw.distance(scalar_a, scalar_b, scalar_p_norm);
+        Real vector_distance = banded_dtw.distance(vector_a, vector_b, vector_p_norm);
+        EXPECT_EQ(scalar_distance, fullMatrixDistance(scalar_a, scalar_b, scalar_p_norm));
+        EXPECT_EQ(vector_distance, fullMatrixDistance(vector_a, vector_b, vector_p_norm));
+        // the end cell is within the window, also for length differences beyond the window size
+        EXPECT_GT(scalar_distance, 0.0);
+        EXPECT_GT(vector_distance, 0.0);
+    }
+}
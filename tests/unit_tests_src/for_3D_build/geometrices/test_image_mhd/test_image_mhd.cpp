@@ -0,0 +1,72 @@
+#include "image_mhd.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real radius = 8.0;
+int resolution = 32;
+
+TEST(test_ImageMHD, test_trilinearStencil)
+{
+    ImageMHD<float, 3> image(radius, Array3i(resolution, resolution, resolution), Vec3d::Ones());
+
+    // the image is centered at the origin with unit spacing
+    Vec3d voxel_offset = -0.5 * Real(resolution) * Vec3d::Ones();
+    for (int n = 0; n != 100; ++n)
+    {
+        Vec3d voxel(int(rand_uniform(0.0, resolution - 1)), int(rand_uniform(0.0, resolution - 1)),
+                    int(rand_uniform(0.0, resolution - 1)));
+        Vec3d voxel_position = voxel + voxel_offset;
+        EXPECT_NEAR(image.findValueAtPoint(voxel_position), voxel_position.norm() - radius, 1.0e-5);
+
+        // linear along the axes within a cell
+        Vec3d start = voxel_position + Vec3d(0.0, rand_uniform(0.0, 1.0), rand_uniform(0.0, 1.0));
+        Vec3d end = start + Vec3d(0.8, 0.0, 0.0);
+        EXPECT_NEAR(image.findValueAtPoint(0.5 * (start + end)),
+                    0.5 * (image.findValueAtPoint(start) + image.findValueAtPoint(end)), 1.0e-5);
+    }
+
+    for (int n = 0; n != 100; ++n)
+    {
+        Vec3d probe_point(rand_uniform(-12.0, 12.0), rand_uniform(-12.0, 12.0), rand_uniform(-12.0, 12.0));
+        if (probe_point.norm() < 3.0 || probe_point.norm() > 12.0)
+            continue;
+        Vec3d direction = probe_point.normalized();
+        EXPECT_NEAR(image.findValueAtPoint(probe_point), probe_point.norm() - radius, 0.1);
+        EXPECT_GT(image.findNormalAtPoint(probe_point).dot(direction), 0.99);
+        EXPECT_LT((image.findClosestPoint(probe_point) - radius * direction).norm(), 0.1);
+    }
+
+    EXPECT_EQ(image.findValueAtPoint(Vec3d(100.0, 0.0, 0.0)), image.get_max_value());
+}
+
+TEST(test_ImageMHD, test_findBounds)
+{
+    StdVec<float> data(8);
+    for (size_t i = 0; i != data.size(); ++i)
+        data[i] = -1.0 - Real(i);
+    std::ofstream raw_file("negative.raw", std::ios::binary);
+    raw_file.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float));
+    raw_file.close();
+    std::ofstream mhd_file("negative.mhd");
+    mhd_file << "ObjectType = Image\n"
+             << "NDims = 3\n"
+             << "TransformMatrix = 1 0 0 0 1 0 0 0 1\n"
+             << "Offset = -10 -10 -10\n"
+             << "ElementSpacing = 1 1 1\n"
+             << "DimSize = 2 2 2\n"
+             << "ElementType = MET_FLOAT\n"
+             << "ElementDataFile = negative.raw\n";
+    mhd_file.close();
+
+    ImageMHD<float, 3> image("./negative.mhd");
+    EXPECT_EQ(image.get_min_value(), -8.0);
+    EXPECT_EQ(image.get_max_value(), -1.0);
+    EXPECT_EQ(BoundingBox(Vec3d(-10.0, -10.0, -10.0), Vec3d(-8.0, -8.0, -8.0)), image.findBounds());
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
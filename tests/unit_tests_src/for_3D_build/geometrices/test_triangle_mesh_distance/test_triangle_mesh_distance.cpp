@@ -0,0 +1,133 @@
+#include "triangle_mesh_distance.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** Exposes the ray crossing count for testing. */
+class TriangleMeshDistanceForTest : public TriangleMeshDistance
+{
+  public:
+    using TriangleMeshDistance::countRayCrossings;
+    using TriangleMeshDistance::TriangleMeshDistance;
+};
+
+/** Faces of the box [center - 1, center + 1] with outward normals, the top face is optional. */
+void generateBoxMesh(const Vec3d &center, bool with_top, StdVec<Vec3d> &vertices,
+                     StdVec<std::array<int, 3>> &faces)
+{
+    vertices.clear();
+    for (int n = 0; n != 8; ++n)
+        vertices.push_back(center + Vec3d(n & 4 ? 1.0 : -1.0, n & 2 ? 1.0 : -1.0, n & 1 ? 1.0 : -1.0));
+
+    faces.clear();
+    for (int axis = 0; axis != 3; ++axis)
+        for (int side = 0; side != 2; ++side)
+        {
+            if (axis == 2 && side == 1 && !with_top)
+                continue;
+            int axis_bit = 4 >> axis;
+            int first_bit = 4 >> ((axis + 1) % 3);
+            int second_bit = 4 >> ((axis + 2) % 3);
+            int fixed = side * axis_bit;
+            std::array<int, 4> quad = {fixed, fixed + first_bit, fixed + first_bit + second_bit, fixed + second_bit};
+            for (const std::array<int, 3> &face : {std::array<int, 3>{quad[0], quad[1], quad[2]},
+                                                   std::array<int, 3>{quad[0], quad[2], quad[3]}})
+            {
+                const Vec3d &a = vertices[face[0]];
+                Vec3d normal = (vertices[face[1]] - a).cross(vertices[face[2]] - a);
+                bool is_outward = normal.dot(a - center) > 0.0;
+                faces.push_back(is_outward ? face : std::array<int, 3>{face[0], face[2], face[1]});
+            }
+        }
+}
+
+Real boxSignedDistance(const Vec3d &probe_point)
+{
+    Vec3d outside = (probe_point.cwiseAbs() - Vec3d::Ones()).cwiseMax(Vec3d::Zero());
+    Real inside = SMIN(Real(0), (probe_point.cwiseAbs() - Vec3d::Ones()).maxCoeff());
+    return outside.norm() + inside;
+}
+
+TEST(test_TriangleMeshDistance, test_closedMesh)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<std::array<int, 3>> faces;
+    generateBoxMesh(Vec3d::Zero(), true, vertices, faces);
+    TriangleMeshDistance mesh_distance(vertices, faces);
+    EXPECT_TRUE(mesh_distance.isClosed());
+
+    StdVec<Vec3d> probe_points;
+    for (size_t n = 0; n != 1000; ++n)
+        probe_points.push_back(Vec3d(rand_uniform(-2.0, 2.0), rand_uniform(-2.0, 2.0), rand_uniform(-2.0, 2.0)));
+    StdVec<Real> signed_distances;
+    mesh_distance.findSignedDistances(probe_points, signed_distances);
+    for (size_t n = 0; n != probe_points.size(); ++n)
+    {
+        Real expected_distance = boxSignedDistance(probe_points[n]);
+        EXPECT_EQ(mesh_distance.checkContain(probe_points[n]), expected_distance < 0.0);
+        EXPECT_NEAR(mesh_distance.findSignedDistance(probe_points[n]), expected_distance, 1.0e-12);
+        EXPECT_NEAR(signed_distances[n], expected_distance, 1.0e-12);
+    }
+}
+
+TEST(test_TriangleMeshDistance, test_openMesh)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<std::array<int, 3>> faces;
+    generateBoxMesh(Vec3d::Zero(), false, vertices, faces);
+    TriangleMeshDistance mesh_distance(vertices, faces);
+    EXPECT_FALSE(mesh_distance.isClosed());
+
+    // away from the open top, the containment follows the face normals
+    for (size_t n = 0; n != 1000; ++n)
+    {
+        Vec3d probe_point(rand_uniform(-2.0, 2.0), rand_uniform(-2.0, 2.0), rand_uniform(-2.0, 0.5));
+        EXPECT_EQ(mesh_distance.checkContain(probe_point), boxSignedDistance(probe_point) < 0.0);
+    }
+}
+
+TEST(test_TriangleMeshDistance, test_openMeshProbeInFacePlane)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<std::array<int, 3>> faces;
+    generateBoxMesh(Vec3d::Zero(), false, vertices, faces);
+    TriangleMeshDistance mesh_distance(vertices, faces);
+
+    // the closest points are on the edges and vertices of the bottom, in the planes of the adjacent faces
+    StdVec<Vec3d> probe_points = {Vec3d(1.5, 0.0, -1.0), Vec3d(0.0, -1.5, -1.0), Vec3d(1.0, 0.0, -1.5),
+                                  Vec3d(1.5, 1.5, -1.0), Vec3d(-1.5, -1.0, -1.5), Vec3d(1.5, -1.0, 0.0)};
+    for (const Vec3d &probe_point : probe_points)
+    {
+        EXPECT_FALSE(mesh_distance.checkContain(probe_point));
+        EXPECT_GT(mesh_distance.findSignedDistance(probe_point), 0.0);
+    }
+}
+
+TEST(test_TriangleMeshDistance, test_getBounds)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<std::array<int, 3>> faces;
+    generateBoxMesh(Vec3d(-3.0, -3.0, -3.0), true, vertices, faces);
+    TriangleMeshDistance mesh_distance(vertices, faces);
+
+    EXPECT_EQ(BoundingBox(Vec3d(-4.0, -4.0, -4.0), Vec3d(-2.0, -2.0, -2.0)), mesh_distance.getBounds());
+}
+
+TEST(test_TriangleMeshDistance, test_rayHitSharedEdge)
+{
+    // a unit square split along its diagonal
+    StdVec<Vec3d> vertices = {Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(1.0, 1.0, 0.0), Vec3d(0.0, 1.0, 0.0)};
+    StdVec<std::array<int, 3>> faces = {{0, 1, 2}, {0, 2, 3}};
+    TriangleMeshDistanceForTest mesh_distance(vertices, faces);
+
+    // the rays hit the diagonal exactly
+    EXPECT_EQ(mesh_distance.countRayCrossings(Vec3d(0.5, 0.5, 1.0), Vec3d(0.0, 0.0, -1.0)), size_t(1));
+    EXPECT_EQ(mesh_distance.countRayCrossings(Vec3d(0.5, 0.5, -1.0), Vec3d(0.0, 0.0, 1.0)), size_t(1));
+    EXPECT_EQ(mesh_distance.countRayCrossings(Vec3d(0.25, 0.25, 1.0), Vec3d(0.0, 0.0, -1.0)), size_t(1));
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}